@@ -0,0 +1,341 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+#ifndef _ASTVIEW_H_
+#define _ASTVIEW_H_
+
+///////////////////////////////////////////////////////////////////////////
+//
+// file: astview.h
+//
+// The node-access layer that lets one pass run over either form of the
+// AST: the pointer AST of seal-*.h, through TreeView, and the flat copy
+// of flatast.h, through FlatView.  A view names a node with a Node (a
+// tree_node * or a FlatNode) and a node of known kind K with a handle:
+// a pointer to the node's class for TreeView, a FlatRef<K> for
+// FlatView.  AstVisitor (visitor.h) hands a pass the handle of each
+// node it visits.
+//
+// Both views have the same members, overloaded on the handle types, so
+// the code of a pass is the same for both:
+//
+//   kind(t), node(h), location(h), line_number(h)
+//   decl_count(p), decl(p, i)               a Program's declarations
+//   variable(d)                             a VariableDecl's Variable
+//   name(h), type(h), set_type(h, type)     of a node that has them
+//   prior(v), set_prior(v, p)               see semant.cc
+//   param_count(c), param(c, i), body(c)    a CallDecl's parts
+//   var_count(b), var_decl(b, i),           a StmtBlock's parts
+//   stmt_count(b), stmt(b, i)
+//   condition(s), then_branch(s), else_branch(s), body(s), init(s),
+//   loop(s), value(s)                       a statement's parts
+//   actual_count(c), actual(c, i),          a Call's parts
+//   callee(c), set_callee(c, d)
+//   expr(a), value(a), decl(e), set_decl(e, v), left(e), right(e),
+//   operand(e), constant(e), bool_value(e)  an expression's parts
+//   slot(v), set_slot(v, s),                the frame slots of -F
+//   frame_size(c), set_frame_size(c, n)
+//
+// The element accessors of lists (decl, param, var_decl, stmt, actual)
+// exit with list_node::nth's error when the index is out of range.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include "seal-decl.h"
+#include "seal-stmt.h"
+#include "seal-expr.h"
+#include "flatast.h"
+#include "symtab.h"
+
+//
+// NodeClass<K>::type is the class of the nodes of kind K.
+//
+template <NodeKind K> struct NodeClass;
+
+#define NODE_CLASS(K, C) template <> struct NodeClass<K> { typedef C type; };
+NODE_CLASS(NODE_PROGRAM,       Program_class)
+NODE_CLASS(NODE_VARIABLE_DECL, VariableDecl_class)
+NODE_CLASS(NODE_VARIABLE,      Variable_class)
+NODE_CLASS(NODE_CALL_DECL,     CallDecl_class)
+NODE_CLASS(NODE_STMT_BLOCK,    StmtBlock_class)
+NODE_CLASS(NODE_IF,            IfStmt_class)
+NODE_CLASS(NODE_WHILE,         WhileStmt_class)
+NODE_CLASS(NODE_FOR,           ForStmt_class)
+NODE_CLASS(NODE_RETURN,        ReturnStmt_class)
+NODE_CLASS(NODE_CONTINUE,      ContinueStmt_class)
+NODE_CLASS(NODE_BREAK,         BreakStmt_class)
+NODE_CLASS(NODE_CALL,          Call_class)
+NODE_CLASS(NODE_ACTUAL,        Actual_class)
+NODE_CLASS(NODE_ASSIGN,        Assign_class)
+NODE_CLASS(NODE_ADD,           Add_class)
+NODE_CLASS(NODE_MINUS,         Minus_class)
+NODE_CLASS(NODE_MULTI,         Multi_class)
+NODE_CLASS(NODE_DIVIDE,        Divide_class)
+NODE_CLASS(NODE_MOD,           Mod_class)
+NODE_CLASS(NODE_NEG,           Neg_class)
+NODE_CLASS(NODE_LT,            Lt_class)
+NODE_CLASS(NODE_LE,            Le_class)
+NODE_CLASS(NODE_EQU,           Equ_class)
+NODE_CLASS(NODE_NEQ,           Neq_class)
+NODE_CLASS(NODE_GE,            Ge_class)
+NODE_CLASS(NODE_GT,            Gt_class)
+NODE_CLASS(NODE_AND,           And_class)
+NODE_CLASS(NODE_OR,            Or_class)
+NODE_CLASS(NODE_XOR,           Xor_class)
+NODE_CLASS(NODE_NOT,           Not_class)
+NODE_CLASS(NODE_BITAND,        Bitand_class)
+NODE_CLASS(NODE_BITOR,         Bitor_class)
+NODE_CLASS(NODE_BITNOT,        Bitnot_class)
+NODE_CLASS(NODE_CONST_INT,     Const_int_class)
+NODE_CLASS(NODE_CONST_STRING,  Const_string_class)
+NODE_CLASS(NODE_CONST_FLOAT,   Const_float_class)
+NODE_CLASS(NODE_CONST_BOOL,    Const_bool_class)
+NODE_CLASS(NODE_OBJECT,        Object_class)
+NODE_CLASS(NODE_NO_EXPR,       No_expr_class)
+#undef NODE_CLASS
+
+// the handle of a node of kind K in a FlatAst; false, and the value
+// of FlatRef<K>(), for none
+template <NodeKind K>
+struct FlatRef {
+    FlatNode n = FLAT_NONE;
+    explicit operator bool() const { return n != FLAT_NONE; }
+};
+
+//
+// HandleClass<H>::type is the class of the nodes handle H stands for,
+// in either view.
+//
+template <class H> struct HandleClass;
+template <class C> struct HandleClass<C *> { typedef C type; };
+template <NodeKind K> struct HandleClass<FlatRef<K> > {
+    typedef typename NodeClass<K>::type type;
+};
+
+// a symbol table of FlatRefs holds them by value, with none for none
+template <NodeKind K>
+struct ScopeInfo<FlatRef<K> > {
+    typedef FlatRef<K> type;
+    static type none() { return type(); }
+};
+
+//////////////////////////////////////////////////////////////////////
+//
+// TreeView
+//
+//////////////////////////////////////////////////////////////////////
+
+class TreeView {
+public:
+    typedef tree_node *Node;
+    typedef ::Program Program;
+    typedef ::Variable Variable;
+    typedef ::VariableDecl VariableDecl;
+    typedef ::CallDecl CallDecl;
+    // name -> Variable, for binding
+    typedef SymbolTable<Symbol, Variable_class, HashedScopes> Environment;
+
+    static constexpr tree_node *none = NULL;
+
+    NodeKind kind(Node t) const { return t->get_kind(); }
+    template <NodeKind K>
+    typename NodeClass<K>::type *as(Node t) const
+	{ return (typename NodeClass<K>::type *) t; }
+    Node node(tree_node *t) const { return t; }
+    SourceLoc location(tree_node *t) const { return t->get_location(); }
+    int line_number(tree_node *t) const { return t->get_line_number(); }
+
+    int decl_count(Program p) const { return p->get_decls()->len(); }
+    Node decl(Program p, int i) const { return p->get_decls()->nth(i); }
+    Variable variable(VariableDecl d) const { return d->getVariable(); }
+
+    Symbol name(Variable v) const { return v->getName(); }
+    Symbol name(CallDecl c) const { return c->getName(); }
+    Symbol name(Call e) const { return e->getName(); }
+    Symbol name(Assign_class *e) const { return e->getLvalue(); }
+    Symbol name(Object e) const { return e->getName(); }
+    Symbol type(Variable v) const { return v->getType(); }
+    Symbol type(CallDecl c) const { return c->getType(); }
+    Symbol type(Expr e) const { return e->getType(); }
+    void set_type(Expr e, Symbol t) const { e->setType(t); }
+
+    Variable prior(Variable v) const { return v->getPrior(); }
+    void set_prior(Variable v, Variable p) const { v->setPrior(p); }
+
+    int param_count(CallDecl c) const { return c->getVariables()->len(); }
+    Variable param(CallDecl c, int i) const { return c->getVariables()->nth(i); }
+    Node body(CallDecl c) const { return c->getBody(); }
+
+    int var_count(StmtBlock b) const { return b->getVariableDecls()->len(); }
+    VariableDecl var_decl(StmtBlock b, int i) const
+	{ return b->getVariableDecls()->nth(i); }
+    int stmt_count(StmtBlock b) const { return b->getStmts()->len(); }
+    Node stmt(StmtBlock b, int i) const { return b->getStmts()->nth(i); }
+
+    Node condition(IfStmt s) const { return s->getCondition(); }
+    Node then_branch(IfStmt s) const { return s->getThen(); }
+    Node else_branch(IfStmt s) const { return s->getElse(); }
+    Node condition(WhileStmt s) const { return s->getCondition(); }
+    Node body(WhileStmt s) const { return s->getBody(); }
+    Node init(ForStmt s) const { return s->getInit(); }
+    Node condition(ForStmt s) const { return s->getCondition(); }
+    Node loop(ForStmt s) const { return s->getLoop(); }
+    Node body(ForStmt s) const { return s->getBody(); }
+    Node value(ReturnStmt s) const { return s->getValue(); }
+
+    int actual_count(Call e) const { return e->getActuals()->len(); }
+    Node actual(Call e, int i) const { return e->getActuals()->nth(i); }
+    CallDecl callee(Call e) const { return e->getCallee(); }
+    void set_callee(Call e, CallDecl c) const { e->setCallee(c); }
+
+    Node expr(Actual e) const { return e->getExpr(); }
+    Node value(Assign_class *e) const { return e->getValue(); }
+    Variable decl(Assign_class *e) const { return e->getDecl(); }
+    void set_decl(Assign_class *e, Variable v) const { e->setDecl(v); }
+    Variable decl(Object e) const { return e->getDecl(); }
+    void set_decl(Object e, Variable v) const { e->setDecl(v); }
+    template <class Op> Node left(Op *e) const { return e->getLeft(); }
+    template <class Op> Node right(Op *e) const { return e->getRight(); }
+    template <class Op> Node operand(Op *e) const { return e->getOperand(); }
+    template <class Const> Symbol constant(Const *e) const
+	{ return e->getSymbol(); }
+    Boolean bool_value(Const_bool_class *e) const { return e->getValue(); }
+
+    int slot(Variable v) const { return v->getSlot(); }
+    void set_slot(Variable v, int s) const { v->setSlot(s); }
+    int frame_size(CallDecl c) const { return c->getFrameSize(); }
+    void set_frame_size(CallDecl c, int n) const { c->setFrameSize(n); }
+};
+
+//////////////////////////////////////////////////////////////////////
+//
+// FlatView
+//
+//////////////////////////////////////////////////////////////////////
+
+class FlatView {
+    FlatAst *ast;
+
+    template <NodeKind K>
+    static FlatRef<K> ref(FlatNode n) { FlatRef<K> r = { n }; return r; }
+    // child i of n that is the element of a list
+    template <NodeKind K>
+    FlatNode nth(FlatRef<K> h, unsigned first, unsigned i) const
+    {
+	if (first + i >= ast->children(h.n))
+	    list_range_error();
+	return ast->child(h.n, first + i);
+    }
+public:
+    typedef FlatNode Node;
+    typedef FlatRef<NODE_PROGRAM> Program;
+    typedef FlatRef<NODE_VARIABLE> Variable;
+    typedef FlatRef<NODE_VARIABLE_DECL> VariableDecl;
+    typedef FlatRef<NODE_CALL_DECL> CallDecl;
+    typedef SymbolTable<Symbol, Variable, HashedScopes> Environment;
+
+    static constexpr FlatNode none = FLAT_NONE;
+
+    FlatView(FlatAst *a) : ast(a) { }
+
+    // node 0
+    Program program() const { return ref<NODE_PROGRAM>(0); }
+
+    NodeKind kind(Node n) const { return ast->kind(n); }
+    template <NodeKind K>
+    FlatRef<K> as(Node n) const { return ref<K>(n); }
+    template <NodeKind K> Node node(FlatRef<K> h) const { return h.n; }
+    template <NodeKind K> SourceLoc location(FlatRef<K> h) const
+	{ return ast->location(h.n); }
+    template <NodeKind K> int line_number(FlatRef<K> h) const
+	{ return ast->line_number(h.n); }
+
+    int decl_count(Program p) const { return ast->children(p.n); }
+    Node decl(Program p, int i) const { return nth(p, 0, i); }
+    Variable variable(VariableDecl d) const
+	{ return ref<NODE_VARIABLE>(ast->child(d.n, 0)); }
+
+    template <NodeKind K> Symbol name(FlatRef<K> h) const
+	{ return ast->name(h.n); }
+    template <NodeKind K> Symbol type(FlatRef<K> h) const
+	{ return ast->type(h.n); }
+    template <NodeKind K> void set_type(FlatRef<K> h, Symbol t) const
+	{ ast->set_type(h.n, t); }
+
+    Variable prior(Variable v) const
+	{ return ref<NODE_VARIABLE>(ast->bound(v.n)); }
+    void set_prior(Variable v, Variable p) const { ast->bind(v.n, p.n); }
+
+    // the parameters, then the body
+    int param_count(CallDecl c) const { return ast->children(c.n) - 1; }
+    Variable param(CallDecl c, int i) const
+    {
+	if ((unsigned) i >= ast->children(c.n) - 1)
+	    list_range_error();
+	return ref<NODE_VARIABLE>(ast->child(c.n, i));
+    }
+    Node body(CallDecl c) const
+	{ return ast->child(c.n, ast->children(c.n) - 1); }
+
+    // the VariableDecls, then the statements
+    int var_count(FlatRef<NODE_STMT_BLOCK> b) const { return ast->value(b.n); }
+    VariableDecl var_decl(FlatRef<NODE_STMT_BLOCK> b, int i) const
+    {
+	if ((unsigned) i >= ast->value(b.n))
+	    list_range_error();
+	return ref<NODE_VARIABLE_DECL>(ast->child(b.n, i));
+    }
+    int stmt_count(FlatRef<NODE_STMT_BLOCK> b) const
+	{ return ast->children(b.n) - ast->value(b.n); }
+    Node stmt(FlatRef<NODE_STMT_BLOCK> b, int i) const
+	{ return nth(b, ast->value(b.n), i); }
+
+    Node condition(FlatRef<NODE_IF> s) const { return ast->child(s.n, 0); }
+    Node then_branch(FlatRef<NODE_IF> s) const { return ast->child(s.n, 1); }
+    Node else_branch(FlatRef<NODE_IF> s) const { return ast->child(s.n, 2); }
+    Node condition(FlatRef<NODE_WHILE> s) const { return ast->child(s.n, 0); }
+    Node body(FlatRef<NODE_WHILE> s) const { return ast->child(s.n, 1); }
+    Node init(FlatRef<NODE_FOR> s) const { return ast->child(s.n, 0); }
+    Node condition(FlatRef<NODE_FOR> s) const { return ast->child(s.n, 1); }
+    Node loop(FlatRef<NODE_FOR> s) const { return ast->child(s.n, 2); }
+    Node body(FlatRef<NODE_FOR> s) const { return ast->child(s.n, 3); }
+    Node value(FlatRef<NODE_RETURN> s) const { return ast->child(s.n, 0); }
+
+    int actual_count(FlatRef<NODE_CALL> e) const { return ast->children(e.n); }
+    Node actual(FlatRef<NODE_CALL> e, int i) const { return nth(e, 0, i); }
+    CallDecl callee(FlatRef<NODE_CALL> e) const
+	{ return ref<NODE_CALL_DECL>(ast->bound(e.n)); }
+    void set_callee(FlatRef<NODE_CALL> e, CallDecl c) const
+	{ ast->bind(e.n, c.n); }
+
+    Node expr(FlatRef<NODE_ACTUAL> e) const { return ast->child(e.n, 0); }
+    Node value(FlatRef<NODE_ASSIGN> e) const { return ast->child(e.n, 0); }
+    template <NodeKind K> Variable decl(FlatRef<K> e) const
+	{ return ref<NODE_VARIABLE>(ast->bound(e.n)); }
+    template <NodeKind K> void set_decl(FlatRef<K> e, Variable v) const
+	{ ast->bind(e.n, v.n); }
+    template <NodeKind K> Node left(FlatRef<K> e) const
+	{ return ast->child(e.n, 0); }
+    template <NodeKind K> Node right(FlatRef<K> e) const
+	{ return ast->child(e.n, 1); }
+    template <NodeKind K> Node operand(FlatRef<K> e) const
+	{ return ast->child(e.n, 0); }
+    Symbol constant(FlatRef<NODE_CONST_INT> e) const
+	{ return inttable.lookup(ast->value(e.n)); }
+    Symbol constant(FlatRef<NODE_CONST_STRING> e) const
+	{ return stringtable.lookup(ast->value(e.n)); }
+    Symbol constant(FlatRef<NODE_CONST_FLOAT> e) const
+	{ return floatspellings.lookup(ast->value(e.n)); }
+    Boolean bool_value(FlatRef<NODE_CONST_BOOL> e) const
+	{ return ast->value(e.n); }
+
+    int slot(Variable v) const { return ast->slot(v.n); }
+    void set_slot(Variable v, int s) const { ast->set_slot(v.n, s); }
+    int frame_size(CallDecl c) const { return ast->slot(c.n); }
+    void set_frame_size(CallDecl c, int n) const { ast->set_slot(c.n, n); }
+};
+
+#endif
@@ -0,0 +1,23 @@
+#!/bin/bash
+#
+# buildrev.sh REV DIR [CFLAGS] : build semant from git revision REV, or
+# from the working tree if REV is "work", in DIR, by default at -O2.
+# Prints the path of the binary, for SEMANT= or phases.py.
+#
+cd "$(dirname "$0")/.."
+rev=$1
+dir=$2
+cflags=${3:--O2 -pthread -Wall -Wno-unused -Wno-write-strings -Wno-deprecated -I. -DDEBUG}
+rm -rf $dir
+mkdir -p $dir
+if [ "$rev" = work ]; then
+    git ls-files -co --exclude-standard | grep -v -e '\.o$' -e '\.gch$' -e '^semant$' |
+        tar -cf - -T - | tar -xf - -C $dir
+else
+    git archive $rev | tar -xf - -C $dir
+fi
+make -C $dir -s CFLAGS="$cflags" semant > /dev/null 2>&1 || {
+    echo "buildrev.sh: $rev does not build" >&2
+    exit 1
+}
+echo $(cd $dir && pwd)/semant
@@ -0,0 +1,65 @@
+#!/usr/bin/env python3
+#
+# check_bench.py [-n RUNS] MB REV... : time the checker of semant at
+# each git revision REV (or "work"), built by buildrev.sh, on a program
+# of about MB megabytes from gen_expr.py.  It does not use the phase
+# timers of -X, so that it can time revisions older than them too:
+# each revision runs the program twice, once ending in a syntax error,
+# so that only the parse runs, and once ending in a function that uses
+# an undeclared name, so that the whole program is checked but not
+# dumped.  The difference of the two min (and median) wall times is the
+# check time, in ms.  The runs are interleaved so that they see the
+# same machine.
+#
+import os
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+
+args = sys.argv[1:]
+runs = 5
+if args[:1] == ['-n']:
+    runs, args = int(args[1]), args[2:]
+mb, revs = int(args[0]), args[1:]
+bench = os.path.dirname(os.path.abspath(__file__))
+tmp = tempfile.TemporaryDirectory()
+
+# a function of 40 statements of 2000 terms is about 360 KB
+program = subprocess.run(['python3', os.path.join(bench, 'gen_expr.py'),
+                          str(max(1, mb * 1000 // 360)), '40', '2000'],
+                         stdout=subprocess.PIPE, text=True, check=True).stdout
+inputs = {'parse': program + 'func\n',
+          'check': program + 'func g() Void{\n    z = 1;\n    return;\n}\n'}
+for name, text in inputs.items():
+    with open(os.path.join(tmp.name, name + '.seal'), 'w') as f:
+        f.write(text)
+
+binaries = []
+for i, rev in enumerate(revs):
+    out = subprocess.run([os.path.join(bench, 'buildrev.sh'), rev,
+                          os.path.join(tmp.name, str(i))],
+                         stdout=subprocess.PIPE, text=True)
+    if out.returncode:
+        sys.exit(out.returncode)
+    binaries.append(out.stdout.strip())
+
+times = {(b, name): [] for b in binaries for name in inputs}
+for _ in range(runs):
+    for b in binaries:
+        for name in inputs:
+            start = time.perf_counter()
+            r = subprocess.run([b, os.path.join(tmp.name, name + '.seal')],
+                               stdout=subprocess.DEVNULL,
+                               stderr=subprocess.DEVNULL)
+            times[b, name].append((time.perf_counter() - start) * 1e3)
+            if r.returncode == 0:
+                sys.exit('%s: %s.seal was not rejected' % (b, name))
+
+print('%.1f MB, min/median ms of %d runs' % (len(program) / 1e6, runs))
+for rev, b in zip(revs, binaries):
+    p, c = times[b, 'parse'], times[b, 'check']
+    print('  %-12s parse %.0f/%.0f  parse+check %.0f/%.0f  check %.0f/%.0f' %
+          (rev, min(p), statistics.median(p), min(c), statistics.median(c),
+           min(c) - min(p), statistics.median(c) - statistics.median(p)))
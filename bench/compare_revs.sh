@@ -0,0 +1,30 @@
+#!/bin/bash
+#
+# compare_revs.sh OLD NEW [MB [FLAGS...]] : build semant at git
+# revisions OLD and NEW (either may be "work") with buildrev.sh and
+# time both with each of FLAGS ("" by default) on a valid program of
+# about MB megabytes (3 by default) from gen_expr.py, through
+# phases.py.  RUNS is the number of runs (15).  For example, the last
+# commit against its parent, with and without -P:
+#   bench/compare_revs.sh HEAD~ HEAD 12 "" -P
+#
+cd "$(dirname "$0")/.."
+old=$1
+new=$2
+mb=${3:-3}
+shift 3 2>/dev/null || shift $#
+[ $# -gt 0 ] || set -- ""
+tmp=$(mktemp -d)
+trap 'rm -rf $tmp' EXIT
+
+bench/buildrev.sh "$old" $tmp/old > /dev/null || exit 1
+bench/buildrev.sh "$new" $tmp/new > /dev/null || exit 1
+# a function of 100 statements of 200 terms is about 85 KB
+python3 bench/gen_expr.py $(( (mb * 1000 + 84) / 85 )) 100 200 > $tmp/input.seal
+commands=()
+for flags in "$@"; do
+    commands+=("old/semant $flags" "new/semant $flags")
+done
+echo "old: $old  new: $new"
+repo=$(pwd)
+cd $tmp && python3 $repo/bench/phases.py -n ${RUNS:-15} input.seal "${commands[@]}"
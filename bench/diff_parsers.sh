@@ -0,0 +1,63 @@
+#!/bin/bash
+#
+# diff_parsers.sh [M] : compile the same programs with the bison parser
+# and with -R, and require identical output, exit status, diagnostics
+# and -X node counts.  The programs are test/*.seal, those of
+# gen_deep.py and gen_expr.py, and M mutants of each test (40 by
+# default) made by mutate.py.  -R hands input it cannot parse back to
+# bison, which would hide any difference, so a program bison parses
+# must also be parsed by -R itself: its "descent_fallbacks" must be 0.
+# A failing mutant NAME-SEED is remade by mutate.py SEED test/NAME.seal.
+#
+cd "$(dirname "$0")/.."
+m=${1:-40}
+tmp=$(mktemp -d)
+trap 'rm -rf $tmp' EXIT
+
+for kind in chain paren assign neg if mixed; do
+    python3 bench/gen_deep.py $kind 300 > $tmp/deep-$kind.seal
+done
+python3 bench/gen_expr.py 20 10 12 > $tmp/expr.seal
+for file in test/*.seal; do
+    name=$(basename $file .seal)
+    for seed in $(seq 1 $m); do
+        python3 bench/mutate.py $seed $file > $tmp/$name-$seed.seal
+    done
+done
+
+# run ./semant with flags $1 on $2, writing its output, exit status and
+# diagnostics to $3.out and its -X counters, less the times and the
+# fallbacks, to $3.stats
+run() {
+    ./semant $1 -X json $2 > $3.out 2> $3.err
+    echo "exit $?" >> $3.out
+    grep -v '^{"file"' $3.err >> $3.out
+    grep '^{"file"' $3.err | sed -e 's/"phases_ms": {[^}]*}, "total_ms": [0-9.]*, //' \
+        -e 's/"descent_fallbacks": [0-9]*, //' > $3.stats
+}
+
+total=0
+failed=0
+fallbacks=0
+for file in test/*.seal $tmp/*.seal; do
+    run "" $file $tmp/bison
+    run "-R" $file $tmp/descent
+    total=$((total + 1))
+    why=
+    if ! cmp -s $tmp/bison.out $tmp/descent.out; then
+        why="output differs"
+    elif ! cmp -s $tmp/bison.stats $tmp/descent.stats; then
+        why="counters differ"
+    elif ! grep -q '"descent_fallbacks": 0' $tmp/descent.err; then
+        fallbacks=$((fallbacks + 1))
+        # bison exits with 255 when it cannot parse the program either
+        grep -qx "exit 255" $tmp/bison.out || why="-R fell back to bison"
+    fi
+    if [ -n "$why" ]; then
+        failed=$((failed + 1))
+        echo "NOT passed: $file: $why"
+    fi
+done
+echo "$total programs, $fallbacks left to bison on a syntax error," \
+     "$failed NOT passed"
+[ $failed -eq 0 ]
@@ -0,0 +1,53 @@
+#!/bin/bash
+#
+# diff_revs.sh OLD NEW [M] : build semant at git revisions OLD and NEW
+# (either may be "work") with buildrev.sh and require identical output,
+# exit status and diagnostics from the two under each flag set of
+# judge.sh.  The programs are test/*.seal, that of gen_ops.py, and M
+# mutants of each test (100 by default) made by mutate.py.  Both
+# revisions must have every flag of judge.sh.  A failing mutant
+# NAME-SEED is remade by mutate.py SEED test/NAME.seal.  For the
+# operator rules of [user-024], at its commit R:
+#   bench/diff_revs.sh R^ R
+#
+cd "$(dirname "$0")/.."
+old=$1
+new=$2
+m=${3:-100}
+tmp=$(mktemp -d)
+trap 'rm -rf $tmp' EXIT
+
+bench/buildrev.sh "$old" $tmp/old > /dev/null || exit 1
+bench/buildrev.sh "$new" $tmp/new > /dev/null || exit 1
+mkdir $tmp/in
+python3 bench/gen_ops.py > $tmp/in/ops.seal
+for file in test/*.seal; do
+    name=$(basename $file .seal)
+    for seed in $(seq 1 $m); do
+        python3 bench/mutate.py $seed $file > $tmp/in/$name-$seed.seal
+    done
+done
+
+# run build $1 with flags $2 on $3, writing its output, exit status and
+# diagnostics to $tmp/$1.out
+run() {
+    $tmp/$1/semant $2 $3 > $tmp/$1.out 2> $tmp/$1.err
+    echo "exit $?" >> $tmp/$1.out
+    cat $tmp/$1.err >> $tmp/$1.out
+}
+
+total=0
+failed=0
+for flags in "" "-L" "-P" "-j 3" "-R" "-A"; do
+    for file in test/*.seal $tmp/in/*.seal; do
+        run old "$flags" $file
+        run new "$flags" $file
+        total=$((total + 1))
+        if ! cmp -s $tmp/old.out $tmp/new.out; then
+            failed=$((failed + 1))
+            echo "NOT passed: $flags $file"
+        fi
+    done
+done
+echo "$total runs, $failed NOT passed"
+[ $failed -eq 0 ]
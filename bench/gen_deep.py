@@ -0,0 +1,36 @@
+#!/usr/bin/env python3
+#
+# gen_deep.py KIND N : print a valid program nested N deep, for
+# stress.sh.  The nesting is in deep(), which main() calls, so that
+# "-j 2" has two top-level declarations to split.
+#
+#   chain   a = a + 1 + 1 ... : a long left-leaning operator chain
+#   paren   a = ((...(1)...)) : N nested parentheses
+#   assign  a = a = ... = 1   : a right-leaning chain of assignments
+#   neg     a = --...-1       : N nested unary minuses
+#   if      if b { if b { ... a = 1; } } : N nested statement blocks
+#   mixed   a = a + (a * -0) + (a * -1) ... : binary, unary and parens
+#
+import sys
+
+kind, n = sys.argv[1], int(sys.argv[2])
+o = sys.stdout
+o.write("func deep() Void {\n    var a Int;\n    var b Bool;\n")
+if kind == "chain":
+    o.write("    a = a" + " + 1" * n + ";\n")
+elif kind == "paren":
+    o.write("    a = " + "(" * n + "1" + ")" * n + ";\n")
+elif kind == "assign":
+    o.write("    a = " + "a = " * n + "1;\n")
+elif kind == "neg":
+    o.write("    a = " + "-" * n + "1;\n")
+elif kind == "if":
+    o.write("if b {\n" * n)
+    o.write("a = 1;\n")
+    o.write("}\n" * n)
+elif kind == "mixed":
+    o.write("    a = a" + "".join(" + (a * -%d)" % i for i in range(n)) + ";\n")
+else:
+    sys.exit("gen_deep.py: unknown kind " + kind)
+o.write("    return;\n}\n")
+o.write("func main() Void {\n    deep();\n    return;\n}\n")
@@ -0,0 +1,25 @@
+#!/usr/bin/env python3
+#
+# gen_expr.py F S T : print a valid, expression-heavy program of F
+# functions, each with S statements assigning an expression of T mixed
+# Int and Float terms, and a boolean one beside each.  Used by the
+# checker and lexer benchmarks.
+#
+import sys
+
+nf, ns, nt = map(int, sys.argv[1:4])
+out = []
+for f in range(nf):
+    out.append("func %s() Void{" % ("main" if f == 0 else "f%d" % f))
+    out.append("    var x Int;\n    var y Float;\n    var b Bool;")
+    out.append("    x = 1;\n    y = 2.0;")
+    terms = ["x", "y", "1", "2.5"]
+    ops = ["+", "-", "*", "/"]
+    for s in range(ns):
+        e = terms[0]
+        for t in range(1, nt):
+            e += " %s %s" % (ops[t % 4], terms[t % 4])
+        out.append("    y = %s;" % e)
+        out.append("    b = (x < y) && (y >= 1.0) || (x != 3);")
+    out.append("    return;\n}")
+print("\n".join(out))
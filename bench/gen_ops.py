@@ -0,0 +1,25 @@
+#!/usr/bin/env python3
+#
+# gen_ops.py : print a program that applies every binary operator to
+# every pair of operand types, and every unary operator to every type,
+# Void (a call) included, each as a statement of its own.  Most of them
+# are ill-typed, so the program exercises each typing rule and each of
+# its diagnostics; used by diff_revs.sh.
+#
+binary = ['+', '-', '*', '/', '%', '<', '<=', '>', '>=', '==', '!=',
+          '&&', '||', '^', '&', '|']
+unary = ['-', '!', '~']
+operands = ['i', 'f', 's', 'b', 'v()']
+
+out = ['func v() Void{\n    return;\n}',
+       'func main() Void{',
+       '    var i Int;\n    var f Float;\n    var s String;\n    var b Bool;']
+for op in binary:
+    for a in operands:
+        for c in operands:
+            out.append('    %s %s %s;' % (a, op, c))
+for op in unary:
+    for a in operands:
+        out.append('    %s%s;' % (op, a))
+out.append('    return;\n}')
+print('\n'.join(out))
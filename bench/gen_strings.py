@@ -0,0 +1,25 @@
+#!/usr/bin/env python3
+#
+# gen_strings.py N : print a valid program assigning N string literals
+# of 20 to 80 characters, every fourth with escapes and every tenth a
+# raw `...` literal.  Used with lex_bench.sh to time string constants.
+#
+import random
+import sys
+
+n = int(sys.argv[1])
+rnd = random.Random(1)
+letters = "abcdefghijklmnopqrstuvwxyz ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789"
+escapes = ["\\n", "\\t", "\\\\", "\\\"", "\\x41", "\\101"]
+out = ["func main() Void{", "    var s String;"]
+for i in range(n):
+    text = "".join(rnd.choice(letters) for _ in range(rnd.randint(20, 80)))
+    if i % 10 == 9:
+        out.append("    s = `%s`;" % text)
+        continue
+    if i % 4 == 3:
+        k = rnd.randint(0, len(text))
+        text = text[:k] + rnd.choice(escapes) + text[k:]
+    out.append('    s = "%s";' % text)
+out.append("    return;\n}")
+print("\n".join(out))
@@ -0,0 +1,42 @@
+//
+// intern_bench.cc : intern N distinct identifiers into an IdTable, then
+// look each of them up again by adding it a second time, and print the
+// time each pass took.  Built against a tree's stringtab.o by
+// intern_bench.sh, so that revisions of the table can be compared.
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include "stringtab.h"
+
+// stringtab.o's only outside reference, from its print(); the rest of
+// utilities.o would pull in the parser
+char *pad(int n) { static char spaces[] = ""; return spaces; }
+
+static double seconds_since(std::chrono::steady_clock::time_point t0) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0)
+      .count();
+}
+
+int main(int argc, char *argv[]) {
+  int n = argc > 1 ? atoi(argv[1]) : 1000000;
+  char name[32];
+  IdTable table;
+
+  std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < n; i++) {
+    snprintf(name, sizeof name, "id%d", i);
+    table.add_string(name);
+  }
+  double add = seconds_since(t0);
+
+  t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < n; i++) {
+    snprintf(name, sizeof name, "id%d", i);
+    table.add_string(name);
+  }
+  double again = seconds_since(t0);
+
+  printf("%d ids: add %.3f s, add again %.3f s\n", n, add, again);
+  return 0;
+}
@@ -0,0 +1,24 @@
+#!/bin/bash
+#
+# intern_bench.sh [N [REV...]] : build intern_bench.cc against the
+# stringtab.o of each git revision REV (or "work"), by default the list
+# tables of the baseline and the working tree's, and intern N (50000)
+# identifiers with each.  The list tables are quadratic; 1M
+# identifiers is only worth running on the hashed ones.
+#
+cd "$(dirname "$0")/.."
+n=${1:-50000}
+shift
+[ $# -gt 0 ] || set -- 302f988 work
+tmp=$(mktemp -d)
+trap 'rm -rf $tmp' EXIT
+
+i=0
+for rev in "$@"; do
+    dir=$tmp/$i
+    i=$((i + 1))
+    bench/buildrev.sh "$rev" $dir > /dev/null || exit 1
+    g++ -O2 -pthread -I$dir bench/intern_bench.cc $dir/stringtab.o -o $dir/intern_bench || exit 1
+    printf '%-12s ' "$rev"
+    $dir/intern_bench $n
+done
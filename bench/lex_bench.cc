@@ -0,0 +1,64 @@
+//
+// lex_bench.cc [FLAGS] FILE : run the lexer over FILE on its own, RUNS
+// times (3), with -m scanning it in place through mmap and -L with
+// seal-scan.cc, and print the tokens and the best throughput.  Each
+// run opens the file, scans it, interns its identifiers and constants,
+// and releases the tables, as a compilation does.  Linked with every
+// object of semant but semant-phase.o by lex_bench.sh.
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <chrono>
+#include "seal-lex.h"
+#include "stringtab.h"
+
+// the globals of semant-phase.cc that the lexer uses
+thread_local FILE *fin;
+thread_local char *curr_filename = "<stdin>";
+
+extern int optind;
+void handle_flags(int argc, char *argv[]);
+
+int main(int argc, char *argv[]) {
+  handle_flags(argc, argv);
+  const char *path = argv[optind];
+  int runs = getenv("RUNS") ? atoi(getenv("RUNS")) : 3;
+  double best = 0;
+  long tokens = 0;
+  struct stat st;
+
+  if (stat(path, &st) != 0) {
+    fprintf(stderr, "Could not open input file %s\n", path);
+    exit(1);
+  }
+  for (int r = 0; r < runs; r++) {
+    std::chrono::steady_clock::time_point t0 =
+        std::chrono::steady_clock::now();
+    fin = fopen(path, "r");
+    if (fin == NULL) {
+      fprintf(stderr, "Could not open input file %s\n", path);
+      exit(1);
+    }
+    SourceLoc start = source_manager.add_file(path, fin);
+    scanner_open(fin, start);
+    tokens = 0;
+    while (scanner_lex() > 0)
+      tokens++;
+    scanner_close();
+    double s = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - t0).count();
+    if (r == 0 || s < best)
+      best = s;
+    source_manager.remove_file(start);
+    fclose(fin);
+    idtable.release();
+    stringtable.release();
+    inttable.release();
+    floatspellings.release();
+  }
+  printf("%.1f MB, %ld tokens: best of %d %.0f ms, %.0f MB/s\n",
+         st.st_size / 1e6, tokens, runs, best * 1e3, st.st_size / 1e6 / best);
+  return 0;
+}
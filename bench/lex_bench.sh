@@ -0,0 +1,33 @@
+#!/bin/bash
+#
+# lex_bench.sh [MB|FILE [FLAGS...]] : build lex_bench.cc against an
+# -O2 build of git revision REV (by default the working tree) and time
+# the lexer on its own with each of FLAGS (by default "", reading
+# through flex's buffer, -m, scanning in place, and -L, the scanner of
+# seal-scan.cc) on FILE, or on a valid program of about MB megabytes
+# (10 by default) from gen_expr.py.  CFLAGS, if set, replaces the
+# flags of the build, e.g. to force a kernel set of seal-scan.cc.
+# For string constants:
+#   bench/gen_strings.py 200000 > /tmp/strings.seal
+#   bench/lex_bench.sh /tmp/strings.seal
+#
+cd "$(dirname "$0")/.."
+mb=${1:-10}
+shift
+[ $# -gt 0 ] || set -- "" "-m" "-L"
+tmp=$(mktemp -d)
+trap 'rm -rf $tmp' EXIT
+
+bench/buildrev.sh "${REV:-work}" $tmp/build ${CFLAGS:+"$CFLAGS"} > /dev/null || exit 1
+g++ -O2 -pthread -Wno-write-strings -I$tmp/build bench/lex_bench.cc \
+    $(ls $tmp/build/*.o | grep -v semant-phase.o) -o $tmp/lex_bench || exit 1
+if [ -f "$mb" ]; then
+    cp "$mb" $tmp/input.seal
+else
+    # a function of 100 statements of 200 terms is about 85 KB
+    python3 bench/gen_expr.py $(( (mb * 1000 + 84) / 85 )) 100 200 > $tmp/input.seal
+fi
+for flags in "$@"; do
+    printf '%-8s ' "${flags:-(none)}"
+    $tmp/lex_bench $flags $tmp/input.seal
+done
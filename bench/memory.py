@@ -0,0 +1,26 @@
+#!/usr/bin/env python3
+#
+# memory.py FILE COMMAND... : run each COMMAND, a semant binary and its
+# flags given as one argument (e.g. "./semant -A"), on FILE with -M and
+# print its peak resident size together with the AST lines of -M: the
+# bytes of the pointer AST's arena and, under -A, of the flat copy.
+#
+import os
+import shlex
+import subprocess
+import sys
+
+path, commands = sys.argv[1], sys.argv[2:]
+print('%s: %.1f MB' % (path, os.path.getsize(path) / 1e6))
+for c in commands:
+    p = subprocess.Popen(shlex.split(c) + ['-M', path],
+                         stdout=subprocess.DEVNULL, stderr=subprocess.PIPE,
+                         text=True)
+    err = p.stderr.read()
+    _, status, usage = os.wait4(p.pid, 0)
+    lines = [l for l in err.splitlines()
+             if l.startswith('ast:') or l.startswith('flat ast:')]
+    print('  %-24s peak %.1f MB, exit %d' %
+          (c, usage.ru_maxrss / 1024, os.waitstatus_to_exitcode(status)))
+    for l in lines:
+        print('    ' + l)
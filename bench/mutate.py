@@ -0,0 +1,46 @@
+#!/usr/bin/env python3
+#
+# mutate.py SEED FILE : print FILE with a few of its tokens changed, for
+# diff_parsers.sh.  Every seed replaces a few names, types and constants
+# with others of their kind, which keeps the program parseable and
+# exercises the checker; odd seeds also drop or repeat a token, which
+# mostly makes a syntax error.
+#
+import random
+import re
+import sys
+
+seed, path = int(sys.argv[1]), sys.argv[2]
+random.seed(seed)
+text = open(path, newline='').read()
+tokens = re.findall(r'\s+|"(?:[^"\\\n]|\\.)*"|`[^`]*`|//[^\n]*|/\*.*?\*/'
+                    r'|[A-Za-z_][A-Za-z_0-9]*|\d+(?:\.\d+)?'
+                    r'|&&|\|\||==|!=|<=|>=|.', text, re.S)
+keywords = {'func', 'var', 'if', 'else', 'while', 'for', 'return',
+            'break', 'continue', 'struct', 'true', 'false'}
+
+# a name, a type or a constant is only replaced by another of its kind
+def kind(t):
+    if re.match(r'[a-z_][A-Za-z_0-9]*$', t) and t not in keywords:
+        return 'name'
+    if re.match(r'[A-Z][A-Za-z_0-9]*$', t):
+        return 'type'
+    if re.match(r'[0-9"`]', t) or t in ('true', 'false'):
+        return 'constant'
+    return None
+
+pools = {'name': [], 'type': ['Int', 'Bool', 'Float', 'String', 'Void'],
+         'constant': ['true', '1.5', '"s"', '0x1f', '7']}
+for t in tokens:
+    if kind(t):
+        pools[kind(t)].append(t)
+changeable = [i for i, t in enumerate(tokens) if kind(t)]
+for _ in range(random.randint(1, 4)):
+    if changeable:
+        i = random.choice(changeable)
+        tokens[i] = random.choice(pools[kind(tokens[i])])
+if seed % 2:
+    solid = [i for i, t in enumerate(tokens) if not t.isspace()]
+    i = random.choice(solid)
+    tokens[i] = random.choice(['', tokens[i] + ' ' + tokens[i]])
+sys.stdout.write(''.join(tokens))
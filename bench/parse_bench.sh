@@ -0,0 +1,26 @@
+#!/bin/bash
+#
+# parse_bench.sh [MB [FLAGS...]] : time ./semant with each of FLAGS
+# (by default the bison parser, "", and -R) on a valid program of about
+# MB megabytes (12 by default) from gen_expr.py, through phases.py.
+# SEMANT names another build to time, RUNS the number of runs (5).
+# The lexer thread of -P against the default, with either scanner:
+#   bench/parse_bench.sh 50 "" -P -L "-P -L"
+# The numbers in the commit messages are from an -O2 build:
+#   make clean; make CFLAGS="-O2 -pthread -I. -DDEBUG"
+#
+cd "$(dirname "$0")/.."
+mb=${1:-12}
+shift
+[ $# -gt 0 ] || set -- "" "-R"
+semant=${SEMANT:-./semant}
+tmp=$(mktemp -d)
+trap 'rm -rf $tmp' EXIT
+
+# a function of 100 statements of 200 terms is about 85 KB
+python3 bench/gen_expr.py $(( (mb * 1000 + 84) / 85 )) 100 200 > $tmp/input.seal
+commands=()
+for flags in "$@"; do
+    commands+=("$semant $flags")
+done
+python3 bench/phases.py -n ${RUNS:-5} $tmp/input.seal "${commands[@]}"
@@ -0,0 +1,48 @@
+#!/usr/bin/env python3
+#
+# phases.py [-n RUNS] FILE COMMAND... : run each COMMAND, a semant
+# binary and its flags given as one argument (e.g. "./semant -R"), RUNS
+# times on FILE with -X json and print the min/median time of every
+# phase that took any, in ms.  The runs of the commands are interleaved
+# so that they see the same machine.  The parse column is followed by
+# the throughput of the best parse in MB/s of FILE.
+#
+import json
+import os
+import shlex
+import statistics
+import subprocess
+import sys
+
+args = sys.argv[1:]
+runs = 5
+if args[:1] == ['-n']:
+    runs, args = int(args[1]), args[2:]
+path, commands = args[0], args[1:]
+megabytes = os.path.getsize(path) / 1e6
+
+times = {c: {} for c in commands}
+for _ in range(runs):
+    for c in commands:
+        r = subprocess.run(shlex.split(c) + ['-X', 'json', path],
+                           stdout=subprocess.DEVNULL, stderr=subprocess.PIPE,
+                           text=True)
+        stats = [l for l in r.stderr.splitlines() if l.startswith('{"file"')]
+        if not stats:
+            sys.exit('%s: no -X output (exit %d)' % (c, r.returncode))
+        d = json.loads(stats[-1])
+        phases = dict(d['phases_ms'], total=d['total_ms'])
+        for name, ms in phases.items():
+            times[c].setdefault(name, []).append(ms)
+
+print('%s: %.1f MB, min/median ms of %d runs' % (path, megabytes, runs))
+for c in commands:
+    cells = []
+    for name, ms in times[c].items():
+        if max(ms) < 0.5:
+            continue
+        cell = '%s %.0f/%.0f' % (name, min(ms), statistics.median(ms))
+        if name == 'parse':
+            cell += ' (%.0f MB/s)' % (megabytes / min(ms) * 1e3)
+        cells.append(cell)
+    print('  %-20s %s' % (c, '  '.join(cells)))
@@ -0,0 +1,64 @@
+#!/bin/bash
+#
+# stress.sh [N] : run the deeply nested programs of gen_deep.py through
+# every front end under a reduced stack (STACK_KB, 1024 by default).
+# Each program must compile with the bison parser and give the same
+# output and exit status with the others.  Every program is run at N
+# and at 2N nesting (N is 20000 by default); the last column is the
+# ratio of the two times, which stays near 2 when a front end is
+# linear in the nesting.
+#
+# Then the inputs that once overflowed -R's recursion under a small
+# stack, 9999 nested parentheses and 20000 nested ifs, go through every
+# front end once more, whatever N is.
+#
+cd "$(dirname "$0")/.."
+n=${1:-20000}
+stack=${STACK_KB:-1024}
+tmp=$(mktemp -d)
+trap 'rm -rf $tmp' EXIT
+
+# run ./semant with flags $1 on $2 under the reduced stack, writing its
+# output and exit status to $3; prints the time it took in ms
+run() {
+    local start=$(date +%s%N)
+    (ulimit -s $stack; ./semant $1 $2 > $3 2>&1; echo "exit $?" >> $3)
+    echo $(( ($(date +%s%N) - start) / 1000000 ))
+}
+
+printf "%-8s %-6s %9s %9s %6s\n" kind flags "${n}" "$((2 * n))" ratio
+for kind in chain paren assign neg if mixed; do
+    for size in $n $((2 * n)); do
+        python3 bench/gen_deep.py $kind $size > $tmp/$size.seal
+        run "" $tmp/$size.seal $tmp/$size.expect > /dev/null
+    done
+    for flags in "" "-L" "-P" "-j 2" "-R"; do
+        result=Passed
+        times=()
+        for size in $n $((2 * n)); do
+            times+=($(run "$flags" $tmp/$size.seal $tmp/out))
+            if ! grep -qx "exit 0" $tmp/$size.expect ||
+               ! cmp -s $tmp/out $tmp/$size.expect; then
+                result="NOT passed"
+            fi
+        done
+        ratio=$(awk "BEGIN { printf \"%.1f\", ${times[1]} / (${times[0]} ? ${times[0]} : 1) }")
+        printf "%-8s %-6s %6d ms %6d ms %6s  %s\n" $kind "${flags:--}" \
+            ${times[0]} ${times[1]} $ratio "$result"
+    done
+done
+
+printf "%-10s %-6s %9s\n" regress flags time
+for case in "paren 9999" "if 20000"; do
+    python3 bench/gen_deep.py $case > $tmp/regress.seal
+    run "" $tmp/regress.seal $tmp/regress.expect > /dev/null
+    for flags in "" "-L" "-P" "-j 2" "-R"; do
+        ms=$(run "$flags" $tmp/regress.seal $tmp/out)
+        result=Passed
+        if ! grep -qx "exit 0" $tmp/regress.expect ||
+           ! cmp -s $tmp/out $tmp/regress.expect; then
+            result="NOT passed"
+        fi
+        printf "%-10s %-6s %6d ms  %s\n" ${case// /-} "${flags:--}" $ms "$result"
+    done
+done
@@ -10,18 +10,64 @@
 #include "seal-stmt.h"
 #include "seal-expr.h"
 #include "utilities.h"
+#include "dumpwriter.h"
+#include "visitor.h"
 
-// defined in stringtab.cc
-void dump_Symbol(ostream& stream, int padding, Symbol b); 
+extern int dump_slots;
 
-// defined in seal.h
-void dump_Boolean(ostream& stream, int padding, Boolean b);
+//////////////////////////////////////////////////////////////////
+//
+//  AstDumpWriter
+//
+//////////////////////////////////////////////////////////////////
+
+const char AstDumpWriter::spaces[MAX_PAD + 1] =
+   "                                                                                ";
+
+AstDumpWriter::AstDumpWriter(ostream& s, size_t size) : out(s), cap(size), len(0)
+{
+   buf = new char[cap];
+}
+
+AstDumpWriter::~AstDumpWriter()
+{
+   flush();
+   delete [] buf;
+}
+
+void AstDumpWriter::flush()
+{
+   if (len > 0) {
+      out.write(buf, len);
+      len = 0;
+   }
+}
+
+AstDumpWriter& AstDumpWriter::operator<<(int i)
+{
+   char digits[12];
+   int n = snprintf(digits, sizeof digits, "%d", i);
+   write(digits, n);
+   return *this;
+}
+
+// AstDumpWriter counterparts of dump_Symbol in stringtab.cc and
+// dump_Boolean in seal-tree.handcode.h
+static void dump_Symbol(AstDumpWriter& stream, int padding, Symbol b)
+{
+   stream.pad(padding) << b << "\n";
+}
+
+static void dump_Boolean(AstDumpWriter& stream, int padding, Boolean b)
+{
+   stream.pad(padding) << (int) b << "\n";
+}
 
 //////////////////////////////////////////////////////////////////
 //
 //  dumptype.cc
 //
-//  dumptype defines a simple recursive traversal of the abstract
+//  dumptype defines a simple traversal of the abstract
 //  syntax tree (AST) that prints each node and any associated
 //  type information.  Use dump_with_types to inspect the results of
 //  type inference.
@@ -33,11 +79,11 @@ void dump_Boolean(ostream& stream, int padding, Boolean b);
 //   
 //  dump_with_types is just a simple pretty printer, formatting the output
 //  to show the AST relationships between nodes and their types.
-//  dump_type is a virtual function, with a separate implementation for
-//  each kind of AST node.  Using virtual functions is an easy way to
-//  implement recursive tree traversals in C++; each kind of tree node
-//  has a virtual function that "knows" how to perform the part of
-//  the traversal for that one node.  It may help to know the inheritance hierarchy
+//  TypeDumper has a separate handler for each kind of AST node; each
+//  handler "knows" how to perform the part of the traversal for that
+//  one node, while dump_with_types keeps track of where it is in the
+//  tree.  It
+//  may help to know the inheritance hierarchy
 //  of the declarations that define the structure of the Seal AST. 
 //   
 //  Program_class
@@ -114,451 +160,486 @@ void dump_Boolean(ostream& stream, int padding, Boolean b);
 //
 //
 
-void Expr_class::dump_type(ostream& stream, int n)
+template <class View, class H>
+static void dump_type(AstDumpWriter& stream, int n, View view, H e)
 {
+  Symbol type = view.type(e);
   if (type)
-    { stream << pad(n) << ": " << type << endl; }
+    { stream.pad(n) << ": " << type << "\n"; }
   else
-    { stream << pad(n) << ": _no_type" << endl; }
+    { stream.pad(n) << ": _no_type" << "\n"; }
 }
 
-
-void Call_class::dump_type(ostream& stream, int n)
+template <class View, class H>
+static void dump_line(AstDumpWriter& stream, int n, View view, H t)
 {
-  if (type)
-    { stream << pad(n) << ": " << type << endl; }
-  else
-    { stream << pad(n) << ": _no_type" << endl; }
+  stream.pad(n) << "#" << view.line_number(t) << "\n";
 }
 
-void Actual_class::dump_type(ostream& stream, int n)
+//
+//  The frame slots of -F.
+//
+template <class View>
+static void dump_slot(AstDumpWriter& stream, int n, View view, typename View::Variable v)
 {
-  if (type)
-    { stream << pad(n) << ": " << type << endl; }
-  else
-    { stream << pad(n) << ": _no_type" << endl; }
+   if (dump_slots && view.slot(v) >= 0) {
+      stream.pad(n+2) << "(slot)\n";
+      stream.pad(n+2) << view.slot(v) << "\n";
+   }
 }
 
-void dump_line(ostream& stream, int n, tree_node *t)
+template <class View>
+static void dump_frame_size(AstDumpWriter& stream, int n, View view, typename View::CallDecl d)
 {
-  stream << pad(n) << "#" << t->get_line_number() << "\n";
+   if (dump_slots) {
+      stream.pad(n+2) << "(frame size)\n";
+      stream.pad(n+2) << view.frame_size(d) << "\n";
+   }
+}
+
+// the symbol an operator prints as; typed is set if the dump shows the
+// operator's type
+static const char *operator_text(NodeKind kind, bool& typed)
+{
+   typed = false;
+   switch (kind) {
+   case NODE_ADD:    typed = true; return "+\n";
+   case NODE_MINUS:  typed = true; return "-\n";
+   case NODE_MULTI:  typed = true; return "*\n";
+   case NODE_DIVIDE: typed = true; return "/\n";
+   case NODE_MOD:    typed = true; return "%\n";
+   case NODE_NEG:    typed = true; return "-\n";
+   case NODE_LT:     typed = true; return "<\n";
+   case NODE_LE:     return "<=\n";
+   case NODE_EQU:    return "==\n";
+   case NODE_NEQ:    return "!=\n";
+   case NODE_GE:     return ">=\n";
+   case NODE_GT:     return ">\n";
+   case NODE_AND:    return "&&\n";
+   case NODE_OR:     return "||\n";
+   case NODE_XOR:    return "^\n";
+   case NODE_NOT:    return "!\n";
+   case NODE_BITAND: return "&\n";
+   case NODE_BITOR:  return "|\n";
+   default:          return "~\n";
+   }
 }
 
 //
-//  program_class prints "program" and then each of the
-//  component classes of the program, one at a time, at a
-//  greater indentation. The recursive invocation on
-//  "classes->nth(i)->dump_with_types(...)" shows how useful
-//  and compact virtual functions are for this kind of computation.
+//  TypeDumper is the pass behind dump_with_types (see visitor.h), over
+//  either form of the AST (see astview.h), so the FlatAst of -A prints
+//  exactly what the tree it was built from prints.  Its handler for a
+//  node takes the step of the node, the number of its children already
+//  printed: it prints whatever comes before its next child and returns
+//  that child, or at the last step prints the rest and returns none.
 //
-//  Note the use of the iterator to cycle through all of the
-//  classes.  The methods first, more, next, and nth on AST lists
-//  are defined in tree.h.
+//  visit_program prints "program" and then each of the component
+//  classes of the program, one at a time, at a greater indentation.
+//  Step i returns the i'th declaration, which dump_with_types prints
+//  before coming back for step i+1.
 //
-void Program_class::dump_with_types(ostream& stream, int n)
-{
-   dump_line(stream,n,this);
-   stream << pad(n) << "Program\n";
-   for(int i = decls->first(); decls->more(i); i = decls->next(i)){
-      decls->nth(i)->dump_with_types(stream, n+2);
+template <class View>
+class TypeDumper : public AstVisitor<TypeDumper<View>, View> {
+   typedef AstVisitor<TypeDumper<View>, View> Visitor;
+   typedef typename View::Node Node;
+   using Visitor::view;
+   AstDumpWriter& stream;
+   template <class Const>
+   Node dump_const(Const e, int n, const char *name);
+public:
+   TypeDumper(AstDumpWriter& s, View v) : Visitor(v), stream(s) { }
+   template <class H> Node visit_program(H p, int n, int step);
+   template <class H> Node visit_variable_decl(H d, int n, int step);
+   template <class H> Node visit_variable(H v, int n, int step);
+   template <class H> Node visit_call_decl(H d, int n, int step);
+   template <class H> Node visit_stmt_block(H s, int n, int step);
+   template <class H> Node visit_if(H s, int n, int step);
+   template <class H> Node visit_while(H s, int n, int step);
+   template <class H> Node visit_for(H s, int n, int step);
+   template <class H> Node visit_break(H s, int n, int step);
+   template <class H> Node visit_continue(H s, int n, int step);
+   template <class H> Node visit_return(H s, int n, int step);
+   template <class H> Node visit_assign(H e, int n, int step);
+   template <class Op> Node visit_binary(Op e, int n, int step);
+   template <class Op> Node visit_unary(Op e, int n, int step);
+   template <class H> Node visit_object(H e, int n, int step);
+   template <class H> Node visit_call(H e, int n, int step);
+   template <class H> Node visit_actual(H e, int n, int step);
+   template <class H> Node visit_const_int(H e, int n, int step);
+   template <class H> Node visit_const_string(H e, int n, int step);
+   template <class H> Node visit_const_float(H e, int n, int step);
+   template <class H> Node visit_const_bool(H e, int n, int step);
+   template <class H> Node visit_no_expr(H e, int n, int step);
+};
+
+template <class View> template <class H>
+typename View::Node TypeDumper<View>::visit_program(H p, int n, int step)
+{
+   if (step == 0) {
+      dump_line(stream,n,view,p);
+      stream.pad(n) << "Program\n";
    }
-     
+   if (step < view.decl_count(p))
+      return view.decl(p, step);
+   return View::none;
 }
 
-void VariableDecl_class::dump_with_types(ostream& stream, int n)
+template <class View> template <class H>
+typename View::Node TypeDumper<View>::visit_variable_decl(H d, int n, int step)
 {
-   dump_line(stream,n,this);
-   stream << pad(n) << "Variable Declaration\n";
-   variable->dump_with_types(stream, n+2);
+   if (step == 0) {
+      dump_line(stream,n,view,d);
+      stream.pad(n) << "Variable Declaration\n";
+      return view.node(view.variable(d));
+   }
+   return View::none;
 }
 
-void Variable_class::dump_with_types(ostream& stream, int n)
+template <class View> template <class H>
+typename View::Node TypeDumper<View>::visit_variable(H v, int n, int step)
 {
-   dump_line(stream,n,this);
-   stream << pad(n) << "Variable\n";
-   stream << pad(n+2) << "(name)\n";
-   dump_Symbol(stream, n+2, name);
-   stream << pad(n+2) << "(type)\n";
-   dump_Symbol(stream, n+2, type);
+   dump_line(stream,n,view,v);
+   stream.pad(n) << "Variable\n";
+   stream.pad(n+2) << "(name)\n";
+   dump_Symbol(stream, n+2, view.name(v));
+   stream.pad(n+2) << "(type)\n";
+   dump_Symbol(stream, n+2, view.type(v));
+   dump_slot(stream, n, view, v);
+   return View::none;
 }
 
-
-void CallDecl_class::dump_with_types(ostream& stream, int n)
+template <class View> template <class H>
+typename View::Node TypeDumper<View>::visit_call_decl(H d, int n, int step)
 {
-   dump_line(stream,n,this);
-   stream << pad(n) << "Call Declaration\n";
-   stream << pad(n+2) << "(name)\n";
-   dump_Symbol(stream, n+2, name);
-   stream << pad(n+2) << "(parameters)\n";
-   stream << pad(n+2) << "(\n";
-   for(int i = paras->first(); paras->more(i); i = paras->next(i))
-     paras->nth(i)->dump_with_types(stream, n+2);
-   stream << pad(n+2) << ")\n";
-   stream << pad(n+2) << "(return type)\n";
-   dump_Symbol(stream, n+2, returnType);
-   stream << pad(n+2) << "(body)\n";
-   body->dump_with_types(stream, n+2);
-   
+   if (step == 0) {
+      dump_line(stream,n,view,d);
+      stream.pad(n) << "Call Declaration\n";
+      stream.pad(n+2) << "(name)\n";
+      dump_Symbol(stream, n+2, view.name(d));
+      stream.pad(n+2) << "(parameters)\n";
+      stream.pad(n+2) << "(\n";
+   }
+   if (step < view.param_count(d))
+      return view.node(view.param(d, step));
+   if (step == view.param_count(d)) {
+      stream.pad(n+2) << ")\n";
+      stream.pad(n+2) << "(return type)\n";
+      dump_Symbol(stream, n+2, view.type(d));
+      dump_frame_size(stream, n, view, d);
+      stream.pad(n+2) << "(body)\n";
+      return view.body(d);
+   }
+   return View::none;
 }
 
-void StmtBlock_class::dump_with_types(ostream& stream, int n)
+template <class View> template <class H>
+typename View::Node TypeDumper<View>::visit_stmt_block(H s, int n, int step)
 {
-   dump_line(stream,n,this);
-   stream << pad(n) << "Statement Block\n";
-   stream << pad(n+2) << "(variable declarations)\n";
-   stream << pad(n+2) << "(\n";
-   for(int i = vars->first(); vars->more(i); i = vars->next(i))
-     vars->nth(i)->dump_with_types(stream, n+2);
-   stream << pad(n+2) << ")\n";
-   stream << pad(n+2) << "(statements)\n";
-   stream << pad(n+2) << "(\n";
-   for(int i = stmts->first(); stmts->more(i); i = stmts->next(i))
-     stmts->nth(i)->dump_with_types(stream, n+2);
-   stream << pad(n+2) << ")\n";
+   if (step == 0) {
+      dump_line(stream,n,view,s);
+      stream.pad(n) << "Statement Block\n";
+      stream.pad(n+2) << "(variable declarations)\n";
+      stream.pad(n+2) << "(\n";
+   }
+   if (step < view.var_count(s))
+      return view.node(view.var_decl(s, step));
+   int i = step - view.var_count(s);
+   if (i == 0) {
+      stream.pad(n+2) << ")\n";
+      stream.pad(n+2) << "(statements)\n";
+      stream.pad(n+2) << "(\n";
+   }
+   if (i < view.stmt_count(s))
+      return view.stmt(s, i);
+   stream.pad(n+2) << ")\n";
+   return View::none;
+}
+
+template <class View> template <class H>
+typename View::Node TypeDumper<View>::visit_if(H s, int n, int step)
+{
+   switch (step) {
+   case 0:
+      dump_line(stream,n,view,s);
+      stream.pad(n) << "IfStmt\n";
+      stream.pad(n+2) << "(condition)\n";
+      return view.condition(s);
+   case 1:
+      stream.pad(n+2) << "(then)\n";
+      return view.then_branch(s);
+   case 2:
+      stream.pad(n+2) << "(else)\n";
+      return view.else_branch(s);
+   default:
+      return View::none;
+   }
 }
 
-void IfStmt_class::dump_with_types(ostream& stream, int n)
-{
-   dump_line(stream,n,this);
-   stream << pad(n) << "IfStmt\n";
-   stream << pad(n+2) << "(condition)\n";
-   condition->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(then)\n";
-   thenexpr->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(else)\n";
-   elseexpr->dump_with_types(stream, n+2); 
+template <class View> template <class H>
+typename View::Node TypeDumper<View>::visit_while(H s, int n, int step)
+{
+   switch (step) {
+   case 0:
+      dump_line(stream,n,view,s);
+      stream.pad(n) << "WhileStmt\n";
+      stream.pad(n+2) << "(condition)\n";
+      return view.condition(s);
+   case 1:
+      stream.pad(n+2) << "(body)\n";
+      return view.body(s);
+   default:
+      return View::none;
+   }
 }
 
-void WhileStmt_class::dump_with_types(ostream& stream, int n)
-{
-   dump_line(stream,n,this);
-   stream << pad(n) << "WhileStmt\n";
-   stream << pad(n+2) << "(condition)\n";
-   condition->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(body)\n";
-   body->dump_with_types(stream, n+2);
+template <class View> template <class H>
+typename View::Node TypeDumper<View>::visit_for(H s, int n, int step)
+{
+   switch (step) {
+   case 0:
+      dump_line(stream,n,view,s);
+      stream.pad(n) << "ForStmt\n";
+      stream.pad(n+2) << "(init)\n";
+      return view.init(s);
+   case 1:
+      stream.pad(n+2) << "(condition)\n";
+      return view.condition(s);
+   case 2:
+      stream.pad(n+2) << "(loop)\n";
+      return view.loop(s);
+   case 3:
+      stream.pad(n+2) << "(body)\n";
+      return view.body(s);
+   default:
+      return View::none;
+   }
 }
 
-void ForStmt_class::dump_with_types(ostream& stream, int n)
+template <class View> template <class H>
+typename View::Node TypeDumper<View>::visit_break(H s, int n, int step)
 {
-   dump_line(stream,n,this);
-   stream << pad(n) << "ForStmt\n";
-   stream << pad(n+2) << "(init)\n";
-   initexpr->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(condition)\n";
-   condition->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(loop)\n";
-   loopact->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(body)\n";
-   body->dump_with_types(stream, n+2);
+   dump_line(stream,n,view,s);
+   stream.pad(n) << "BreakStmt\n";
+   return View::none;
 }
 
-void BreakStmt_class::dump_with_types(ostream& stream, int n)
+template <class View> template <class H>
+typename View::Node TypeDumper<View>::visit_continue(H s, int n, int step)
 {
-   dump_line(stream,n,this);
-   stream << pad(n) << "BreakStmt\n";
+   dump_line(stream,n,view,s);
+   stream.pad(n) << "ContinueStmt\n";
+   return View::none;
 }
 
-
-void ContinueStmt_class::dump_with_types(ostream& stream, int n)
+template <class View> template <class H>
+typename View::Node TypeDumper<View>::visit_return(H s, int n, int step)
 {
-   dump_line(stream,n,this);
-   stream << pad(n) << "ContinueStmt\n";
+   if (step == 0) {
+      dump_line(stream,n,view,s);
+      stream.pad(n) << "ReturnStmt\n";
+      stream.pad(n+2) << "(return value)\n";
+      return view.value(s);
+   }
+   return View::none;
 }
 
-void ReturnStmt_class::dump_with_types(ostream& stream, int n)
+template <class View> template <class H>
+typename View::Node TypeDumper<View>::visit_assign(H e, int n, int step)
 {
-   dump_line(stream,n,this);
-   stream << pad(n) << "ReturnStmt\n";
-   stream << pad(n+2) << "(return value)\n";
-   value->dump_with_types(stream, n+2);
+   if (step == 0) {
+      dump_line(stream,n,view,e);
+      stream.pad(n) << "Assign\n";
+      stream.pad(n+2) << "(left value)\n";
+      dump_Symbol(stream, n+2, view.name(e));
+      stream.pad(n+2) << "(right value)\n";
+      return view.value(e);
+   }
+   stream.pad(n+2) << "(type)\n";
+   dump_type(stream,n,view,e);
+   return View::none;
+}
+
+// Only some of the operators print their type.
+template <class View> template <class Op>
+typename View::Node TypeDumper<View>::visit_binary(Op e, int n, int step)
+{
+   bool typed;
+   const char *op = operator_text(view.kind(view.node(e)), typed);
+   switch (step) {
+   case 0:
+      dump_line(stream,n,view,e);
+      stream.pad(n) << op;
+      stream.pad(n+2) << "(OP left)\n";
+      return view.left(e);
+   case 1:
+      stream.pad(n+2) << "(OP right)\n";
+      return view.right(e);
+   default:
+      stream.pad(n+2) << "(type)\n";
+      if (typed)
+         dump_type(stream,n,view,e);
+      return View::none;
+   }
 }
 
-void Assign_class::dump_with_types(ostream& stream, int n)
-{
-   dump_line(stream,n,this);
-   stream << pad(n) << "Assign\n";
-   stream << pad(n+2) << "(left value)\n";
-   dump_Symbol(stream, n+2, lvalue);
-   stream << pad(n+2) << "(right value)\n";
-   value->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(type)\n";
-   dump_type(stream,n);
-}
-
-void Add_class::dump_with_types(ostream& stream, int n)
-{
-   dump_line(stream,n,this);
-   stream << pad(n) << "+\n";
-   stream << pad(n+2) << "(OP left)\n";
-   e1->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(OP right)\n";
-   e2->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(type)\n";
-   dump_type(stream,n);
+template <class View> template <class Op>
+typename View::Node TypeDumper<View>::visit_unary(Op e, int n, int step)
+{
+   bool typed;
+   const char *op = operator_text(view.kind(view.node(e)), typed);
+   switch (step) {
+   case 0:
+      dump_line(stream,n,view,e);
+      stream.pad(n) << op;
+      stream.pad(n+2) << "(OP)\n";
+      return view.operand(e);
+   default:
+      stream.pad(n+2) << "(type)\n";
+      if (typed)
+         dump_type(stream,n,view,e);
+      return View::none;
+   }
 }
 
-void Minus_class::dump_with_types(ostream& stream, int n)
+template <class View> template <class H>
+typename View::Node TypeDumper<View>::visit_object(H e, int n, int step)
 {
-   dump_line(stream,n,this);
-   stream << pad(n) << "-\n";
-   stream << pad(n+2) << "(OP left)\n";
-   e1->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(OP right)\n";
-   e2->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(type)\n";
-   dump_type(stream,n);
-}
-
-void Multi_class::dump_with_types(ostream& stream, int n)
-{
-   dump_line(stream,n,this);
-   stream << pad(n) << "*\n";
-   stream << pad(n+2) << "(OP left)\n";
-   e1->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(OP right)\n";
-   e2->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(type)\n";
-   dump_type(stream,n);
-}
-void Divide_class::dump_with_types(ostream& stream, int n)
-{
-   dump_line(stream,n,this);
-   stream << pad(n) << "/\n";
-   stream << pad(n+2) << "(OP left)\n";
-   e1->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(OP right)\n";
-   e2->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(type)\n";
-   dump_type(stream,n);
-}
-void Mod_class::dump_with_types(ostream& stream, int n)
-{
-   dump_line(stream,n,this);
-   stream << pad(n) << "%\n";
-   stream << pad(n+2) << "(OP left)\n";
-   e1->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(OP right)\n";
-   e2->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(type)\n";
-   dump_type(stream,n);
-}
-void Neg_class::dump_with_types(ostream& stream, int n)
-{
-   dump_line(stream,n,this);
-   stream << pad(n) << "-\n";
-   stream << pad(n+2) << "(OP)\n";
-   e1->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(type)\n";
-   dump_type(stream,n);
-}
-void Lt_class::dump_with_types(ostream& stream, int n)
-{
-   dump_line(stream,n,this);
-   stream << pad(n) << "<\n";
-   stream << pad(n+2) << "(OP left)\n";
-   e1->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(OP right)\n";
-   e2->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(type)\n";
-   dump_type(stream,n);
-}
-void Le_class::dump_with_types(ostream& stream, int n)
-{
-   dump_line(stream,n,this);
-   stream << pad(n) << "<=\n";
-   stream << pad(n+2) << "(OP left)\n";
-   e1->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(OP right)\n";
-   e2->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(type)\n";
-}
-void Equ_class::dump_with_types(ostream& stream, int n)
-{
-   dump_line(stream,n,this);
-   stream << pad(n) << "==\n";
-   stream << pad(n+2) << "(OP left)\n";
-   e1->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(OP right)\n";
-   e2->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(type)\n";
-}
-void Neq_class::dump_with_types(ostream& stream, int n)
-{
-   dump_line(stream,n,this);
-   stream << pad(n) << "!=\n";
-   stream << pad(n+2) << "(OP left)\n";
-   e1->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(OP right)\n";
-   e2->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(type)\n";
-}
-void Ge_class::dump_with_types(ostream& stream, int n)
-{
-   dump_line(stream,n,this);
-   stream << pad(n) << ">=\n";
-   stream << pad(n+2) << "(OP left)\n";
-   e1->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(OP right)\n";
-   e2->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(type)\n";
-}
-void Gt_class::dump_with_types(ostream& stream, int n)
-{
-   dump_line(stream,n,this);
-   stream << pad(n) << ">\n";
-   stream << pad(n+2) << "(OP left)\n";
-   e1->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(OP right)\n";
-   e2->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(type)\n";
-}
-void And_class::dump_with_types(ostream& stream, int n)
-{
-   dump_line(stream,n,this);
-   stream << pad(n) << "&&\n";
-   stream << pad(n+2) << "(OP left)\n";
-   e1->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(OP right)\n";
-   e2->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(type)\n";
-}
-void Or_class::dump_with_types(ostream& stream, int n)
-{
-   dump_line(stream,n,this);
-   stream << pad(n) << "||\n";
-   stream << pad(n+2) << "(OP left)\n";
-   e1->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(OP right)\n";
-   e2->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(type)\n";
-}
-void Xor_class::dump_with_types(ostream& stream, int n)
-{
-   dump_line(stream,n,this);
-   stream << pad(n) << "^\n";
-   stream << pad(n+2) << "(OP left)\n";
-   e1->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(OP right)\n";
-   e2->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(type)\n";
-}
-void Not_class::dump_with_types(ostream& stream, int n)
-{
-   dump_line(stream,n,this);
-   stream << pad(n) << "!\n";
-   stream << pad(n+2) << "(OP)\n";
-   e1->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(type)\n";
-}
-void Bitand_class::dump_with_types(ostream& stream, int n)
-{
-   dump_line(stream,n,this);
-   stream << pad(n) << "&\n";
-   stream << pad(n+2) << "(OP left)\n";
-   e1->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(OP right)\n";
-   e2->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(type)\n";
+   dump_line(stream,n,view,e);
+   stream.pad(n) << "Object\n";
+   stream.pad(n+2) << "(name)\n";
+   dump_Symbol(stream, n+2, view.name(e));
+   stream.pad(n+2) << "(type)\n";
+   dump_type(stream,n,view,e);
+   return View::none;
 }
-void Bitor_class::dump_with_types(ostream& stream, int n)
+
+template <class View> template <class H>
+typename View::Node TypeDumper<View>::visit_call(H e, int n, int step)
 {
-   dump_line(stream,n,this);
-   stream << pad(n) << "|\n";
-   stream << pad(n+2) << "(OP left)\n";
-   e1->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(OP right)\n";
-   e2->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(type)\n";
+   if (step == 0) {
+      dump_line(stream,n,view,e);
+      stream.pad(n) << "Call\n";
+      stream.pad(n+2) << "(name)\n";
+      dump_Symbol(stream, n+2, view.name(e));
+      stream.pad(n+2) << "(actual parameters)\n";
+      stream.pad(n+2) << "(\n";
+   }
+   if (step < view.actual_count(e))
+      return view.actual(e, step);
+   stream.pad(n+2) << ")\n";
+   stream.pad(n+2) << "(type)\n";
+   dump_type(stream,n,view,e);
+   return View::none;
+}
+
+template <class View> template <class H>
+typename View::Node TypeDumper<View>::visit_actual(H e, int n, int step)
+{
+   if (step == 0) {
+      dump_line(stream,n,view,e);
+      stream.pad(n) << "Actual\n";
+      stream.pad(n+2) << "(expr)\n";
+      return view.expr(e);
+   }
+   stream.pad(n+2) << "(type)\n";
+   dump_type(stream,n,view,e);
+   return View::none;
 }
 
-void Bitnot_class::dump_with_types(ostream& stream, int n)
+// a constant other than a Bool; name is what the node prints as
+template <class View> template <class Const>
+typename View::Node TypeDumper<View>::dump_const(Const e, int n, const char *name)
 {
-   dump_line(stream,n,this);
-   stream << pad(n) << "~\n";
-   stream << pad(n+2) << "(OP)\n";
-   e1->dump_with_types(stream, n+2);
-   stream << pad(n+2) << "(type)\n";
+   dump_line(stream,n,view,e);
+   stream.pad(n) << name;
+   stream.pad(n+2) << "(name)\n";
+   dump_Symbol(stream, n+2, view.constant(e));
+   stream.pad(n+2) << "(type)\n";
+   dump_type(stream,n,view,e);
+   return View::none;
 }
 
-void Object_class::dump_with_types(ostream& stream, int n)
+template <class View> template <class H>
+typename View::Node TypeDumper<View>::visit_const_int(H e, int n, int step)
 {
-   dump_line(stream,n,this);
-   stream << pad(n) << "Object\n";
-   stream << pad(n+2) << "(name)\n";
-   dump_Symbol(stream, n+2, var);
-   stream << pad(n+2) << "(type)\n";
-   dump_type(stream,n);
+   return dump_const(e, n, "Const_int\n");
 }
 
-
-void Call_class::dump_with_types(ostream& stream, int n)
+template <class View> template <class H>
+typename View::Node TypeDumper<View>::visit_const_string(H e, int n, int step)
 {
-   dump_line(stream,n,this);
-   stream << pad(n) << "Call\n";
-   stream << pad(n+2) << "(name)\n";
-   dump_Symbol(stream, n+2, name);
-   stream << pad(n+2) << "(actual parameters)\n";
-   stream << pad(n+2) << "(\n";
-   for(int i = actuals->first(); actuals->more(i); i = actuals->next(i))
-     actuals->nth(i)->dump_with_types(stream, n+2);
-   stream << pad(n+2) << ")\n";
-   stream << pad(n+2) << "(type)\n";
-   dump_type(stream,n);
+   return dump_const(e, n, "Const_string\n");
 }
 
-void Actual_class::dump_with_types(ostream& stream, int n)
+template <class View> template <class H>
+typename View::Node TypeDumper<View>::visit_const_float(H e, int n, int step)
 {
-   dump_line(stream,n,this);
-   stream << pad(n) << "Actual\n";
-   stream << pad(n+2) << "(expr)\n";
-   expr->dump_with_types(stream,n+2);
-   stream << pad(n+2) << "(type)\n";
-   dump_type(stream,n);
+   return dump_const(e, n, "Const_float\n");
 }
 
-void Const_int_class::dump_with_types(ostream& stream, int n)
+template <class View> template <class H>
+typename View::Node TypeDumper<View>::visit_const_bool(H e, int n, int step)
 {
-   dump_line(stream,n,this);
-   stream << pad(n) << "Const_int\n";
-   stream << pad(n+2) << "(name)\n";
-   dump_Symbol(stream, n+2, value);
-   stream << pad(n+2) << "(type)\n";
-   dump_type(stream,n);
+   dump_line(stream,n,view,e);
+   stream.pad(n) << "Const_bool\n";
+   stream.pad(n+2) << "(name)\n";
+   dump_Boolean(stream, n+2, view.bool_value(e));
+   stream.pad(n+2) << "(type)\n";
+   dump_type(stream,n,view,e);
+   return View::none;
 }
 
-void Const_string_class::dump_with_types(ostream& stream, int n)
+template <class View> template <class H>
+typename View::Node TypeDumper<View>::visit_no_expr(H e, int n, int step)
 {
-   dump_line(stream,n,this);
-   stream << pad(n) << "Const_string\n";
-   stream << pad(n+2) << "(name)\n";
-   dump_Symbol(stream, n+2, value);
-   stream << pad(n+2) << "(type)\n";
-   dump_type(stream,n);
+   dump_line(stream,n,view,e);
+   stream.pad(n) << "No_expr\n";
+   return View::none;
 }
 
-void Const_float_class::dump_with_types(ostream& stream, int n)
-{
-   dump_line(stream,n,this);
-   stream << pad(n) << "Const_float\n";
-   stream << pad(n+2) << "(name)\n";
-   dump_Symbol(stream, n+2, value);
-   stream << pad(n+2) << "(type)\n";
-   dump_type(stream,n);
+
+//
+//  dump_with_types walks the tree with a work stack on the heap instead
+//  of by recursion, so the depth of the C++ stack does not depend on
+//  how deeply the program nests.  Each frame is a node, its indentation
+//  and the number of its children already printed.  Visiting the node
+//  with that step prints whatever comes before its next child and
+//  returns that child, which is printed, two columns further in, before
+//  the node takes its next step.
+//
+template <class View>
+struct DumpFrame {
+   typename View::Node node;
+   int n;
+   int step;
+};
+
+template <class View>
+static void dump_with_types(AstDumpWriter& stream, int n, View view, typename View::Node root)
+{
+   TypeDumper<View> dumper(stream, view);
+   std::vector<DumpFrame<View> > work;
+   DumpFrame<View> frame = { root, n, 0 };
+   work.push_back(frame);
+   while (!work.empty()) {
+      DumpFrame<View> &f = work.back();
+      typename View::Node next = dumper.visit(f.node, f.n, f.step++);
+      if (next == View::none) {
+         work.pop_back();
+      } else {
+         DumpFrame<View> child = { next, f.n + 2, 0 };
+         work.push_back(child);
+      }
+   }
 }
 
-void Const_bool_class::dump_with_types(ostream& stream, int n)
+void tree_node::dump_with_types(AstDumpWriter& stream, int n)
 {
-   dump_line(stream,n,this);
-   stream << pad(n) << "Const_bool\n";
-   stream << pad(n+2) << "(name)\n";
-   dump_Boolean(stream, n+2, value);
-   stream << pad(n+2) << "(type)\n";
-   dump_type(stream,n);
+   ::dump_with_types(stream, n, TreeView(), this);
 }
 
-void No_expr_class::dump_with_types(ostream& stream, int n)
+void FlatAst::dump_with_types(AstDumpWriter& stream, int n)
 {
-   dump_line(stream,n,this);
-   stream << pad(n) << "No_expr\n";
-}
\ No newline at end of file
+   FlatView view(this);
+   ::dump_with_types(stream, n, view, view.node(view.program()));
+}
@@ -0,0 +1,73 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+#ifndef _DUMPWRITER_H_
+#define _DUMPWRITER_H_
+
+///////////////////////////////////////////////////////////////////////////
+//
+// file: dumpwriter.h
+//
+// AstDumpWriter is the output sink of dump_with_types.  Text is
+// appended to a large owned buffer, which is handed to the underlying
+// ostream in a single write() when it fills up and when flush() is
+// called.  Nothing is flushed per line.
+//
+// Indentation comes from a precomputed run of spaces.  Like pad() in
+// utilities.cc, indentation is capped at 80 columns, so the output is
+// byte-identical to the old ostream-based dump.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include "seal-io.h"
+#include "stringtab.h"
+
+class AstDumpWriter {
+private:
+    enum { MAX_PAD = 80 };
+    static const char spaces[MAX_PAD + 1];
+
+    ostream& out;
+    char *buf;
+    size_t cap;                 // size of buf
+    size_t len;                 // bytes of buf in use
+public:
+    AstDumpWriter(ostream& s, size_t size = 1 << 20);
+    ~AstDumpWriter();
+
+    // append n bytes of s, writing out the buffer first if it is full
+    void write(const char *s, size_t n)
+    {
+	if (len + n > cap) {
+	    flush();
+	    if (n > cap) {
+		out.write(s, n);
+		return;
+	    }
+	}
+	memcpy(buf + len, s, n);
+	len += n;
+    }
+
+    // hand everything buffered so far to the ostream
+    void flush();
+
+    // indent by n spaces
+    AstDumpWriter& pad(int n)
+    {
+	if (n > MAX_PAD) n = MAX_PAD;
+	if (n > 0) write(spaces, n);
+	return *this;
+    }
+
+    AstDumpWriter& operator<<(const char *s) { write(s, strlen(s)); return *this; }
+    AstDumpWriter& operator<<(Symbol sym)
+	{ write(sym->get_string(), sym->get_len()); return *this; }
+    AstDumpWriter& operator<<(int i);
+};
+
+#endif
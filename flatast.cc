@@ -0,0 +1,278 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+//
+// Building the flat copy of the AST; see flatast.h.  It is checked and
+// dumped by the code of semant.cc and dumptype.cc that checks and dumps
+// the pointer AST.
+//
+
+#include "flatast.h"
+#include "seal-decl.h"
+#include "seal-stmt.h"
+#include "seal-expr.h"
+#include "visitor.h"
+
+//
+// Flattener is the pass that fills in node self of a FlatAst from a
+// tree node (see visitor.h): the kind and value of self, then a new
+// node for each child, in order.  The children are filled in later, by
+// build, so every handler returns NULL.
+//
+class Flattener : public AstVisitor<Flattener, TreeView> {
+    FlatAst& ast;
+public:
+    Flattener(FlatAst& a) : AstVisitor(TreeView()), ast(a) { }
+
+    tree_node *visit_program(Program p, unsigned self)
+    {
+	ast.set(self, NODE_PROGRAM);
+	for (Decl d : *p->get_decls())
+	    ast.add_child(self, d);
+	return NULL;
+    }
+
+    tree_node *visit_variable_decl(VariableDecl d, unsigned self)
+    {
+	ast.set(self, NODE_VARIABLE_DECL);
+	ast.add_child(self, d->getVariable());
+	return NULL;
+    }
+
+    tree_node *visit_variable(Variable v, unsigned self)
+    {
+	ast.set(self, NODE_VARIABLE, v->getName()->get_index(),
+		v->getType()->get_index());
+	return NULL;
+    }
+
+    tree_node *visit_call_decl(CallDecl c, unsigned self)
+    {
+	ast.set(self, NODE_CALL_DECL, c->getName()->get_index(),
+		c->getType()->get_index());
+	for (Variable v : *c->getVariables())
+	    ast.add_child(self, v);
+	ast.add_child(self, c->getBody());
+	return NULL;
+    }
+
+    tree_node *visit_stmt_block(StmtBlock s, unsigned self)
+    {
+	ast.set(self, NODE_STMT_BLOCK, s->getVariableDecls()->len());
+	for (VariableDecl v : *s->getVariableDecls())
+	    ast.add_child(self, v);
+	for (Stmt t : *s->getStmts())
+	    ast.add_child(self, t);
+	return NULL;
+    }
+
+    tree_node *visit_if(IfStmt s, unsigned self)
+    {
+	ast.set(self, NODE_IF);
+	ast.add_child(self, s->getCondition());
+	ast.add_child(self, s->getThen());
+	ast.add_child(self, s->getElse());
+	return NULL;
+    }
+
+    tree_node *visit_while(WhileStmt s, unsigned self)
+    {
+	ast.set(self, NODE_WHILE);
+	ast.add_child(self, s->getCondition());
+	ast.add_child(self, s->getBody());
+	return NULL;
+    }
+
+    tree_node *visit_for(ForStmt s, unsigned self)
+    {
+	ast.set(self, NODE_FOR);
+	ast.add_child(self, s->getInit());
+	ast.add_child(self, s->getCondition());
+	ast.add_child(self, s->getLoop());
+	ast.add_child(self, s->getBody());
+	return NULL;
+    }
+
+    tree_node *visit_return(ReturnStmt s, unsigned self)
+    {
+	ast.set(self, NODE_RETURN);
+	ast.add_child(self, s->getValue());
+	return NULL;
+    }
+
+    tree_node *visit_continue(ContinueStmt s, unsigned self)
+    {
+	ast.set(self, NODE_CONTINUE);
+	return NULL;
+    }
+
+    tree_node *visit_break(BreakStmt s, unsigned self)
+    {
+	ast.set(self, NODE_BREAK);
+	return NULL;
+    }
+
+    tree_node *visit_call(Call e, unsigned self)
+    {
+	ast.set(self, NODE_CALL, e->getName()->get_index());
+	for (Actual a : *e->getActuals())
+	    ast.add_child(self, a);
+	return NULL;
+    }
+
+    tree_node *visit_actual(Actual e, unsigned self)
+    {
+	ast.set(self, NODE_ACTUAL);
+	ast.add_child(self, e->getExpr());
+	return NULL;
+    }
+
+    tree_node *visit_assign(Assign_class *e, unsigned self)
+    {
+	ast.set(self, NODE_ASSIGN, e->getLvalue()->get_index());
+	ast.add_child(self, e->getValue());
+	return NULL;
+    }
+
+    // an operator: its kind, then its operands
+    template <class Op>
+    tree_node *visit_binary(Op *e, unsigned self)
+    {
+	ast.set(self, e->get_kind());
+	ast.add_child(self, e->getLeft());
+	ast.add_child(self, e->getRight());
+	return NULL;
+    }
+
+    template <class Op>
+    tree_node *visit_unary(Op *e, unsigned self)
+    {
+	ast.set(self, e->get_kind());
+	ast.add_child(self, e->getOperand());
+	return NULL;
+    }
+
+    // a constant other than a Bool: the index of its entry
+    template <class Const>
+    tree_node *flatten_const(Const *e, NodeKind kind, unsigned self)
+    {
+	ast.set(self, kind, e->getSymbol()->get_index());
+	return NULL;
+    }
+
+    tree_node *visit_const_int(Const_int_class *e, unsigned self)
+	{ return flatten_const(e, NODE_CONST_INT, self); }
+    tree_node *visit_const_string(Const_string_class *e, unsigned self)
+	{ return flatten_const(e, NODE_CONST_STRING, self); }
+    tree_node *visit_const_float(Const_float_class *e, unsigned self)
+	{ return flatten_const(e, NODE_CONST_FLOAT, self); }
+
+    tree_node *visit_const_bool(Const_bool_class *e, unsigned self)
+    {
+	ast.set(self, NODE_CONST_BOOL, e->getValue() ? 1 : 0);
+	return NULL;
+    }
+
+    tree_node *visit_object(Object e, unsigned self)
+    {
+	ast.set(self, NODE_OBJECT, e->getName()->get_index());
+	return NULL;
+    }
+
+    tree_node *visit_no_expr(No_expr_class *e, unsigned self)
+    {
+	ast.set(self, NODE_NO_EXPR);
+	return NULL;
+    }
+};
+
+//
+// A node's children are numbered when the node is flattened, so they
+// are consecutive.  The nodes are flattened depth first, though, as
+// the checker and the dump visit them, so that a subtree's nodes end
+// up near one another.  pending holds the nodes numbered but not yet
+// flattened, the next one last; sources the children of the node being
+// flattened.
+//
+struct FlatPending {
+    FlatNode node;
+    tree_node *tree;
+};
+
+void FlatAst::build(tree_node *root, size_t nodes)
+{
+    kinds.clear();
+    locs.clear();
+    values.clear();
+    firsts.clear();
+    counts.clear();
+    types.clear();
+    binds.clear();
+    slots.clear();
+    kinds.reserve(nodes);
+    locs.reserve(nodes);
+    values.reserve(nodes);
+    firsts.reserve(nodes);
+    counts.reserve(nodes);
+    types.reserve(nodes);
+    binds.reserve(nodes);
+    slots.reserve(nodes);
+
+    Flattener flattener(*this);
+    std::vector<FlatPending> pending;
+    sources.clear();
+    sources.push_back(root);
+    push_node(root);
+    FlatPending top = { 0, root };
+    pending.push_back(top);
+    while (!pending.empty()) {
+	FlatPending p = pending.back();
+	pending.pop_back();
+	sources.clear();
+	firsts[p.node] = size();
+	flattener.visit(p.tree, p.node);
+	for (size_t i = sources.size(); i-- > 0; ) {
+	    FlatPending child = { firsts[p.node] + (FlatNode) i, sources[i] };
+	    pending.push_back(child);
+	}
+    }
+    sources = std::vector<tree_node *>();
+}
+
+void FlatAst::push_node(tree_node *t)
+{
+    kinds.push_back(NODE_NO_EXPR);
+    locs.push_back(t->get_location());
+    values.push_back(0);
+    firsts.push_back(0);
+    counts.push_back(0);
+    types.push_back(FLAT_NONE);
+    binds.push_back(FLAT_NONE);
+    slots.push_back(-1);
+}
+
+void FlatAst::add_child(FlatNode self, tree_node *t)
+{
+    push_node(t);
+    sources.push_back(t);
+    counts[self]++;
+}
+
+size_t FlatAst::bytes_used() const
+{
+    return size() * (sizeof(unsigned char) + sizeof(SourceLoc) +
+		     5 * sizeof(unsigned) + sizeof(int));
+}
+
+size_t FlatAst::bytes_reserved() const
+{
+    return kinds.capacity() * sizeof(unsigned char) +
+	   locs.capacity() * sizeof(SourceLoc) +
+	   (values.capacity() + firsts.capacity() + counts.capacity() +
+	    types.capacity() + binds.capacity()) * sizeof(unsigned) +
+	   slots.capacity() * sizeof(int);
+}
+
@@ -0,0 +1,131 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+#ifndef _FLATAST_H_
+#define _FLATAST_H_
+
+///////////////////////////////////////////////////////////////////////////
+//
+// file: flatast.h
+//
+// A flat copy of the AST, selected with -A.  Instead of a graph of
+// objects with vtables, the tree is a handful of parallel arrays
+// indexed by a 32-bit node number: for each node, its kind (the
+// NodeKind of tree.h that the pointer AST node has), its location, one
+// 32-bit value whose meaning depends on the kind, and the range of its
+// children.  The children of a node are numbered consecutively, so its
+// child i is simply first + i.  The lists of the pointer AST (Decls,
+// Stmts, Actuals ...) have no nodes of their own; their elements are
+// children of the node that owns the list.
+//
+// Symbols are kept as their index in the table they were interned in:
+// idtable for names and types, inttable, stringtable and, for the
+// spelling of a float, floatspellings for constants.  The type column
+// holds the idtable index of a type, or FLAT_NONE: the declared type of
+// a Variable and the return type of a CallDecl when the copy is built,
+// the type of an expression once it has been checked.
+//
+//   kind          value                   children
+//   PROGRAM       -                       the declarations
+//   VARIABLE_DECL -                       its Variable
+//   VARIABLE      name                    -
+//   CALL_DECL     name                    the parameters, then the body
+//   STMT_BLOCK    number of variables     the VariableDecls, then the
+//                                         statements
+//   IF            -                       condition, then, else
+//   WHILE         -                       condition, body
+//   FOR           -                       init, condition, loop, body
+//   RETURN        -                       the value
+//   CALL          name                    the Actuals
+//   ACTUAL        -                       the expression
+//   ASSIGN        name of the lvalue      the value
+//   binary op     -                       left, right
+//   unary op      -                       the operand
+//   CONST_*       table index; for BOOL   -
+//                 the value
+//   OBJECT        name                    -
+//
+// The binding column is filled in by the checker's name binding: the
+// CALL_DECL a CALL calls, the VARIABLE an OBJECT or an ASSIGN names,
+// and the VARIABLE of the same scope a VARIABLE fails to redeclare, or
+// FLAT_NONE.  The slot column holds the frame slot of a VARIABLE and
+// the frame size of a CALL_DECL (see -F), or -1 until the checker
+// assigns them.  These three are all that change once the copy is
+// built.  The checker and the dump are the ones of the pointer AST,
+// reading the arrays through the FlatView of astview.h.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+#include "tree.h"
+
+typedef unsigned FlatNode;
+const unsigned FLAT_NONE = ~0u;
+
+class FlatAst {
+private:
+    std::vector<unsigned char> kinds;
+    std::vector<SourceLoc> locs;
+    std::vector<unsigned> values;
+    std::vector<unsigned> firsts;       // first child
+    std::vector<unsigned> counts;       // number of children
+    std::vector<unsigned> types;
+    std::vector<unsigned> binds;        // what binding found
+    std::vector<int> slots;             // frame slot, or frame size
+
+    std::vector<tree_node *> sources;   // while building
+
+    void push_node(tree_node *t);
+public:
+    // Copy the tree rooted at root, which becomes node 0.  The arrays
+    // are sized for nodes nodes up front; the tree may have fewer.
+    void build(tree_node *root, size_t nodes);
+
+    // Called by the flatten method of each tree node, which fills in
+    // node self: add the next child of self, made from t, and set the
+    // kind, value and type of self.
+    void add_child(FlatNode self, tree_node *t);
+    void set(FlatNode self, NodeKind kind, unsigned value = 0,
+             unsigned type = FLAT_NONE)
+    {
+	kinds[self] = kind;
+	values[self] = value;
+	types[self] = type;
+    }
+
+    size_t size() const                  { return kinds.size(); }
+    NodeKind kind(FlatNode n) const      { return (NodeKind) kinds[n]; }
+    SourceLoc location(FlatNode n) const { return locs[n]; }
+    int line_number(FlatNode n) const    { return source_manager.line(locs[n]); }
+    unsigned value(FlatNode n) const     { return values[n]; }
+    unsigned children(FlatNode n) const  { return counts[n]; }
+    FlatNode child(FlatNode n, unsigned i) const { return firsts[n] + i; }
+
+    // the name a VARIABLE, CALL_DECL, CALL, ASSIGN or OBJECT holds
+    Symbol name(FlatNode n) const        { return idtable.lookup(values[n]); }
+    // the type of n, or NULL if it has none
+    Symbol type(FlatNode n) const
+	{ return types[n] == FLAT_NONE ? NULL : idtable.lookup(types[n]); }
+    void set_type(FlatNode n, Symbol t)  { types[n] = t->get_index(); }
+    // the node binding found for n, or FLAT_NONE
+    FlatNode bound(FlatNode n) const     { return binds[n]; }
+    void bind(FlatNode n, FlatNode to)   { binds[n] = to; }
+    // the frame slot of a VARIABLE or the frame size of a CALL_DECL
+    int slot(FlatNode n) const           { return slots[n]; }
+    void set_slot(FlatNode n, int s)     { slots[n] = s; }
+
+    // bytes the nodes take up, and bytes the arrays hold
+    size_t bytes_used() const;
+    size_t bytes_reserved() const;
+
+    // check the program, with the checker of Program_class::semant;
+    // returns the number of semantic errors
+    int semant();
+    // print the program, with the dump of dump_with_types
+    void dump_with_types(AstDumpWriter& stream, int n);
+};
+
+#endif
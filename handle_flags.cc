@@ -6,9 +6,11 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "seal-io.h"
 #include <unistd.h>
 #include "cgen_gc.h"
+#include "stats.h"
 
 //
 // sealc provides a debugging switch for each phase of the compiler,
@@ -27,6 +29,16 @@ extern int seal_yydebug;        // for the parser
        int lex_verbose;         // also for the lexer; prints tokens
        int semant_debug;        // for semantic analysis
        int cgen_debug;          // for code gen
+       int mem_stats;           // report string table memory usage
+       int batch_mode;          // compile many files in one process
+       int num_jobs;            // threads for a batch, or for one parse
+       int stats_mode;          // print phase times and counters
+       int mmap_input;          // scan input files in place
+       int hand_lexer;          // use the hand-written scanner
+       int pipeline_lexer;      // lex on a thread of its own
+       int descent_parser;      // parse with the hand-written parser
+       int dump_slots;          // print frame slots in the AST dump
+       int flat_ast;            // check and dump a flat copy of the AST
        bool disable_reg_alloc;  // Don't do register allocation
 
        int cgen_optimize;       // optimize switch for code generator 
@@ -51,9 +63,19 @@ void handle_flags(int argc, char *argv[]) {
   cgen_debug = 0;
   cgen_optimize = 0;
   disable_reg_alloc = 0;
+  mem_stats = 0;
+  batch_mode = 0;
+  num_jobs = 1;
+  stats_mode = 0;
+  mmap_input = 0;
+  hand_lexer = 0;
+  pipeline_lexer = 0;
+  descent_parser = 0;
+  dump_slots = 0;
+  flat_ast = 0;
   
 
-  while ((c = getopt(argc, argv, "lpscvrOo:gtT")) != -1) {
+  while ((c = getopt(argc, argv, "lpscvrOo:gtTMbmLPRFAj:X:")) != -1) {
     switch (c) {
 #ifdef DEBUG
     case 'l':
@@ -99,6 +121,43 @@ void handle_flags(int argc, char *argv[]) {
     case 'O':  // enable optimization
       cgen_optimize = 1;
       break;
+    case 'M':  // print memory held by the string tables and the AST
+      mem_stats = 1;
+      break;
+    case 'b':  // batch mode: each input file is compiled to <file>.out
+      batch_mode = 1;
+      break;
+    case 'm':  // map input files into memory instead of reading them
+      mmap_input = 1;
+      break;
+    case 'L':  // scan with seal-scan.cc instead of the flex scanner
+      hand_lexer = 1;
+      break;
+    case 'P':  // run the lexer on its own thread, ahead of the parser
+      pipeline_lexer = 1;
+      break;
+    case 'R':  // parse with seal-descent.cc instead of the bison parser
+      descent_parser = 1;
+      break;
+    case 'F':  // show the frame slot of each variable in the dump
+      dump_slots = 1;
+      break;
+    case 'A':  // check and dump the flat AST of flatast.h instead
+      flat_ast = 1;
+      break;
+    case 'j':  // files compiled at once in batch mode, else parse threads
+      num_jobs = atoi(optarg);
+      if (num_jobs < 1)
+        unknownopt = 1;
+      break;
+    case 'X':  // phase times and counters, as a table or as JSON
+      if (strcmp(optarg, "table") == 0)
+        stats_mode = STATS_TABLE;
+      else if (strcmp(optarg, "json") == 0)
+        stats_mode = STATS_JSON;
+      else
+        unknownopt = 1;
+      break;
     case '?':
       unknownopt = 1;
       break;
@@ -111,9 +170,9 @@ void handle_flags(int argc, char *argv[]) {
   if (unknownopt) {
       cerr << "usage: " << argv[0] << 
 #ifdef DEBUG
-	  " [-lvpscOgtTr -o outname] [input-files]\n";
+	  " [-lvpscOgtTrMbmLPRFA -j jobs -X table|json -o outname] [input-files]\n";
 #else
-      " [-OgtT -o outname] [input-files]\n";
+      " [-OgtTMbmLPRFA -j jobs -X table|json -o outname] [input-files]\n";
 #endif
       exit(1);
   }
@@ -1,15 +1,45 @@
 #!/bin/bash
 
 cd test
-for filename in *.seal; do
-    echo "--------Test using" $filename "--------"
-    ../semant $filename > tempfile
-    diff tempfile ../test-answer/$filename.out > /dev/null
+
+# compare the output in $1 with the answer for $filename, or with the
+# answer $filename$2.out for a flag that changes the output
+judge() {
+    diff $1 ../test-answer/$filename$2.out > /dev/null
     if [ $? -eq 0 ]; then
         echo "Passed"
     else
         echo NOT passed
     fi
+}
+
+# every test is run seven ways: as is, with the hand-written scanner
+# (-L), with the lexer on its own thread (-P), parsed in pieces (-j 3),
+# with the hand-written parser (-R), checked on the flat AST (-A) and
+# read through mmap (-m)
+for flags in "" "-L" "-P" "-j 3" "-R" "-A" "-m"; do
+for filename in *.seal; do
+    echo "--------Test using" $filename $flags "--------"
+    ../semant $flags $filename > tempfile
+    judge tempfile
+done
+done
+
+# -F adds the frame slots to the dump, so it has answers of its own
+for flags in "-F" "-F -R" "-F -A"; do
+for filename in *.seal; do
+    echo "--------Test using" $filename $flags "--------"
+    ../semant $flags $filename > tempfile
+    judge tempfile .F
+done
+done
+
+# and all together as one batch (-b) on three threads, which writes
+# the output for each file to <file>.out
+../semant -b -j 3 *.seal 2> /dev/null
+for filename in *.seal; do
+    echo "--------Test using" $filename "-b -j 3 --------"
+    judge $filename.out
 done
-rm -f tempfile
+rm -f tempfile *.seal.out
 cd ..
@@ -0,0 +1,63 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+#ifndef _NODEKIND_H_
+#define _NODEKIND_H_
+
+/////////////////////////////////////////////////////////////////////
+//
+//  NodeKind
+//
+//   Which class a node is.  Each node stores its kind, so a pass can
+//   pick the code for a node with a switch (see visitor.h) rather than
+//   a virtual call.  A FlatAst (flatast.h) uses the same kinds.
+//
+/////////////////////////////////////////////////////////////////////
+enum NodeKind {
+    NODE_PROGRAM,
+    NODE_VARIABLE_DECL,
+    NODE_VARIABLE,
+    NODE_CALL_DECL,
+    NODE_STMT_BLOCK,
+    NODE_IF,
+    NODE_WHILE,
+    NODE_FOR,
+    NODE_RETURN,
+    NODE_CONTINUE,
+    NODE_BREAK,
+    NODE_CALL,
+    NODE_ACTUAL,
+    NODE_ASSIGN,
+    NODE_ADD,
+    NODE_MINUS,
+    NODE_MULTI,
+    NODE_DIVIDE,
+    NODE_MOD,
+    NODE_NEG,
+    NODE_LT,
+    NODE_LE,
+    NODE_EQU,
+    NODE_NEQ,
+    NODE_GE,
+    NODE_GT,
+    NODE_AND,
+    NODE_OR,
+    NODE_XOR,
+    NODE_NOT,
+    NODE_BITAND,
+    NODE_BITOR,
+    NODE_BITNOT,
+    NODE_CONST_INT,
+    NODE_CONST_STRING,
+    NODE_CONST_FLOAT,
+    NODE_CONST_BOOL,
+    NODE_OBJECT,
+    NODE_NO_EXPR,
+    NODE_LIST,                  // a list_node; never visited
+    NODE_KIND_COUNT
+};
+
+#endif
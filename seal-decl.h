@@ -11,12 +11,10 @@ class Decl_class : public tree_node {
 public:
     tree_node *copy()		 { return copy_Decl(); }
     virtual Decl copy_Decl() = 0;
-    virtual void dump_with_types(ostream&,int) = 0; 
     virtual void dump(ostream&,int) = 0;
     virtual bool isCallDecl() = 0;
     virtual Symbol getName() = 0;
     virtual Symbol getType() = 0;
-    virtual void check() = 0;
     //added by wangzifan
     virtual Variables getVariables() = 0;
 };
@@ -26,18 +24,30 @@ class Variable_class : public tree_node {
 protected:
    Symbol name;
    Symbol type;
+   Variable prior;             // set by binding; see semant.cc
+   int slot;                   // set after checking; see semant.cc
 public:
    Variable_class(Symbol a1, Symbol a2) {
       name = a1;
       type = a2;
+      prior = NULL;
+      slot = -1;
+      set_kind(NODE_VARIABLE);
    }
    tree_node *copy()		 { return copy_Variable(); }
    Symbol getName() { return name; }
    Symbol getType() { return type; }
+   // the declaration of the same name earlier in the same scope, which
+   // this one fails to redeclare, or NULL
+   Variable getPrior() { return prior; }
+   void setPrior(Variable v) { prior = v; }
+   // the variable's place in the frame of its function, or -1 for a
+   // global
+   int getSlot() { return slot; }
+   void setSlot(int s) { slot = s; }
 
    Variable copy_Variable();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int);
 };
 
 class VariableDecl_class : public Decl_class {
@@ -46,14 +56,14 @@ protected:
 public:
    VariableDecl_class(Variable a1) {
       variable = a1;
+      set_kind(NODE_VARIABLE_DECL);
    }
    Symbol getName() { return variable->getName(); }
    Symbol getType() { return variable->getType(); }
+   Variable getVariable() { return variable; }
 
    Decl copy_Decl();
-   void check();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int);
    bool isCallDecl(){return false;};
    //added by wangzifan
    Variables getVariables() {}
@@ -65,6 +75,7 @@ protected:
     Variables paras;
     Symbol   returnType;
     StmtBlock body;
+    int frameSize;             // set after checking; see semant.cc
     
 public:
    CallDecl_class(Symbol a1, Variables a2, Symbol a3, StmtBlock a4) {
@@ -72,6 +83,8 @@ public:
       paras = a2;
       returnType = a3;
       body = a4;
+      frameSize = 0;
+      set_kind(NODE_CALL_DECL);
    }
 
    Symbol getName(){return name;}
@@ -79,11 +92,12 @@ public:
    Variables getVariables(){return paras;}
    StmtBlock getBody(){return body;}
    CallDecl getCallDecl() {return this;}
+   // the number of slots the parameters and locals need
+   int getFrameSize() {return frameSize;}
+   void setFrameSize(int n) {frameSize = n;}
 
    Decl copy_Decl();
-   void check();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int);  
    bool isCallDecl(){return true;}
 };
 
@@ -0,0 +1,527 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+///////////////////////////////////////////////////////////////////////////
+//
+// file: seal-descent.cc
+//
+// A hand-written parser for SEAL, selected with -R.  Statements and
+// declarations are parsed by recursive descent, expressions by
+// precedence climbing over the precedence declarations of seal.y, so
+// no LALR tables are interpreted.  It reads the same scanner_lex()
+// tokens and builds the same AST as seal-parse.cc: the same node
+// constructors, called in the same pattern, with node_loc set to the
+// location of the first token of the rule bison would reduce.  Nodes
+// are carved out of ast_arena like those of the bison parser.
+//
+// Only a program that parses cleanly is handled here.  At the first
+// token that does not fit -- a syntax error, a lexical error (which is
+// not reported here), or nesting deeper than the thread's stack has
+// room for -- the attempt is abandoned: the lookahead is set to the end
+// of input, so every loop below runs out, and the caller parses the
+// input again with bison, which reports the errors exactly as before
+// and takes nesting of any depth.  The nodes of an abandoned attempt
+// stay in ast_arena until the compilation is released.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <pthread.h>
+#include "seal-lex.h"
+#include "seal-parse.h"
+#include "seal-stmt.h"
+#include "seal-expr.h"
+#include "stats.h"
+
+extern thread_local SourceLoc node_loc;
+extern thread_local YYSTYPE seal_yylval;
+
+// Stack left free below the deepest parse_expr or parse_block, for the
+// calls they make that do not nest (the scanner, the node constructors),
+// and the stack assumed if the thread's cannot be found.
+#define STACK_RESERVE (64 * 1024)
+#define STACK_DEFAULT (256 * 1024)
+
+struct Descent {
+    int token;                  // the lookahead; 0 at the end of input
+    YYSTYPE value;              // its semantic value
+    SourceLoc loc;              // its location
+    char *stack_floor;          // nesting that reaches it is left to bison
+    bool failed;
+};
+
+//
+// The lowest address the parse may take the stack to: STACK_RESERVE
+// above the end of the calling thread's stack.  For the main thread
+// that end follows from the stack limit (ulimit -s), so the parse gives
+// up to bison, whose stack is on the heap, before it can overflow.
+//
+static char *stack_floor()
+{
+    char here;
+    char *end = &here - STACK_DEFAULT;
+    pthread_attr_t attr;
+    if (pthread_getattr_np(pthread_self(), &attr) == 0) {
+        void *addr;
+        size_t size;
+        if (pthread_attr_getstack(&attr, &addr, &size) == 0)
+            end = (char *) addr;
+        pthread_attr_destroy(&attr);
+    }
+    return end + STACK_RESERVE;
+}
+
+// true if nesting one level deeper could run out of stack
+static inline bool too_deep(Descent *d)
+{
+    char here;
+    return &here < d->stack_floor;
+}
+
+//
+// Binary operators, from the precedence declarations in seal.y, lowest
+// first.  '=' (1) and the unary operators (8) are handled apart; '~'
+// takes its operand at the precedence of '.' (10), which no binary
+// operator has.
+//
+enum Assoc { NONE, LEFT, RIGHT };
+enum {
+    PREC_OR = 2,
+    PREC_UNARY = 8,
+    PREC_DOT = 10,
+    TOKEN_COUNT = 288
+};
+
+static signed char binary_prec[TOKEN_COUNT];  // 0 if not a binary operator
+static signed char binary_assoc[TOKEN_COUNT];
+
+static void set_binary(int token, int prec, Assoc assoc)
+{
+    binary_prec[token] = prec;
+    binary_assoc[token] = assoc;
+}
+
+static int init_binary()
+{
+    set_binary(OR, 2, RIGHT);
+    set_binary(AND, 3, RIGHT);
+    set_binary(EQUAL, 4, NONE);
+    set_binary(NE, 4, NONE);
+    set_binary('<', 5, NONE);
+    set_binary('>', 5, NONE);
+    set_binary(LE, 5, NONE);
+    set_binary(GE, 5, NONE);
+    set_binary('+', 6, LEFT);
+    set_binary('-', 6, LEFT);
+    set_binary('*', 7, LEFT);
+    set_binary('/', 7, LEFT);
+    set_binary('%', 7, LEFT);
+    set_binary('&', 9, LEFT);
+    set_binary('|', 9, LEFT);
+    set_binary('^', 9, LEFT);
+    return 0;
+}
+
+static int binary_ready = init_binary();
+
+static inline int prec_of(int token)
+{
+    return token > 0 && token < TOKEN_COUNT ? binary_prec[token] : 0;
+}
+
+// read the next token into the lookahead
+static inline void advance(Descent *d)
+{
+    if (d->failed)
+        return;
+    d->token = scanner_lex();
+    d->value = seal_yylval;
+    d->loc = curr_loc;
+    stats_token();
+    if (d->token < 0) {
+        d->failed = true;
+        d->token = 0;
+    }
+}
+
+// give up; see the top of the file
+static void fail(Descent *d)
+{
+    d->failed = true;
+    d->token = 0;
+}
+
+static inline void expect(Descent *d, int token)
+{
+    if (d->token == token)
+        advance(d);
+    else
+        fail(d);
+}
+
+static inline Symbol expect_symbol(Descent *d, int token)
+{
+    Symbol s = d->value.symbol;
+    expect(d, token);
+    return s;
+}
+
+static Expr parse_expr(Descent *d, int min_prec);
+static StmtBlock parse_block(Descent *d);
+
+// actual_list: empty, or actuals separated by ',', the first of which
+// may be missing
+static Actuals parse_actuals(Descent *d)
+{
+    Actuals actuals;
+    if (d->token == ',' || d->token == ')') {
+        actuals = nil_Actuals();
+    } else {
+        SourceLoc loc = d->loc;
+        Expr e = parse_expr(d, 1);
+        node_loc = loc;
+        actuals = single_Actuals(actual(e));
+    }
+    while (d->token == ',') {
+        advance(d);
+        SourceLoc loc = d->loc;
+        Expr e = parse_expr(d, 1);
+        node_loc = loc;
+        actuals = append_Actuals(actuals, single_Actuals(actual(e)));
+    }
+    return actuals;
+}
+
+// an expression that is not a binary operation
+static Expr parse_operand(Descent *d)
+{
+    SourceLoc loc = d->loc;
+    Expr e;
+    switch (d->token) {
+    case CONST_INT:
+        node_loc = loc;
+        e = const_int(d->value.symbol);
+        advance(d);
+        return e;
+    case CONST_STRING:
+        node_loc = loc;
+        e = const_string(d->value.symbol);
+        advance(d);
+        return e;
+    case CONST_FLOAT:
+        node_loc = loc;
+        e = const_float(d->value.symbol);
+        advance(d);
+        return e;
+    case CONST_BOOL:
+        node_loc = loc;
+        e = const_bool(d->value.boolean);
+        advance(d);
+        return e;
+    case OBJECTID: {
+        Symbol name = d->value.symbol;
+        advance(d);
+        if (d->token == '=') {
+            // the right side takes every operator that follows
+            advance(d);
+            e = parse_expr(d, 1);
+            node_loc = loc;
+            return assign(name, e);
+        }
+        if (d->token == '(') {
+            advance(d);
+            Actuals actuals = parse_actuals(d);
+            expect(d, ')');
+            node_loc = loc;
+            return call(name, actuals);
+        }
+        node_loc = loc;
+        return object(name);
+    }
+    case '(':
+        advance(d);
+        e = parse_expr(d, 1);
+        expect(d, ')');
+        return e;
+    case '-':
+        advance(d);
+        e = parse_expr(d, PREC_UNARY + 1);
+        node_loc = loc;
+        return neg(e);
+    case '!':
+        advance(d);
+        e = parse_expr(d, PREC_UNARY + 1);
+        node_loc = loc;
+        return not_(e);
+    case '~':
+        advance(d);
+        e = parse_expr(d, PREC_DOT + 1);
+        node_loc = loc;
+        return bitnot(e);
+    default:
+        fail(d);
+        return NULL;
+    }
+}
+
+static Expr binary(int op, Expr e1, Expr e2)
+{
+    switch (op) {
+    case OR:    return or_(e1, e2);
+    case AND:   return and_(e1, e2);
+    case EQUAL: return equ(e1, e2);
+    case NE:    return neq(e1, e2);
+    case '<':   return lt(e1, e2);
+    case '>':   return gt(e1, e2);
+    case LE:    return le(e1, e2);
+    case GE:    return ge(e1, e2);
+    case '+':   return add(e1, e2);
+    case '-':   return minus(e1, e2);
+    case '*':   return multi(e1, e2);
+    case '/':   return divide(e1, e2);
+    case '%':   return mod(e1, e2);
+    case '&':   return bitand_(e1, e2);
+    case '|':   return bitor_(e1, e2);
+    default:    return xor_(e1, e2);
+    }
+}
+
+//
+// Precedence climbing: an operand followed by binary operators of
+// precedence min_prec or higher.  A binary node gets the location of
+// the first token of its left operand, which is where this expression
+// starts.  Two non-associative operators of the same precedence in a
+// row are a syntax error, as they are for bison.
+//
+static Expr parse_expr(Descent *d, int min_prec)
+{
+    if (too_deep(d)) {
+        fail(d);
+        return NULL;
+    }
+    SourceLoc loc = d->loc;
+    Expr e = parse_operand(d);
+    int nonassoc = 0;                   // precedence of a NONE operator just used
+    int prec;
+    while ((prec = prec_of(d->token)) >= min_prec) {
+        if (prec == nonassoc) {
+            fail(d);
+            break;
+        }
+        int op = d->token;
+        advance(d);
+        Expr e2 = parse_expr(d, binary_assoc[op] == RIGHT ? prec : prec + 1);
+        node_loc = loc;
+        e = binary(op, e, e2);
+        nonassoc = binary_assoc[op] == NONE ? prec : 0;
+    }
+    return e;
+}
+
+static Stmt parse_stmt(Descent *d)
+{
+    SourceLoc loc = d->loc;
+    Expr e1, e2, e3;
+    switch (d->token) {
+    case ';':
+        advance(d);
+        node_loc = loc;
+        return no_expr();
+    case '{':
+        return parse_block(d);
+    case IF: {
+        advance(d);
+        e1 = parse_expr(d, 1);
+        StmtBlock then = parse_block(d);
+        if (d->token == ELSE) {
+            advance(d);
+            StmtBlock otherwise = parse_block(d);
+            node_loc = loc;
+            return ifstmt(e1, then, otherwise);
+        }
+        node_loc = loc;
+        return ifstmt(e1, then, stmtBlock(nil_VariableDecls(), nil_Stmts()));
+    }
+    case WHILE: {
+        advance(d);
+        e1 = parse_expr(d, 1);
+        StmtBlock body = parse_block(d);
+        node_loc = loc;
+        return whilestmt(e1, body);
+    }
+    case FOR: {
+        // each of the three expressions may be left out
+        advance(d);
+        e1 = d->token == ';' ? NULL : parse_expr(d, 1);
+        expect(d, ';');
+        e2 = d->token == ';' ? NULL : parse_expr(d, 1);
+        expect(d, ';');
+        e3 = d->token == '{' ? NULL : parse_expr(d, 1);
+        StmtBlock body = parse_block(d);
+        node_loc = loc;
+        return forstmt(e1 ? e1 : no_expr(), e2 ? e2 : no_expr(),
+                       e3 ? e3 : no_expr(), body);
+    }
+    case BREAK:
+        advance(d);
+        expect(d, ';');
+        node_loc = loc;
+        return breakstmt();
+    case CONTINUE:
+        advance(d);
+        expect(d, ';');
+        node_loc = loc;
+        return continuestmt();
+    case RETURN:
+        advance(d);
+        if (d->token == ';') {
+            advance(d);
+            node_loc = loc;
+            return returnstmt(no_expr());
+        }
+        e1 = parse_expr(d, 1);
+        expect(d, ';');
+        node_loc = loc;
+        return returnstmt(e1);
+    default:
+        e1 = parse_expr(d, 1);
+        expect(d, ';');
+        return e1;
+    }
+}
+
+// VAR variable ';', at the VAR
+static VariableDecl parse_variable_decl(Descent *d)
+{
+    SourceLoc loc = d->loc;
+    advance(d);
+    SourceLoc var_loc = d->loc;
+    Symbol name = expect_symbol(d, OBJECTID);
+    Symbol type = expect_symbol(d, TYPEID);
+    node_loc = var_loc;
+    Variable v = variable(name, type);
+    expect(d, ';');
+    node_loc = loc;
+    return variableDecl(v);
+}
+
+// '{' variable declarations, then statements '}'
+static StmtBlock parse_block(Descent *d)
+{
+    SourceLoc loc = d->loc;
+    if (d->token != '{' || too_deep(d)) {
+        fail(d);
+        return NULL;
+    }
+    advance(d);
+    VariableDecls vars = NULL;
+    if (d->token == VAR)
+        vars = single_VariableDecls(parse_variable_decl(d));
+    while (d->token == VAR)
+        vars = append_VariableDecls(vars, single_VariableDecls(parse_variable_decl(d)));
+    Stmts stmts = NULL;
+    if (d->token != '}' && d->token != 0)
+        stmts = single_Stmts(parse_stmt(d));
+    while (d->token != '}' && d->token != 0)
+        stmts = append_Stmts(stmts, single_Stmts(parse_stmt(d)));
+    expect(d, '}');
+    node_loc = loc;
+    return stmtBlock(vars ? vars : nil_VariableDecls(), stmts ? stmts : nil_Stmts());
+}
+
+// variable_list: like actual_list
+static Variables parse_variables(Descent *d)
+{
+    Variables vars;
+    if (d->token == ',' || d->token == ')') {
+        vars = nil_Variables();
+    } else {
+        SourceLoc loc = d->loc;
+        Symbol name = expect_symbol(d, OBJECTID);
+        Symbol type = expect_symbol(d, TYPEID);
+        node_loc = loc;
+        vars = single_Variables(variable(name, type));
+    }
+    while (d->token == ',') {
+        advance(d);
+        SourceLoc loc = d->loc;
+        Symbol name = expect_symbol(d, OBJECTID);
+        Symbol type = expect_symbol(d, TYPEID);
+        node_loc = loc;
+        vars = append_Variables(vars, single_Variables(variable(name, type)));
+    }
+    return vars;
+}
+
+// FUNC OBJECTID '(' variable_list ')' TYPEID stmtBlock, at the FUNC
+static CallDecl parse_call_decl(Descent *d)
+{
+    SourceLoc loc = d->loc;
+    advance(d);
+    Symbol name = expect_symbol(d, OBJECTID);
+    expect(d, '(');
+    Variables paras = parse_variables(d);
+    expect(d, ')');
+    Symbol type = expect_symbol(d, TYPEID);
+    StmtBlock body = parse_block(d);
+    node_loc = loc;
+    return callDecl(name, paras, type, body);
+}
+
+static Decl parse_decl(Descent *d)
+{
+    if (d->token == VAR)
+        return parse_variable_decl(d);
+    if (d->token == FUNC)
+        return parse_call_decl(d);
+    fail(d);
+    return NULL;
+}
+
+//
+// Parse input, whose first byte is at location start, into parse.
+// Returns 1 if that worked; 0 if the caller should parse input with
+// bison, in which case input is back where it was and the -X counters
+// are as they were, but for "descent fallbacks".  Input that cannot be
+// read again, such as a pipe, is left to bison from the start.
+//
+int seal_descent_parse(FILE *input, SourceLoc start, SealParse *parse)
+{
+    long offset = ftell(input);
+    if (offset < 0) {
+        compile_stats.descent_fallbacks++;
+        return 0;
+    }
+    long tokens = compile_stats.tokens;
+    long nodes[NODE_KIND_COUNT];
+    for (int k = 0; k < NODE_KIND_COUNT; k++)
+        nodes[k] = compile_stats.nodes[k];
+
+    Descent d;
+    d.stack_floor = stack_floor();
+    d.failed = false;
+    scanner_open(input, start);
+    advance(&d);
+    SourceLoc loc = d.loc;
+    Decls decls = single_Decls(parse_decl(&d));
+    while (d.token != 0)
+        decls = append_Decls(decls, single_Decls(parse_decl(&d)));
+    if (!d.failed) {
+        node_loc = loc;
+        parse->program = program(decls);
+    }
+    scanner_close();
+
+    if (d.failed) {
+        fseek(input, offset, SEEK_SET);
+        compile_stats.tokens = tokens;
+        for (int k = 0; k < NODE_KIND_COUNT; k++)
+            compile_stats.nodes[k] = nodes[k];
+        compile_stats.descent_fallbacks++;
+        return 0;
+    }
+    return 1;
+}
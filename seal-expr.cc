@@ -326,13 +326,13 @@ void Const_string_class::dump(ostream& stream, int n)
 
 Expr Const_float_class::copy_Expr()
 {
-   return new Const_float_class(copy_Symbol(value));
+   return new Const_float_class(copy_Symbol(spelling));
 }
 
 void Const_float_class::dump(ostream& stream, int n)
 {
    stream << pad(n) << "_const_float\n";
-   dump_Symbol(stream, n+2, value);
+   dump_Symbol(stream, n+2, spelling);
 }
 
 
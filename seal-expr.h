@@ -23,13 +23,9 @@ public:
    Expr_class(Symbol a1) {
         type = a1;
    }
-   void check(Symbol a) {checkType();}
-   void dump_type(ostream&, int);
 
-   virtual void dump_with_types(ostream&,int) = 0; 
 	virtual void dump(ostream&,int) = 0;
    virtual Expr copy_Expr() = 0;
-   virtual Symbol checkType() = 0;
    virtual bool is_empty_Expr() = 0;
 };
 
@@ -37,19 +33,22 @@ class Call_class : public Expr_class {
 protected:
    Symbol name;
    Actuals actuals;
+   CallDecl callee;            // set by binding; see semant.cc
 public:
    Call_class(Symbol a1, Actuals a2)  {
         name = a1;
         actuals = a2;
+        callee = NULL;
+        set_kind(NODE_CALL);
    }
    Symbol getName(){return name;}
    Actuals getActuals(){return actuals;}
+   // the function called, or NULL if there is none of that name
+   CallDecl getCallee(){return callee;}
+   void setCallee(CallDecl c) { callee = c; }
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
-   void dump_with_types(ostream&,int); 
 	void dump(ostream&,int);
-   void dump_type(ostream& , int );
-   Symbol checkType();
 };
 
 
@@ -59,13 +58,12 @@ protected:
 public:
    Actual_class(Expr a1)  {
         expr = a1;
+        set_kind(NODE_ACTUAL);
    }
+   Expr getExpr() { return expr; }
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
-   void dump_with_types(ostream&,int); 
 	void dump(ostream&,int);
-   void dump_type(ostream& , int );
-   Symbol checkType();
 };
 
 // define constructor - expr
@@ -73,16 +71,22 @@ class Assign_class : public Expr_class {
 protected:
    Symbol lvalue;
    Expr value;
+   Variable decl;              // set by binding; see semant.cc
 public:
    Assign_class(Symbol a1, Expr a2)  {
       lvalue = a1;
       value = a2;
+      decl = NULL;
+      set_kind(NODE_ASSIGN);
    }
+   Symbol getLvalue() { return lvalue; }
+   Expr getValue() { return value; }
+   // the declaration of lvalue in scope, or NULL if there is none
+   Variable getDecl() { return decl; }
+   void setDecl(Variable v) { decl = v; }
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
 };
 
 // define constructor - add
@@ -94,12 +98,13 @@ public:
    Add_class(Expr a1, Expr a2) {
       e1 = a1;
       e2 = a2;
+      set_kind(NODE_ADD);
    }
+   Expr getLeft() { return e1; }
+   Expr getRight() { return e2; }
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
 };
 
 // define constructor - minus
@@ -111,12 +116,13 @@ public:
    Minus_class(Expr a1, Expr a2) {
       e1 = a1;
       e2 = a2;
+      set_kind(NODE_MINUS);
    }
+   Expr getLeft() { return e1; }
+   Expr getRight() { return e2; }
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
 };
 
 // define constructor - multi
@@ -128,12 +134,13 @@ public:
    Multi_class(Expr a1, Expr a2) {
       e1 = a1;
       e2 = a2;
+      set_kind(NODE_MULTI);
    }
+   Expr getLeft() { return e1; }
+   Expr getRight() { return e2; }
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int);
-   Symbol checkType(); 
 };
 
 // define constructor - divide
@@ -145,12 +152,13 @@ public:
    Divide_class(Expr a1, Expr a2) {
       e1 = a1;
       e2 = a2;
+      set_kind(NODE_DIVIDE);
    }
+   Expr getLeft() { return e1; }
+   Expr getRight() { return e2; }
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
 };
 
 // define constructor - mod
@@ -162,12 +170,13 @@ public:
    Mod_class(Expr a1, Expr a2) {
       e1 = a1;
       e2 = a2;
+      set_kind(NODE_MOD);
    }
+   Expr getLeft() { return e1; }
+   Expr getRight() { return e2; }
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
 };
 
 // define constructor - -
@@ -177,12 +186,12 @@ protected:
 public:
    Neg_class(Expr a1) {
       e1 = a1;
+      set_kind(NODE_NEG);
    }
+   Expr getOperand() { return e1; }
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
 };
 
 // define constructor - <
@@ -194,12 +203,13 @@ public:
    Lt_class(Expr a1, Expr a2) {
       e1 = a1;
       e2 = a2;
+      set_kind(NODE_LT);
    }
+   Expr getLeft() { return e1; }
+   Expr getRight() { return e2; }
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
 };
 
 // define constructor - <=
@@ -211,12 +221,13 @@ public:
    Le_class(Expr a1, Expr a2) {
       e1 = a1;
       e2 = a2;
+      set_kind(NODE_LE);
    }
+   Expr getLeft() { return e1; }
+   Expr getRight() { return e2; }
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
 };
 
 // define constructor - ==
@@ -228,12 +239,13 @@ public:
    Equ_class(Expr a1, Expr a2) {
       e1 = a1;
       e2 = a2;
+      set_kind(NODE_EQU);
    }
+   Expr getLeft() { return e1; }
+   Expr getRight() { return e2; }
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
 };
 
 // define constructor - !=
@@ -245,12 +257,13 @@ public:
    Neq_class(Expr a1, Expr a2) {
       e1 = a1;
       e2 = a2;
+      set_kind(NODE_NEQ);
    }
+   Expr getLeft() { return e1; }
+   Expr getRight() { return e2; }
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
 };
 
 // define constructor - >=
@@ -262,12 +275,13 @@ public:
    Ge_class(Expr a1, Expr a2) {
       e1 = a1;
       e2 = a2;
+      set_kind(NODE_GE);
    }
+   Expr getLeft() { return e1; }
+   Expr getRight() { return e2; }
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
 };
 
 // define constructor - >
@@ -279,12 +293,13 @@ public:
    Gt_class(Expr a1, Expr a2) {
       e1 = a1;
       e2 = a2;
+      set_kind(NODE_GT);
    }
+   Expr getLeft() { return e1; }
+   Expr getRight() { return e2; }
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
 };
 
 // define constructor - and &&
@@ -296,12 +311,13 @@ public:
    And_class(Expr a1, Expr a2) {
       e1 = a1;
       e2 = a2;
+      set_kind(NODE_AND);
    }
+   Expr getLeft() { return e1; }
+   Expr getRight() { return e2; }
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
 };
 
 // define constructor - or ||
@@ -313,12 +329,13 @@ public:
    Or_class(Expr a1, Expr a2) {
       e1 = a1;
       e2 = a2;
+      set_kind(NODE_OR);
    }
+   Expr getLeft() { return e1; }
+   Expr getRight() { return e2; }
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
 };
 
 // define constructor - xor ^
@@ -330,12 +347,13 @@ public:
    Xor_class(Expr a1, Expr a2) {
       e1 = a1;
       e2 = a2;
+      set_kind(NODE_XOR);
    }
+   Expr getLeft() { return e1; }
+   Expr getRight() { return e2; }
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
 };
 
 // define constructor - not !
@@ -345,12 +363,12 @@ protected:
 public:
    Not_class(Expr a1) {
       e1 = a1;
+      set_kind(NODE_NOT);
    }
+   Expr getOperand() { return e1; }
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
 };
 
 // define constructor - bitnot ~
@@ -360,12 +378,12 @@ protected:
 public:
    Bitnot_class(Expr a1) {
       e1 = a1;
+      set_kind(NODE_BITNOT);
    }
+   Expr getOperand() { return e1; }
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
 };
 
 class Bitand_class : public Expr_class {
@@ -376,12 +394,13 @@ public:
    Bitand_class(Expr a1, Expr a2) {
       e1 = a1;
       e2 = a2;
+      set_kind(NODE_BITAND);
    }
+   Expr getLeft() { return e1; }
+   Expr getRight() { return e2; }
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
 };
 
 class Bitor_class : public Expr_class {
@@ -392,12 +411,13 @@ public:
    Bitor_class(Expr a1, Expr a2) {
       e1 = a1;
       e2 = a2;
+      set_kind(NODE_BITOR);
    }
+   Expr getLeft() { return e1; }
+   Expr getRight() { return e2; }
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
 };
 
 // define constructconst_int - const_int
@@ -407,12 +427,13 @@ protected:
 public:
    Const_int_class(Symbol a1) {
       value = a1;
+      set_kind(NODE_CONST_INT);
    }
+   Symbol getSymbol() { return value; }
+   int64_t get_value() { return ((IntEntry *) value)->get_value(); }
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
 };
 
 // define constructconst_string - const_string
@@ -422,27 +443,31 @@ protected:
 public:
    Const_string_class(Symbol a1) {
       value = a1;
+      set_kind(NODE_CONST_STRING);
    }
+   Symbol getSymbol() { return value; }
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
 };
 
 // define constructconst_float - const_float
 class Const_float_class : public Expr_class {
 protected:
-   Symbol value;
+   Symbol spelling;            // as written, in floatspellings
+   Symbol value;               // in floattable
 public:
    Const_float_class(Symbol a1) {
-      value = a1;
+      spelling = a1;
+      value = floattable.add_float(parse_float(a1->get_string(),
+                                               a1->get_len()));
+      set_kind(NODE_CONST_FLOAT);
    }
+   Symbol getSymbol() { return spelling; }
+   double get_value() { return ((FloatEntry *) value)->get_value(); }
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
 };
 
 // define constructconst_bool - const_bool
@@ -452,27 +477,32 @@ protected:
 public:
    Const_bool_class(Boolean a1) {
       value = a1;
+      set_kind(NODE_CONST_BOOL);
    }
+   Boolean getValue() { return value; }
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
 };
 
 class Object_class : public Expr_class {
 protected:
    Symbol var;
+   Variable decl;              // set by binding; see semant.cc
 public:
    Object_class(Symbol a1) {
       var = a1;
+      decl = NULL;
+      set_kind(NODE_OBJECT);
    }
+   Symbol getName() { return var; }
+   // the declaration of var in scope, or NULL if there is none
+   Variable getDecl() { return decl; }
+   void setDecl(Variable v) { decl = v; }
    bool is_empty_Expr(){ return false;}
    Expr copy_Expr(){return copy_Object();};
    Object copy_Object();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
 };
 
 // define constructor - no_expr
@@ -480,12 +510,11 @@ class No_expr_class : public Expr_class {
 protected:
 public:
    No_expr_class() {
+      set_kind(NODE_NO_EXPR);
    }
    bool is_empty_Expr(){ return true;}
    Expr copy_Expr();
    void dump(ostream& stream, int n);
-   void dump_with_types(ostream&,int); 
-   Symbol checkType();
 };
 
 
@@ -203,12 +203,12 @@ typedef size_t yy_size_t;
 #endif
 
 /* %if-not-reentrant */
-extern yy_size_t yyleng;
+extern thread_local yy_size_t yyleng;
 /* %endif */
 
 /* %if-c-only */
 /* %if-not-reentrant */
-extern FILE *yyin, *yyout;
+extern thread_local FILE *yyin, *yyout;
 /* %endif */
 /* %endif */
 
@@ -310,9 +310,9 @@ struct yy_buffer_state
 /* %if-not-reentrant */
 
 /* Stack of input buffers. */
-static size_t yy_buffer_stack_top = 0; /**< index of top of stack. */
-static size_t yy_buffer_stack_max = 0; /**< capacity of stack. */
-static YY_BUFFER_STATE * yy_buffer_stack = 0; /**< Stack as an array. */
+static thread_local size_t yy_buffer_stack_top = 0; /**< index of top of stack. */
+static thread_local size_t yy_buffer_stack_max = 0; /**< capacity of stack. */
+static thread_local YY_BUFFER_STATE * yy_buffer_stack = 0; /**< Stack as an array. */
 /* %endif */
 /* %ok-for-header */
 
@@ -339,19 +339,19 @@ static YY_BUFFER_STATE * yy_buffer_stack = 0; /**< Stack as an array. */
 /* %not-for-header */
 
 /* yy_hold_char holds the character lost when yytext is formed. */
-static char yy_hold_char;
-static yy_size_t yy_n_chars;		/* number of characters read into yy_ch_buf */
-yy_size_t yyleng;
+static thread_local char yy_hold_char;
+static thread_local yy_size_t yy_n_chars;		/* number of characters read into yy_ch_buf */
+thread_local yy_size_t yyleng;
 
 /* Points to current character in buffer. */
-static char *yy_c_buf_p = (char *) 0;
-static int yy_init = 0;		/* whether we need to initialize */
-static int yy_start = 0;	/* start state number */
+static thread_local char *yy_c_buf_p = (char *) 0;
+static thread_local int yy_init = 0;		/* whether we need to initialize */
+static thread_local int yy_start = 0;	/* start state number */
 
 /* Flag which is used to allow yywrap()'s to do buffer switches
  * instead of setting up a fresh yyin.  A bit of a hack ...
  */
-static int yy_did_buffer_switch_on_eof;
+static thread_local int yy_did_buffer_switch_on_eof;
 /* %ok-for-header */
 
 /* %endif */
@@ -414,15 +414,15 @@ void yyfree (void *  );
 
 typedef unsigned char YY_CHAR;
 
-FILE *yyin = (FILE *) 0, *yyout = (FILE *) 0;
+thread_local FILE *yyin = (FILE *) 0, *yyout = (FILE *) 0;
 
 typedef int yy_state_type;
 
-extern int yylineno;
+extern thread_local int yylineno;
 
-int yylineno = 1;
+thread_local int yylineno = 1;
 
-extern char *yytext;
+extern thread_local char *yytext;
 #define yytext_ptr yytext
 
 /* %if-c-only Standard (non-C++) definition */
@@ -628,8 +628,8 @@ static yyconst flex_int16_t yy_chk[277] =
       145,  145,  145,  145,  145,  145
     } ;
 
-static yy_state_type yy_last_accepting_state;
-static char *yy_last_accepting_cpos;
+static thread_local yy_state_type yy_last_accepting_state;
+static thread_local char *yy_last_accepting_cpos;
 
 extern int yy_flex_debug;
 int yy_flex_debug = 1;
@@ -652,7 +652,7 @@ static yyconst flex_int16_t yy_rule_linenum[68] =
 #define yymore() yymore_used_but_not_detected
 #define YY_MORE_ADJ 0
 #define YY_RESTORE_YY_MORE_OFFSET
-char *yytext;
+thread_local char *yytext;
 #line 1 "seal.flex"
 /*
 *  The scanner definition for seal.
@@ -667,18 +667,19 @@ char *yytext;
 #include <seal-parse.h>
 #include <stringtab.h>
 #include <utilities.h>
+#include <seal-lex.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 /* The compiler assumes these identifiers. */
 #define yylval seal_yylval
-#define yylex  seal_yylex
+#define yylex  seal_flex_yylex
 
-/* Max size of string constants */
-#define MAX_STR_CONST 256
 #define YY_NO_UNPUT   /* keep g++ happy */
 
-extern FILE *fin; /* we read from this file */
+extern thread_local FILE *fin; /* we read from this file */
 
 /* define YY_INPUT so we read from the FILE fin:
  * This change makes it possible to use this scanner in
@@ -689,21 +690,65 @@ extern FILE *fin; /* we read from this file */
 	if ( (result = fread( (char*)buf, sizeof(char), max_size, fin)) < 0) \
 		YY_FATAL_ERROR( "read() in flex scanner failed");
 
-char string_buf[MAX_STR_CONST]; /* to assemble string constants */
-char *string_buf_ptr;
-
-extern int curr_lineno;
 extern int verbose_flag;
 
-extern YYSTYPE seal_yylval;
+/* The location and value of the last token scanned, on this thread. */
+thread_local SourceLoc curr_loc;
+thread_local YYSTYPE seal_yylval;
+
+/* The location of the first byte of the input, and the bytes the rules
+   have matched since. */
+static thread_local SourceLoc scan_start;
+static thread_local unsigned flex_offset;
+#define YY_USER_ACTION flex_offset += yyleng;
 
 /*
  *  Add Your own definitions here
  */
 
-char string_const[MAX_STR_CONST + 10];
-int string_const_len;
-bool str_contain_null_char;
+/*
+ * String constants that scan_string_const cannot take straight from the
+ * buffer are assembled here by the per-character rules.  The buffer
+ * grows as needed, so there is no limit on their length.
+ */
+thread_local char *string_const = NULL;
+thread_local int string_const_len;
+thread_local int string_const_cap = 0;
+thread_local bool str_contain_null_char;
+
+static void string_const_add(char c)
+{
+	if (string_const_len == string_const_cap) {
+		string_const_cap = string_const_cap ? 2 * string_const_cap : 256;
+		string_const = (char *) realloc(string_const, string_const_cap);
+		if (string_const == NULL) {
+			cerr << "out of memory for a string constant\n";
+			exit(-1);
+		}
+	}
+	string_const[string_const_len++] = c;
+}
+
+static int scan_string_const(char close);
+
+thread_local std::ostringstream lex_message;
+
+int lexical_error()
+{
+	return LEX_ERROR;
+}
+
+static int is_octal(char c) { return c >= '0' && c <= '7'; }
+/* \x takes any two letters or digits; letters past f count on as if
+   the digits continued (g is 16, and so on) */
+static int is_hex(char c) { return isalnum((unsigned char) c); }
+
+static int hex_value(char c)
+{
+	if (c >= 'a') return c - 'a' + 10;
+	if (c >= 'A') return c - 'A' + 10;
+	return c - '0';
+}
 
 /*
 * Define names for regular expressions here.
@@ -1076,7 +1121,7 @@ case 1:
 /* rule 1 can match eol */
 YY_RULE_SETUP
 #line 71 "seal.flex"
-{ curr_lineno++; }
+{}
 	YY_BREAK
 case 2:
 YY_RULE_SETUP
@@ -1100,7 +1145,7 @@ case 5:
 /* rule 5 can match eol */
 YY_RULE_SETUP
 #line 80 "seal.flex"
-{ BEGIN 0; curr_lineno++; }
+{ BEGIN 0; }
 	YY_BREAK
 case 6:
 YY_RULE_SETUP
@@ -1116,13 +1161,13 @@ case 8:
 /* rule 8 can match eol */
 YY_RULE_SETUP
 #line 84 "seal.flex"
-{ curr_lineno++; }
+{}
 	YY_BREAK
 case YY_STATE_EOF(BLOCK_COMMENT):
 #line 85 "seal.flex"
 { 
-	cerr << curr_lineno << ": Comment meets an EOF.\n";
-  exit(-1);
+	lex_message << scan_line(flex_offset) << ": Comment meets an EOF.\n";
+  return lexical_error();
 }
 	YY_BREAK
 case 9:
@@ -1134,8 +1179,8 @@ case 10:
 YY_RULE_SETUP
 #line 90 "seal.flex"
 {
-	cerr << curr_lineno << ": Unmatched */.\n";
-  exit(-1);
+	lex_message << scan_line(flex_offset - yyleng) << ": Unmatched */.\n";
+  return lexical_error();
 }
 	YY_BREAK
 /*
@@ -1344,7 +1389,8 @@ case 47:
 YY_RULE_SETUP
 #line 164 "seal.flex"
 {
-	memset(string_const, 0, sizeof string_const);
+	if (scan_string_const('"'))
+		return (CONST_STRING);
 	string_const_len = 0; 
 	str_contain_null_char = false;
 	BEGIN QUOTE_STRING;
@@ -1353,18 +1399,14 @@ YY_RULE_SETUP
 case YY_STATE_EOF(QUOTE_STRING):
 #line 171 "seal.flex"
 {
-	cerr << curr_lineno << ": String constant meets an EOF.\n";
-  exit(-1);
+	lex_message << scan_line(flex_offset) << ": String constant meets an EOF.\n";
+  return lexical_error();
 }
 	YY_BREAK
 case 48:
 YY_RULE_SETUP
 #line 176 "seal.flex"
 {
-	if (string_const_len >= MAX_STR_CONST) {
-		cerr << curr_lineno << ": String length is more than 256.\n";
-    exit(-1);
-	} 
 	
 	int r = 0;
 	for(int i = 3, p = 1; i >= 2 ; i--) {
@@ -1377,44 +1419,36 @@ YY_RULE_SETUP
 		}	
 		p *= 16;
 	}
-	string_const[string_const_len++] = (char)r;
+	string_const_add((char)r);
 }
 	YY_BREAK
 case 49:
 YY_RULE_SETUP
 #line 196 "seal.flex"
 {
-	if (string_const_len >= MAX_STR_CONST) {
-		cerr << curr_lineno << ": String length is more than 256.\n";
-    exit(-1);
-	} 
 	
 	int r = 0;
 	for(int i = 3, p = 1; i >= 1 ; i--) {
 		r += (yytext[i] - '0') * p;
 		p *= 8;	
 	}
-	string_const[string_const_len++] = (char)r;
+	string_const_add((char)r);
 }
 	YY_BREAK
 case 50:
 YY_RULE_SETUP
 #line 210 "seal.flex"
 {
-	if (string_const_len >= MAX_STR_CONST) {
-		cerr << curr_lineno << ": String length is more than 256.\n";
-    exit(-1);
-	} 
 	switch(yytext[1]) {
-		case '\"': string_const[string_const_len++] = '\"'; break;
-		case '\\': string_const[string_const_len++] = '\\'; break;
-		case 'b' : string_const[string_const_len++] = '\b'; break;
-		case 'f' : string_const[string_const_len++] = '\f'; break;
-		case 'n' : string_const[string_const_len++] = '\n'; break;
-		case 't' : string_const[string_const_len++] = '\t'; break;
-		case '0' : string_const[string_const_len++] = '\0'; 
+		case '\"': string_const_add('\"'); break;
+		case '\\': string_const_add('\\'); break;
+		case 'b' : string_const_add('\b'); break;
+		case 'f' : string_const_add('\f'); break;
+		case 'n' : string_const_add('\n'); break;
+		case 't' : string_const_add('\t'); break;
+		case '0' : string_const_add('\0'); 
 			   str_contain_null_char = true; break;
-		default  : string_const[string_const_len++] = yytext[1];
+		default  : string_const_add(yytext[1]);
 	}
 }
 	YY_BREAK
@@ -1423,12 +1457,7 @@ case 51:
 YY_RULE_SETUP
 #line 228 "seal.flex"
 { 
-	if (string_const_len >= MAX_STR_CONST) {
-		cerr << curr_lineno << ": String length is more than 256.\n";
-    exit(-1);
-	} 
-	string_const[string_const_len++] = '\n'; 
-	curr_lineno++; 
+	string_const_add('\n'); 
 	}
 	YY_BREAK
 case 52:
@@ -1436,8 +1465,8 @@ case 52:
 YY_RULE_SETUP
 #line 236 "seal.flex"
 {
-	cerr << curr_lineno << ": String length is more than 256.\n";
-    exit(-1);
+	lex_message << scan_line(flex_offset - yyleng) << ": String constant contains an unescaped newline.\n";
+    return lexical_error();
 }
 	YY_BREAK
 case 53:
@@ -1445,9 +1474,10 @@ YY_RULE_SETUP
 #line 241 "seal.flex"
 { 
 	if (string_const_len > 0 && str_contain_null_char) {
-		cerr << curr_lineno << ": String contains a '\0'.\n";
-    exit(-1);
+		lex_message << scan_line(flex_offset - yyleng) << ": String contains a '\0'.\n";
+    return lexical_error();
 	}
+	string_const_add('\0');
 	seal_yylval.symbol = stringtable.add_string(string_const);
 	BEGIN 0; return (CONST_STRING);
 }
@@ -1456,18 +1486,15 @@ case 54:
 YY_RULE_SETUP
 #line 250 "seal.flex"
 { 
-	if (string_const_len >= MAX_STR_CONST) {
-		cerr << curr_lineno << ": String length is more than 256.\n";
-    exit(-1);
-	} 
-	string_const[string_const_len++] = yytext[0]; 
+	string_const_add(yytext[0]); 
 }
 	YY_BREAK
 case 55:
 YY_RULE_SETUP
 #line 258 "seal.flex"
 {
-	memset(string_const, 0, sizeof string_const);
+	if (scan_string_const('`'))
+		return (CONST_STRING);
 	string_const_len = 0; 
 	BEGIN REVERSE_STRING;
 }
@@ -1477,33 +1504,21 @@ case 56:
 YY_RULE_SETUP
 #line 264 "seal.flex"
 {
-	if (string_const_len >= MAX_STR_CONST) {
-		cerr << curr_lineno << ": String length is more than 256.\n";
-    exit(-1);
-	} 
-	curr_lineno++;
-	string_const[string_const_len++] = yytext[0]; 
+	string_const_add(yytext[0]); 
 }
 	YY_BREAK
 case 57:
 YY_RULE_SETUP
 #line 273 "seal.flex"
 {
-	if (string_const_len >= MAX_STR_CONST) {
-		cerr << curr_lineno << ": String length is more than 256.\n";
-    exit(-1);
-	} 
-	string_const[string_const_len++] = yytext[0]; 
+	string_const_add(yytext[0]); 
 }
 	YY_BREAK
 case 58:
 YY_RULE_SETUP
 #line 281 "seal.flex"
 {
-	if (string_const_len >= MAX_STR_CONST) {
-		cerr << curr_lineno << ": String length is more than 256.\n";
-    exit(-1);
-	} 
+	string_const_add('\0');
 	seal_yylval.symbol = stringtable.add_string(string_const);
 	BEGIN 0; return (CONST_STRING);
 }
@@ -1511,8 +1526,8 @@ YY_RULE_SETUP
 case YY_STATE_EOF(REVERSE_STRING):
 #line 290 "seal.flex"
 {
-	cerr << curr_lineno << ": String constant meets an EOF.\n";
-    exit(-1);
+	lex_message << scan_line(flex_offset) << ": String constant meets an EOF.\n";
+    return lexical_error();
 }
 	YY_BREAK
 /*
@@ -1535,9 +1550,7 @@ YY_RULE_SETUP
 		r += (yytext[i] - '0') * p;
 		p *= 8;
 	}
-	char s[20];
-	sprintf(s, "%ld", r);
-	seal_yylval.symbol = inttable.add_string(s); 
+	seal_yylval.symbol = inttable.add_int(r); 
 	return (CONST_INT);
 }
 	YY_BREAK
@@ -1556,9 +1569,7 @@ YY_RULE_SETUP
 		}	
 		p *= 16;
 	}
-	char s[20];
-	sprintf(s, "%ld", r);
-	seal_yylval.symbol = inttable.add_string(s); 
+	seal_yylval.symbol = inttable.add_int(r); 
 	return (CONST_INT);
 }
 	YY_BREAK
@@ -1566,7 +1577,7 @@ case 62:
 YY_RULE_SETUP
 #line 334 "seal.flex"
 {
-	seal_yylval.symbol = floattable.add_string(yytext); 
+	seal_yylval.symbol = floatspellings.add_string(yytext); 
 	return (CONST_FLOAT);
 }
 	YY_BREAK
@@ -1590,16 +1601,16 @@ case 65:
 YY_RULE_SETUP
 #line 349 "seal.flex"
 {
-	cerr << curr_lineno << ": Illegal Type name " << yytext << ".\n";
-    exit(-1);
+	lex_message << scan_line(flex_offset - yyleng) << ": Illegal Type name " << yytext << ".\n";
+    return lexical_error();
 }
 	YY_BREAK
 case 66:
 YY_RULE_SETUP
 #line 354 "seal.flex"
 {
-	cerr << curr_lineno << ": Illegal Identifier name " << yytext << ".\n";
-    exit(-1);
+	lex_message << scan_line(flex_offset - yyleng) << ": Illegal Identifier name " << yytext << ".\n";
+    return lexical_error();
 }
 	YY_BREAK
 /*
@@ -1609,8 +1620,8 @@ case 67:
 YY_RULE_SETUP
 #line 363 "seal.flex"
 {
-	cerr << curr_lineno << ": Illegal character " << yytext << ".\n";
-    exit(-1);
+	lex_message << scan_line(flex_offset - yyleng) << ": Illegal character " << yytext << ".\n";
+    return lexical_error();
 }
 	YY_BREAK
 case 68:
@@ -2747,3 +2758,182 @@ void yyfree (void * ptr )
 
 
 
+/*
+ * With -m, a regular input file is mapped into memory and scanned in
+ * place by scanner_open, instead of being copied through YY_INPUT.
+ * The mapping is private and writable because flex stores a NUL after
+ * every token it matches, so it is populated up front rather than
+ * taking a copy-on-write fault per page.  yy_scan_buffer needs two
+ * NULs after the text, so the file is mapped over an anonymous region
+ * that is at least two bytes longer; the bytes past the end of the
+ * file are zero either way.
+ */
+extern int mmap_input;
+
+static thread_local char *mapped_text = NULL;
+static thread_local size_t mapped_len = 0;
+
+/* Release the input held by the last scanner_open, if any. */
+void scanner_close()
+{
+	seal_scan_close();
+	if (YY_CURRENT_BUFFER && YY_CURRENT_BUFFER->yy_ch_buf == mapped_text)
+		yy_delete_buffer(YY_CURRENT_BUFFER);
+	if (mapped_text != NULL)
+		munmap(mapped_text, mapped_len);
+	mapped_text = NULL;
+	mapped_len = 0;
+}
+
+/* Map all of input, or return 0 if it is not a regular file or the
+   mapping fails. */
+static int map_input(FILE *input)
+{
+	struct stat st;
+	int fd = fileno(input);
+	if (fd < 0 || fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) ||
+	    ftell(input) != 0)
+		return 0;
+
+	size_t size = st.st_size;
+	size_t page = sysconf(_SC_PAGESIZE);
+	size_t len = (size + 2 + page - 1) / page * page;
+	char *base = (char *) mmap(NULL, len, PROT_READ | PROT_WRITE,
+				   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (base == MAP_FAILED)
+		return 0;
+	if (size > 0 &&
+	    mmap(base, size, PROT_READ | PROT_WRITE,
+		 MAP_PRIVATE | MAP_FIXED | MAP_POPULATE,
+		 fd, 0) == MAP_FAILED) {
+		munmap(base, len);
+		return 0;
+	}
+
+	if (YY_CURRENT_BUFFER)
+		yy_delete_buffer(YY_CURRENT_BUFFER);
+	mapped_text = base;
+	mapped_len = len;
+	yy_scan_buffer(base, size + 2);
+	return 1;
+}
+
+/*
+ * Start scanning input from its beginning: in place if -m was given
+ * and it is a regular file, otherwise (a pipe, a terminal) through
+ * YY_INPUT as before.
+ */
+void scanner_open(FILE *input, SourceLoc start)
+{
+	scanner_close();
+	lex_message.str("");
+	scan_start = start;
+	flex_offset = 0;
+	if (hand_lexer) {
+		seal_scan_open(input);
+		return;
+	}
+	if (!mmap_input || !map_input(input))
+		yyrestart(input);
+	BEGIN 0;
+}
+
+/*
+ * The selected scanner: the rules above, or with -L the hand-written
+ * scanner in seal-scan.cc, which produces the same tokens.
+ */
+int scanner_lex()
+{
+	int token;
+	unsigned offset;
+	if (hand_lexer) {
+		token = seal_scan_lex();
+		offset = seal_scan_offset();
+	} else {
+		token = seal_flex_yylex();
+		offset = flex_offset;
+	}
+	curr_loc = scan_start + offset - (token > 0);
+	return token;
+}
+
+/* The line of the byte at offset in the input, for lexical errors. */
+int scan_line(unsigned offset)
+{
+	return source_manager.line(scan_start + offset);
+}
+
+/*
+ * Fast path for string constants, called from the rule for the opening
+ * quote (" or `, given as close).  The whole literal is scanned straight
+ * out of the scanner's buffer and the scanner resumes after it.  A
+ * literal without escapes is interned from its span in the buffer; one
+ * with escapes is unescaped directly into the string table's arena, so
+ * neither is assembled in string_const first.
+ *
+ * Returns 0 without consuming anything when the literal does not end
+ * within the buffer, contains a NUL byte, or needs a diagnostic; the
+ * per-character rules then scan it as before.
+ */
+static int scan_string_const(char close)
+{
+	char *start = yy_c_buf_p;
+	char *limit = YY_CURRENT_BUFFER_LVALUE->yy_ch_buf + yy_n_chars;
+	int escaped = 0;
+	char *p;
+
+	/* flex stored a NUL after the opening quote */
+	*start = yy_hold_char;
+	for (p = start; p < limit && *p != close; p++) {
+		if (*p == '\0')
+			return 0;
+		if (*p == '\n' && close == '"')
+			return 0;
+		if (*p == '\\' && close == '"') {
+			escaped = 1;
+			if (++p == limit || *p == '\0')
+				return 0;
+			/* \0 not starting an octal escape is diagnosed by the rules */
+			if (*p == '0' && !(limit - p > 2 && is_octal(p[1]) && is_octal(p[2])))
+				return 0;
+		}
+	}
+	if (p == limit)
+		return 0;
+
+	if (!escaped) {
+		seal_yylval.symbol = stringtable.add_chars(start, p - start);
+	} else {
+		char *out = stringtable.reserve_string(p - start);
+		int len = 0;
+		for (char *q = start; q < p; q++) {
+			if (*q != '\\') {
+				out[len++] = *q;
+				continue;
+			}
+			q++;
+			if (*q == 'x' && is_hex(q[1]) && is_hex(q[2])) {
+				out[len++] = (char) (hex_value(q[1]) * 16 + hex_value(q[2]));
+				q += 2;
+			} else if (is_octal(q[0]) && is_octal(q[1]) && is_octal(q[2])) {
+				out[len++] = (char) ((q[0] - '0') * 64 + (q[1] - '0') * 8 + (q[2] - '0'));
+				q += 2;
+			} else {
+				switch (*q) {
+				case 'b': out[len++] = '\b'; break;
+				case 'f': out[len++] = '\f'; break;
+				case 'n': out[len++] = '\n'; break;
+				case 't': out[len++] = '\t'; break;
+				default:  out[len++] = *q;
+				}
+			}
+		}
+		/* like the rules, keep only the text before an escaped NUL */
+		seal_yylval.symbol = stringtable.add_reserved(strnlen(out, len));
+	}
+
+	flex_offset += p + 1 - start;
+	yy_c_buf_p = p + 1;
+	yy_hold_char = *yy_c_buf_p;
+	return 1;
+}
@@ -0,0 +1,83 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+#ifndef _SEAL_LEX_H_
+#define _SEAL_LEX_H_
+
+///////////////////////////////////////////////////////////////////////////
+//
+// file: seal-lex.h
+//
+// The lexer as the rest of the compiler sees it.  The scanner_
+// functions drive one of two scanners on the calling thread:
+//
+//   the flex scanner in seal-lex.cc (the default), or
+//   the hand-written scanner in seal-scan.cc (-L).
+//
+// The pull parser reads its tokens from scanner_lex().  With -P a lexer
+// thread runs the scanner ahead of the parser instead, and the tokens
+// are passed over a ring buffer to the push parser (seal-pipe.cc).
+// With -R they go to the hand-written parser in seal-descent.cc first.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <sstream>
+#include "source.h"
+
+struct SealParse;
+
+// start the scanner on input, which is read from its beginning; its
+// first byte is at location start
+void scanner_open(FILE *input, SourceLoc start);
+// release the scanner's input; it is done once the parse is
+void scanner_close();
+// the next token, whose location is left in curr_loc
+int scanner_lex();
+
+//
+// The location of a token is that of its last byte, so that its line
+// is the one the token ends on; the end of input is at the location
+// after the last byte.  Only the scanners know their offset into the
+// input; scanner_lex works out curr_loc from it.
+//
+extern thread_local SourceLoc curr_loc;
+
+void seal_scan_open(FILE *input);
+void seal_scan_close();
+int seal_scan_lex();
+// bytes of input scanned so far
+unsigned seal_scan_offset();
+
+// parse input with the lexer on a thread of its own; see seal-pipe.cc
+void seal_pipe_parse(FILE *input, SourceLoc start, SealParse *parse);
+
+// parse input, a regular file, on up to threads threads; see seal-split.cc
+int seal_split_parse(FILE *input, SourceLoc start, int threads,
+                     SealParse *parse);
+
+// parse input without the LALR tables, if it parses cleanly; see
+// seal-descent.cc
+int seal_descent_parse(FILE *input, SourceLoc start, SealParse *parse);
+
+//
+// A lexical error ends the parse and fails the file at hand, but not
+// the process, so a batch goes on with its other files.  A scanner
+// writes the message to lex_message and returns lexical_error(), which
+// is LEX_ERROR; the parser reports the message (seal_lex_error in
+// seal.y) once it reaches that token.
+//
+enum { LEX_ERROR = -1 };
+extern thread_local std::ostringstream lex_message;
+int lexical_error();
+// the line of the byte at offset in the input, for the message
+int scan_line(unsigned offset);
+
+extern int hand_lexer;          // -L
+extern int pipeline_lexer;      // -P
+extern int descent_parser;      // -R
+
+#endif
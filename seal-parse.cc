@@ -1,8 +1,9 @@
-/* A Bison parser, made by GNU Bison 3.0.4.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015 Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
@@ -15,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -33,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -40,20 +45,20 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "3.0.4"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
 
 /* Pure parsers.  */
-#define YYPURE 0
+#define YYPURE 2
 
 /* Push parsers.  */
-#define YYPUSH 0
+#define YYPUSH 1
 
 /* Pull parsers.  */
 #define YYPULL 1
@@ -61,61 +66,70 @@
 
 /* Substitute the variable and function names.  */
 #define yyparse         seal_yyparse
+#define yypush_parse    seal_yypush_parse
+#define yypull_parse    seal_yypull_parse
+#define yypstate_new    seal_yypstate_new
+#define yypstate_clear  seal_yypstate_clear
+#define yypstate_delete seal_yypstate_delete
+#define yypstate        seal_yypstate
 #define yylex           seal_yylex
 #define yyerror         seal_yyerror
 #define yydebug         seal_yydebug
 #define yynerrs         seal_yynerrs
 
-#define yylval          seal_yylval
-#define yychar          seal_yychar
-#define yylloc          seal_yylloc
+/* First part of user prologue.  */
+#line 6 "seal.y"
 
-/* Copy the first part of user declarations.  */
-#line 6 "seal.y" /* yacc.c:339  */
+  /* Locations are Bison's own YYLTYPE, of which only first_line is
+  used: it holds the SourceLoc of the token (see source.h), and LOC
+  gets it back.  Bison can move the stacks only if it knows the location type
+  to be trivial, which it does for its own; they start with YYINITDEPTH
+  entries and are moved to twice the size whenever they fill up, so
+  nesting is limited only by memory. */
+  #define YYMAXDEPTH 100000000
 
   #include <iostream>
   #include "seal-decl.h"
   #include "seal-stmt.h"
   #include "seal-expr.h"
+  #include "seal-lex.h"
+  #include "stats.h"
   #include "stringtab.h"
   #include "utilities.h"
 
-  extern char *curr_filename;
-  /* Locations */
-  #define YYLTYPE int              /* the type of locations */
-  #define seal_yylloc curr_lineno  /* use the curr_lineno from the lexer
-  for the location of tokens */
-    
-    extern int node_lineno;          /* set before constructing a tree node
-    to whatever you want the line number
+  extern thread_local char *curr_filename;
+
+    extern thread_local SourceLoc node_loc; /* set before constructing a tree node
+    to whatever you want the location
     for the tree node to be */
-      
-      
+
+    #define LOC(Current) ((SourceLoc) (Current).first_line)
+
       #define YYLLOC_DEFAULT(Current, Rhs, N)         \
-      Current = Rhs[1];                             \
-      node_lineno = Current;
-    
-    
+      (Current) = (Rhs)[1];                           \
+      node_loc = LOC(Current);
+
+
     #define SET_NODELOC(Current)  \
-    node_lineno = Current;
-    
+    node_loc = LOC(Current);
+
     /* IMPORTANT NOTE ON LINE NUMBERS
     *********************************
-    * The above definitions and macros cause every terminal in your grammar to 
+    * The above definitions and macros cause every terminal in your grammar to
     * have the line number supplied by the lexer. The only task you have to
     * implement for line numbers to work correctly, is to use SET_NODELOC()
     * before constructing any constructs from non-terminals in your grammar.
-    * Example: Consider you are matching on the following very restrictive 
-    * (fictional) construct that matches a plus between two integer constants. 
+    * Example: Consider you are matching on the following very restrictive
+    * (fictional) construct that matches a plus between two integer constants.
     * (SUCH A RULE SHOULD NOT BE  PART OF YOUR PARSER):
-    
-    plus_consts	: INT_CONST '+' INT_CONST 
-    
+
+    plus_consts	: INT_CONST '+' INT_CONST
+
     * where INT_CONST is a terminal for an integer constant. Now, a correct
     * action for this rule that attaches the correct line number to plus_const
     * would look like the following:
-    
-    plus_consts	: INT_CONST '+' INT_CONST 
+
+    plus_consts	: INT_CONST '+' INT_CONST
     {
       // Set the line number of the current non-terminal:
       // ***********************************************
@@ -124,58 +138,66 @@
       //
       // Here, we choose the line number of the last INT_CONST (@3) as the
       // line number of the resulting expression (@$). You are free to pick
-      // any reasonable line as the line number of non-terminals. If you 
-      // omit the statement @$=..., bison has default rules for deciding which 
+      // any reasonable line as the line number of non-terminals. If you
+      // omit the statement @$=..., bison has default rules for deciding which
       // line number to use. Check the manual for details if you are interested.
       @$ = @3;
-      
-      
+
+
       // Observe that we call SET_NODELOC(@3); this will set the global variable
-      // node_lineno to @3. Since the constructor call "plus" uses the value of 
+      // node_loc to @3. Since the constructor call "plus" uses the value of
       // this global, the plus node will now have the correct line number.
       SET_NODELOC(@3);
-      
+
       // construct the result node:
       $$ = plus(int_const($1), int_const($3));
     }
-    
+
     */
-    
-    
-    
-    void yyerror(char *s);        /*  defined below; called for each parse error */
-    extern int yylex();           /*  the entry point to the lexer  */
-    
-    /************************************************************************/
-    /*                DONT CHANGE ANYTHING IN THIS SECTION                  */
-    
-    Program ast_root;	      /* the result of the parse  */
-    //Decls parse_results;        /* for use in semantic analysis */
-    int omerrs = 0;               /* number of errors in lexing and parsing */
+
+
+
+    /* The parser is pure: a parse keeps its stacks, lookahead and
+    result to itself, so any number of parses can be in progress at
+    once.  It can be driven either way:
+
+    seal_yyparse(&parse) pulls tokens from the scanner until the end of
+    input, or
+
+    a caller holding a seal_yypstate hands it one token at a time with
+    seal_push_token, which returns YYPUSH_MORE until the token that
+    ends the parse.
+
+    Either way parse.program is the result, and parse.errors the number
+    of errors reported.  A lexical error is one of them, and the last:
+    the parse ends at it, with parse.lex_error set. */
+
     
 
-#line 158 "seal.tab.c" /* yacc.c:339  */
+#line 178 "seal-parse.cc"
 
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
 # ifndef YY_NULLPTR
-#  if defined __cplusplus && 201103L <= __cplusplus
-#   define YY_NULLPTR nullptr
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
 #  else
-#   define YY_NULLPTR 0
+#   define YY_NULLPTR ((void*)0)
 #  endif
 # endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 0
-#endif
 
-/* In a future release of Bison, this section will be replaced
-   by #include "seal.tab.h".  */
-#ifndef YY_SEAL_YY_SEAL_TAB_H_INCLUDED
-# define YY_SEAL_YY_SEAL_TAB_H_INCLUDED
 /* Debug traces.  */
 #ifndef YYDEBUG
 # define YYDEBUG 1
@@ -184,75 +206,51 @@
 extern int seal_yydebug;
 #endif
 
-/* Token type.  */
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
   enum yytokentype
   {
-    IF = 258,
-    ELSE = 260,
-    WHILE = 261,
-    FOR = 262,
-    BREAK = 263,
-    CONTINUE = 264,
-    FUNC = 265,
-    RETURN = 266,
-    VAR = 271,
-    ERROR = 273,
-    AND = 274,
-    OR = 275,
-    EQUAL = 276,
-    NE = 277,
-    GE = 278,
-    LE = 279,
-    INT = 280,
-    STRING = 281,
-    BOOL = 282,
-    FLOAT = 283,
-    CONST_BOOL = 267,
-    CONST_INT = 268,
-    CONST_STRING = 269,
-    CONST_FLOAT = 270,
-    OBJECTID = 284,
-    TYPEID = 285,
-    UMINUS = 287
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 288,                 /* "invalid token"  */
+    IF = 258,                      /* IF  */
+    ELSE = 260,                    /* ELSE  */
+    WHILE = 261,                   /* WHILE  */
+    FOR = 262,                     /* FOR  */
+    BREAK = 263,                   /* BREAK  */
+    CONTINUE = 264,                /* CONTINUE  */
+    FUNC = 265,                    /* FUNC  */
+    RETURN = 266,                  /* RETURN  */
+    VAR = 271,                     /* VAR  */
+    ERROR = 273,                   /* ERROR  */
+    AND = 274,                     /* AND  */
+    OR = 275,                      /* OR  */
+    EQUAL = 276,                   /* EQUAL  */
+    NE = 277,                      /* NE  */
+    GE = 278,                      /* GE  */
+    LE = 279,                      /* LE  */
+    INT = 280,                     /* INT  */
+    STRING = 281,                  /* STRING  */
+    BOOL = 282,                    /* BOOL  */
+    FLOAT = 283,                   /* FLOAT  */
+    CONST_BOOL = 267,              /* CONST_BOOL  */
+    CONST_INT = 268,               /* CONST_INT  */
+    CONST_STRING = 269,            /* CONST_STRING  */
+    CONST_FLOAT = 270,             /* CONST_FLOAT  */
+    OBJECTID = 284,                /* OBJECTID  */
+    TYPEID = 285,                  /* TYPEID  */
+    UMINUS = 287                   /* UMINUS  */
   };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
-/* Tokens.  */
-#define IF 258
-#define ELSE 260
-#define WHILE 261
-#define FOR 262
-#define BREAK 263
-#define CONTINUE 264
-#define FUNC 265
-#define RETURN 266
-#define VAR 271
-#define ERROR 273
-#define AND 274
-#define OR 275
-#define EQUAL 276
-#define NE 277
-#define GE 278
-#define LE 279
-#define INT 280
-#define STRING 281
-#define BOOL 282
-#define FLOAT 283
-#define CONST_BOOL 267
-#define CONST_INT 268
-#define CONST_STRING 269
-#define CONST_FLOAT 270
-#define OBJECTID 284
-#define TYPEID 285
-#define UMINUS 287
 
 /* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-
 union YYSTYPE
 {
-#line 89 "seal.y" /* yacc.c:355  */
+#line 133 "seal.y"
 
       Boolean boolean;
       Symbol symbol;
@@ -278,13 +276,13 @@ union YYSTYPE
       Call call;
       Actual actual;
       Actuals actuals;
-      
+
       char *error_msg;
     
 
-#line 286 "seal.tab.c" /* yacc.c:355  */
-};
+#line 284 "seal-parse.cc"
 
+};
 typedef union YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
 # define YYSTYPE_IS_DECLARED 1
@@ -305,42 +303,219 @@ struct YYLTYPE
 #endif
 
 
-extern YYSTYPE seal_yylval;
-extern YYLTYPE seal_yylloc;
-int seal_yyparse (void);
 
-#endif /* !YY_SEAL_YY_SEAL_TAB_H_INCLUDED  */
 
-/* Copy the second part of user declarations.  */
+#ifndef YYPUSH_MORE_DEFINED
+# define YYPUSH_MORE_DEFINED
+enum { YYPUSH_MORE = 4 };
+#endif
+
+typedef struct seal_yypstate seal_yypstate;
+
 
-#line 317 "seal.tab.c" /* yacc.c:358  */
+int seal_yyparse (SealParse *parse);
+int seal_yypush_parse (seal_yypstate *ps,
+                  int pushed_char, YYSTYPE const *pushed_val, YYLTYPE *pushed_loc, SealParse *parse);
+int seal_yypull_parse (seal_yypstate *ps, SealParse *parse);
+seal_yypstate *seal_yypstate_new (void);
+void seal_yypstate_delete (seal_yypstate *ps);
+
+/* "%code provides" blocks.  */
+#line 110 "seal.y"
+
+    struct SealParse {
+      Program program;            /* the result, once the parse is accepted */
+      int errors;                 /* syntax and lexical errors reported */
+      bool lex_error;             /* the parse ended at a lexical error */
+      int token;                  /* the lookahead, for error messages */
+      YYSTYPE value;
+
+      SealParse() : program(NULL), errors(0), lex_error(false), token(0) { }
+    };
+
+    int seal_push_token(seal_yypstate *ps, int token, YYSTYPE *value,
+                        SourceLoc loc, SealParse *parse);
+    void seal_lex_error(SealParse *parse, const std::string &message);
+    
+
+#line 342 "seal-parse.cc"
+
+
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_IF = 3,                         /* IF  */
+  YYSYMBOL_ELSE = 4,                       /* ELSE  */
+  YYSYMBOL_WHILE = 5,                      /* WHILE  */
+  YYSYMBOL_FOR = 6,                        /* FOR  */
+  YYSYMBOL_BREAK = 7,                      /* BREAK  */
+  YYSYMBOL_CONTINUE = 8,                   /* CONTINUE  */
+  YYSYMBOL_FUNC = 9,                       /* FUNC  */
+  YYSYMBOL_RETURN = 10,                    /* RETURN  */
+  YYSYMBOL_VAR = 11,                       /* VAR  */
+  YYSYMBOL_ERROR = 12,                     /* ERROR  */
+  YYSYMBOL_AND = 13,                       /* AND  */
+  YYSYMBOL_OR = 14,                        /* OR  */
+  YYSYMBOL_EQUAL = 15,                     /* EQUAL  */
+  YYSYMBOL_NE = 16,                        /* NE  */
+  YYSYMBOL_GE = 17,                        /* GE  */
+  YYSYMBOL_LE = 18,                        /* LE  */
+  YYSYMBOL_INT = 19,                       /* INT  */
+  YYSYMBOL_STRING = 20,                    /* STRING  */
+  YYSYMBOL_BOOL = 21,                      /* BOOL  */
+  YYSYMBOL_FLOAT = 22,                     /* FLOAT  */
+  YYSYMBOL_CONST_BOOL = 23,                /* CONST_BOOL  */
+  YYSYMBOL_CONST_INT = 24,                 /* CONST_INT  */
+  YYSYMBOL_CONST_STRING = 25,              /* CONST_STRING  */
+  YYSYMBOL_CONST_FLOAT = 26,               /* CONST_FLOAT  */
+  YYSYMBOL_OBJECTID = 27,                  /* OBJECTID  */
+  YYSYMBOL_TYPEID = 28,                    /* TYPEID  */
+  YYSYMBOL_UMINUS = 29,                    /* UMINUS  */
+  YYSYMBOL_30_ = 30,                       /* '='  */
+  YYSYMBOL_31_ = 31,                       /* '<'  */
+  YYSYMBOL_32_ = 32,                       /* '>'  */
+  YYSYMBOL_33_ = 33,                       /* '+'  */
+  YYSYMBOL_34_ = 34,                       /* '-'  */
+  YYSYMBOL_35_ = 35,                       /* '*'  */
+  YYSYMBOL_36_ = 36,                       /* '/'  */
+  YYSYMBOL_37_ = 37,                       /* '%'  */
+  YYSYMBOL_38_ = 38,                       /* '!'  */
+  YYSYMBOL_39_ = 39,                       /* '~'  */
+  YYSYMBOL_40_ = 40,                       /* '&'  */
+  YYSYMBOL_41_ = 41,                       /* '|'  */
+  YYSYMBOL_42_ = 42,                       /* '^'  */
+  YYSYMBOL_43_ = 43,                       /* '.'  */
+  YYSYMBOL_44_ = 44,                       /* ';'  */
+  YYSYMBOL_45_ = 45,                       /* ','  */
+  YYSYMBOL_46_ = 46,                       /* '('  */
+  YYSYMBOL_47_ = 47,                       /* ')'  */
+  YYSYMBOL_48_ = 48,                       /* '{'  */
+  YYSYMBOL_49_ = 49,                       /* '}'  */
+  YYSYMBOL_YYACCEPT = 50,                  /* $accept  */
+  YYSYMBOL_program = 51,                   /* program  */
+  YYSYMBOL_decl = 52,                      /* decl  */
+  YYSYMBOL_decl_list = 53,                 /* decl_list  */
+  YYSYMBOL_variableDecl = 54,              /* variableDecl  */
+  YYSYMBOL_variableDecl_list = 55,         /* variableDecl_list  */
+  YYSYMBOL_variable = 56,                  /* variable  */
+  YYSYMBOL_variable_list = 57,             /* variable_list  */
+  YYSYMBOL_callDecl = 58,                  /* callDecl  */
+  YYSYMBOL_stmtBlock = 59,                 /* stmtBlock  */
+  YYSYMBOL_stmt = 60,                      /* stmt  */
+  YYSYMBOL_stmt_list = 61,                 /* stmt_list  */
+  YYSYMBOL_ifStmt = 62,                    /* ifStmt  */
+  YYSYMBOL_whileStmt = 63,                 /* whileStmt  */
+  YYSYMBOL_forStmt = 64,                   /* forStmt  */
+  YYSYMBOL_breakStmt = 65,                 /* breakStmt  */
+  YYSYMBOL_continueStmt = 66,              /* continueStmt  */
+  YYSYMBOL_returnStmt = 67,                /* returnStmt  */
+  YYSYMBOL_expr = 68,                      /* expr  */
+  YYSYMBOL_call = 69,                      /* call  */
+  YYSYMBOL_actual = 70,                    /* actual  */
+  YYSYMBOL_actual_list = 71                /* actual_list  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
+
+
+
+/* Unqualified %code blocks.  */
+#line 127 "seal.y"
+
+    void yyerror(YYLTYPE *loc, SealParse *parse, const char *s);
+    static int yylex(YYSTYPE *value, YYLTYPE *loc, SealParse *parse);
+    
+
+#line 433 "seal-parse.cc"
 
 #ifdef short
 # undef short
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
-#else
-typedef unsigned char yytype_uint8;
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
 #else
 typedef signed char yytype_int8;
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
 #else
-typedef unsigned short int yytype_uint16;
+typedef short yytype_int16;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
 #else
-typedef short int yytype_int16;
+typedef short yytype_uint8;
+#endif
+
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
+#else
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -348,15 +523,28 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_uint8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
 # if defined YYENABLE_NLS && YYENABLE_NLS
@@ -370,47 +558,43 @@ typedef short int yytype_int16;
 # endif
 #endif
 
-#ifndef YY_ATTRIBUTE
-# if (defined __GNUC__                                               \
-      && (2 < __GNUC__ || (__GNUC__ == 2 && 96 <= __GNUC_MINOR__)))  \
-     || defined __SUNPRO_C && 0x5110 <= __SUNPRO_C
-#  define YY_ATTRIBUTE(Spec) __attribute__(Spec)
-# else
-#  define YY_ATTRIBUTE(Spec) /* empty */
-# endif
-#endif
 
 #ifndef YY_ATTRIBUTE_PURE
-# define YY_ATTRIBUTE_PURE   YY_ATTRIBUTE ((__pure__))
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
 #endif
 
 #ifndef YY_ATTRIBUTE_UNUSED
-# define YY_ATTRIBUTE_UNUSED YY_ATTRIBUTE ((__unused__))
-#endif
-
-#if !defined _Noreturn \
-     && (!defined __STDC_VERSION__ || __STDC_VERSION__ < 201112)
-# if defined _MSC_VER && 1200 <= _MSC_VER
-#  define _Noreturn __declspec (noreturn)
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
 # else
-#  define _Noreturn YY_ATTRIBUTE ((__noreturn__))
+#  define YY_ATTRIBUTE_UNUSED
 # endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-#if defined __GNUC__ && 407 <= __GNUC__ * 100 + __GNUC_MINOR__
 /* Suppress an incorrect diagnostic about yylval being uninitialized.  */
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN \
-    _Pragma ("GCC diagnostic push") \
-    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")\
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
     _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
-# define YY_IGNORE_MAYBE_UNINITIALIZED_END \
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
     _Pragma ("GCC diagnostic pop")
 #else
 # define YY_INITIAL_VALUE(Value) Value
@@ -423,34 +607,24 @@ typedef short int yytype_int16;
 # define YY_INITIAL_VALUE(Value) /* Nothing. */
 #endif
 
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
 
-/* The parser invokes alloca or malloc; define the necessary symbols.  */
+#define YY_ASSERT(E) ((void) (0 && (E)))
 
-# ifdef YYSTACK_USE_ALLOCA
-#  if YYSTACK_USE_ALLOCA
-#   ifdef __GNUC__
-#    define YYSTACK_ALLOC __builtin_alloca
-#   elif defined __BUILTIN_VA_ARG_INCR
-#    include <alloca.h> /* INFRINGES ON USER NAME SPACE */
-#   elif defined _AIX
-#    define YYSTACK_ALLOC __alloca
-#   elif defined _MSC_VER
-#    include <malloc.h> /* INFRINGES ON USER NAME SPACE */
-#    define alloca _alloca
-#   else
-#    define YYSTACK_ALLOC alloca
-#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
-#     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
-#     ifndef EXIT_SUCCESS
-#      define EXIT_SUCCESS 0
-#     endif
-#    endif
-#   endif
-#  endif
-# endif
+#if !defined yyoverflow
+
+/* The parser invokes alloca or malloc; define the necessary symbols.  */
 
 # ifdef YYSTACK_ALLOC
    /* Pacify GCC's 'empty if-body' warning.  */
@@ -489,8 +663,7 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* !defined yyoverflow */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
@@ -500,18 +673,19 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss_alloc;
+  yy_state_t yyss_alloc;
   YYSTYPE yyvs_alloc;
   YYLTYPE yyls_alloc;
 };
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE) + sizeof (YYLTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE) \
+             + YYSIZEOF (YYLTYPE)) \
       + 2 * YYSTACK_GAP_MAXIMUM)
 
 # define YYCOPY_NEEDED 1
@@ -524,11 +698,11 @@ union yyalloc
 # define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
     do                                                                  \
       {                                                                 \
-        YYSIZE_T yynewbytes;                                            \
+        YYPTRDIFF_T yynewbytes;                                         \
         YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
         Stack = &yyptr->Stack_alloc;                                    \
-        yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-        yyptr += yynewbytes / sizeof (*yyptr);                          \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
       }                                                                 \
     while (0)
 
@@ -540,12 +714,12 @@ union yyalloc
 # ifndef YYCOPY
 #  if defined __GNUC__ && 1 < __GNUC__
 #   define YYCOPY(Dst, Src, Count) \
-      __builtin_memcpy (Dst, Src, (Count) * sizeof (*(Src)))
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
 #  else
 #   define YYCOPY(Dst, Src, Count)              \
       do                                        \
         {                                       \
-          YYSIZE_T yyi;                         \
+          YYPTRDIFF_T yyi;                      \
           for (yyi = 0; yyi < (Count); yyi++)   \
             (Dst)[yyi] = (Src)[yyi];            \
         }                                       \
@@ -568,17 +742,20 @@ union yyalloc
 /* YYNSTATES -- Number of states.  */
 #define YYNSTATES  139
 
-/* YYTRANSLATE[YYX] -- Symbol number corresponding to YYX as returned
-   by yylex, with out-of-bounds checking.  */
-#define YYUNDEFTOK  2
-#define YYMAXUTOK   287
+/* YYMAXUTOK -- Last valid token kind.  */
+#define YYMAXUTOK   288
 
-#define YYTRANSLATE(YYX)                                                \
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
 
 /* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
-   as returned by yylex, without out-of-bounds checking.  */
-static const yytype_uint8 yytranslate[] =
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -608,67 +785,68 @@ static const yytype_uint8 yytranslate[] =
        2,     2,     2,     2,     2,     2,     1,     2,     3,     2,
        4,     5,     6,     7,     8,     9,    10,    23,    24,    25,
       26,    11,     2,    12,    13,    14,    15,    16,    17,    18,
-      19,    20,    21,    22,    27,    28,     2,    29
+      19,    20,    21,    22,    27,    28,     2,    29,     2
 };
 
 #if YYDEBUG
-  /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
-static const yytype_uint16 yyrline[] =
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
 {
-       0,   186,   186,   191,   194,   199,   202,   208,   213,   216,
-     221,   225,   228,   231,   237,   242,   245,   248,   251,   256,
-     259,   262,   265,   268,   271,   274,   277,   280,   285,   288,
-     293,   296,   301,   306,   309,   312,   315,   318,   321,   324,
-     327,   332,   337,   342,   345,   350,   353,   356,   359,   362,
-     365,   368,   371,   374,   377,   380,   383,   386,   389,   392,
-     395,   398,   401,   404,   407,   410,   413,   416,   419,   422,
-     425,   428,   433,   438,   442,   445,   448
+       0,   221,   221,   227,   230,   235,   238,   244,   249,   252,
+     257,   262,   265,   268,   274,   279,   282,   285,   288,   293,
+     296,   299,   302,   305,   308,   311,   314,   317,   322,   325,
+     330,   333,   338,   343,   346,   349,   352,   355,   358,   361,
+     364,   369,   374,   379,   382,   387,   390,   393,   396,   399,
+     402,   405,   408,   411,   414,   417,   420,   423,   426,   429,
+     432,   435,   438,   441,   444,   447,   450,   453,   456,   459,
+     462,   465,   470,   475,   480,   483,   486
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || 0
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "IF", "ELSE", "WHILE", "FOR", "BREAK",
-  "CONTINUE", "FUNC", "RETURN", "VAR", "ERROR", "AND", "OR", "EQUAL", "NE",
-  "GE", "LE", "INT", "STRING", "BOOL", "FLOAT", "CONST_BOOL", "CONST_INT",
-  "CONST_STRING", "CONST_FLOAT", "OBJECTID", "TYPEID", "UMINUS", "'='",
-  "'<'", "'>'", "'+'", "'-'", "'*'", "'/'", "'%'", "'!'", "'~'", "'&'",
-  "'|'", "'^'", "'.'", "';'", "','", "'('", "')'", "'{'", "'}'", "$accept",
-  "program", "decl", "decl_list", "variableDecl", "variableDecl_list",
-  "variable", "variable_list", "callDecl", "stmtBlock", "stmt",
-  "stmt_list", "ifStmt", "whileStmt", "forStmt", "breakStmt",
-  "continueStmt", "returnStmt", "expr", "call", "actual", "actual_list", YY_NULLPTR
+  "\"end of file\"", "error", "\"invalid token\"", "IF", "ELSE", "WHILE",
+  "FOR", "BREAK", "CONTINUE", "FUNC", "RETURN", "VAR", "ERROR", "AND",
+  "OR", "EQUAL", "NE", "GE", "LE", "INT", "STRING", "BOOL", "FLOAT",
+  "CONST_BOOL", "CONST_INT", "CONST_STRING", "CONST_FLOAT", "OBJECTID",
+  "TYPEID", "UMINUS", "'='", "'<'", "'>'", "'+'", "'-'", "'*'", "'/'",
+  "'%'", "'!'", "'~'", "'&'", "'|'", "'^'", "'.'", "';'", "','", "'('",
+  "')'", "'{'", "'}'", "$accept", "program", "decl", "decl_list",
+  "variableDecl", "variableDecl_list", "variable", "variable_list",
+  "callDecl", "stmtBlock", "stmt", "stmt_list", "ifStmt", "whileStmt",
+  "forStmt", "breakStmt", "continueStmt", "returnStmt", "expr", "call",
+  "actual", "actual_list", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[NUM] -- (External) token number corresponding to the
-   (internal) symbol number NUM (which must be that of a token).  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   286,   258,   260,   261,   262,   263,   264,   265,
-     266,   271,   273,   274,   275,   276,   277,   278,   279,   280,
-     281,   282,   283,   267,   268,   269,   270,   284,   285,   287,
-      61,    60,    62,    43,    45,    42,    47,    37,    33,   126,
-      38,   124,    94,    46,    59,    44,    40,    41,   123,   125
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-#define YYPACT_NINF -55
+#define YYPACT_NINF (-55)
 
-#define yypact_value_is_default(Yystate) \
-  (!!((Yystate) == (-55)))
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
 
-#define YYTABLE_NINF -1
+#define YYTABLE_NINF (-1)
 
-#define yytable_value_is_error(Yytable_value) \
-  (!!((Yytable_value) == (-1)))
+#define yytable_value_is_error(Yyn) \
+  ((Yyn) == YYTABLE_NINF)
 
-  /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-     STATE-NUM.  */
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
 static const yytype_int16 yypact[] =
 {
        0,   -26,   -12,    36,   -55,     0,   -55,   -55,    -8,    13,
@@ -687,10 +865,10 @@ static const yytype_int16 yypact[] =
      -55,   290,     1,   -55,   -55,   -55,   -55,   290,   -55
 };
 
-  /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
-     Performed when YYTABLE does not specify something else to do.  Zero
-     means the default is an error.  */
-static const yytype_uint8 yydefact[] =
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
+static const yytype_int8 yydefact[] =
 {
        0,     0,     0,     0,     5,     2,     3,     4,     0,     0,
        0,     1,     6,    11,    10,     7,    12,     0,     0,     0,
@@ -708,7 +886,7 @@ static const yytype_uint8 yydefact[] =
       39,     0,     0,    76,    34,    35,    36,     0,    33
 };
 
-  /* YYPGOTO[NTERM-NUM].  */
+/* YYPGOTO[NTERM-NUM].  */
 static const yytype_int8 yypgoto[] =
 {
      -55,   -55,    47,   -55,   -20,   -55,    -5,   -55,   -55,   -21,
@@ -716,17 +894,17 @@ static const yytype_int8 yypgoto[] =
      -54,   -55
 };
 
-  /* YYDEFGOTO[NTERM-NUM].  */
+/* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_int8 yydefgoto[] =
 {
-      -1,     3,     4,     5,     6,    42,    10,    17,     7,    43,
+       0,     3,     4,     5,     6,    42,    10,    17,     7,    43,
       44,    45,    46,    47,    48,    49,    50,    51,    52,    53,
       98,    99
 };
 
-  /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
-     positive, shift that token.  If negative, reduce the rule whose
-     number is the opposite.  If YYTABLE_NINF, syntax error.  */
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_int16 yytable[] =
 {
       23,     8,    41,    62,    72,    54,    55,    57,    16,     1,
@@ -875,9 +1053,9 @@ static const yytype_int16 yycheck[] =
       44,    -1,    46
 };
 
-  /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-     symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
 {
        0,     9,    11,    51,    52,    53,    54,    58,    27,    27,
       56,     0,    52,    46,    28,    44,    56,    57,    45,    47,
@@ -895,8 +1073,8 @@ static const yytype_uint8 yystos[] =
       59,    68,    44,    70,    59,    59,    59,    68,    59
 };
 
-  /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
 {
        0,    50,    51,    52,    52,    53,    53,    54,    55,    55,
       56,    57,    57,    57,    58,    59,    59,    59,    59,    60,
@@ -908,8 +1086,8 @@ static const yytype_uint8 yyr1[] =
       68,    68,    69,    70,    71,    71,    71
 };
 
-  /* YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
 {
        0,     2,     1,     1,     1,     1,     2,     3,     1,     2,
        2,     0,     1,     3,     7,     4,     3,     3,     2,     1,
@@ -922,39 +1100,39 @@ static const yytype_uint8 yyr2[] =
 };
 
 
+enum { YYENOMEM = -2 };
+
 #define yyerrok         (yyerrstatus = 0)
 #define yyclearin       (yychar = YYEMPTY)
-#define YYEMPTY         (-2)
-#define YYEOF           0
 
 #define YYACCEPT        goto yyacceptlab
 #define YYABORT         goto yyabortlab
 #define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
 
 #define YYRECOVERING()  (!!yyerrstatus)
 
-#define YYBACKUP(Token, Value)                                  \
-do                                                              \
-  if (yychar == YYEMPTY)                                        \
-    {                                                           \
-      yychar = (Token);                                         \
-      yylval = (Value);                                         \
-      YYPOPSTACK (yylen);                                       \
-      yystate = *yyssp;                                         \
-      goto yybackup;                                            \
-    }                                                           \
-  else                                                          \
-    {                                                           \
-      yyerror (YY_("syntax error: cannot back up")); \
-      YYERROR;                                                  \
-    }                                                           \
-while (0)
-
-/* Error token number */
-#define YYTERROR        1
-#define YYERRCODE       256
-
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (&yylloc, parse, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
 /* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
    If N is 0, then set CURRENT to the empty location which ends
@@ -998,20 +1176,27 @@ do {                                            \
 } while (0)
 
 
-/* YY_LOCATION_PRINT -- Print the location on the stream.
+/* YYLOCATION_PRINT -- Print the location on the stream.
    This macro was not mandated originally: define only if we know
    we won't break user code: when these are the locations we know.  */
 
-#ifndef YY_LOCATION_PRINT
-# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+# ifndef YYLOCATION_PRINT
+
+#  if defined YY_LOCATION_PRINT
+
+   /* Temporary convenience wrapper in case some people defined the
+      undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YYLOCATION_PRINT(File, Loc)  YY_LOCATION_PRINT(File, *(Loc))
+
+#  elif defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
 
 /* Print *YYLOCP on YYO.  Private, do not rely on its existence. */
 
 YY_ATTRIBUTE_UNUSED
-static unsigned
+static int
 yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
 {
-  unsigned res = 0;
+  int res = 0;
   int end_col = 0 != yylocp->last_column ? yylocp->last_column - 1 : 0;
   if (0 <= yylocp->first_line)
     {
@@ -1031,63 +1216,72 @@ yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
         res += YYFPRINTF (yyo, "-%d", end_col);
     }
   return res;
- }
+}
 
-#  define YY_LOCATION_PRINT(File, Loc)          \
-  yy_location_print_ (File, &(Loc))
+#   define YYLOCATION_PRINT  yy_location_print_
 
-# else
-#  define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-# endif
-#endif
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT(File, Loc)  YYLOCATION_PRINT(File, &(Loc))
+
+#  else
 
+#   define YYLOCATION_PRINT(File, Loc) ((void) 0)
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT  YYLOCATION_PRINT
 
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)                    \
+#  endif
+# endif /* !defined YYLOCATION_PRINT */
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
 do {                                                                      \
   if (yydebug)                                                            \
     {                                                                     \
       YYFPRINTF (stderr, "%s ", Title);                                   \
       yy_symbol_print (stderr,                                            \
-                  Type, Value, Location); \
+                  Kind, Value, Location, parse); \
       YYFPRINTF (stderr, "\n");                                           \
     }                                                                     \
 } while (0)
 
 
-/*----------------------------------------.
-| Print this symbol's value on YYOUTPUT.  |
-`----------------------------------------*/
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
 
 static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, SealParse *parse)
 {
-  FILE *yyo = yyoutput;
-  YYUSE (yyo);
-  YYUSE (yylocationp);
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (yylocationp);
+  YY_USE (parse);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# endif
-  YYUSE (yytype);
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
 
 static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp)
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, SealParse *parse)
 {
-  YYFPRINTF (yyoutput, "%s %s (",
-             yytype < YYNTOKENS ? "token" : "nterm", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  YY_LOCATION_PRINT (yyoutput, *yylocationp);
-  YYFPRINTF (yyoutput, ": ");
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep, yylocationp);
-  YYFPRINTF (yyoutput, ")");
+  YYLOCATION_PRINT (yyo, yylocationp);
+  YYFPRINTF (yyo, ": ");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, yylocationp, parse);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -1096,7 +1290,7 @@ yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, YYL
 `------------------------------------------------------------------*/
 
 static void
-yy_stack_print (yytype_int16 *yybottom, yytype_int16 *yytop)
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
   for (; yybottom <= yytop; yybottom++)
@@ -1119,21 +1313,22 @@ do {                                                            \
 `------------------------------------------------*/
 
 static void
-yy_reduce_print (yytype_int16 *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp, int yyrule)
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp,
+                 int yyrule, SealParse *parse)
 {
-  unsigned long int yylno = yyrline[yyrule];
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
              yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
       yy_symbol_print (stderr,
-                       yystos[yyssp[yyi + 1 - yynrhs]],
-                       &(yyvsp[(yyi + 1) - (yynrhs)])
-                       , &(yylsp[(yyi + 1) - (yynrhs)])                       );
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)],
+                       &(yylsp[(yyi + 1) - (yynrhs)]), parse);
       YYFPRINTF (stderr, "\n");
     }
 }
@@ -1141,15 +1336,15 @@ yy_reduce_print (yytype_int16 *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp, int yyrule
 # define YY_REDUCE_PRINT(Rule)          \
 do {                                    \
   if (yydebug)                          \
-    yy_reduce_print (yyssp, yyvsp, yylsp, Rule); \
+    yy_reduce_print (yyssp, yyvsp, yylsp, Rule, parse); \
 } while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
@@ -1170,320 +1365,214 @@ int yydebug;
 #ifndef YYMAXDEPTH
 # define YYMAXDEPTH 10000
 #endif
+/* Parser data structure.  */
+struct yypstate
+  {
+    /* Number of syntax errors so far.  */
+    int yynerrs;
 
+    yy_state_fast_t yystate;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus;
 
-#if YYERROR_VERBOSE
-
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
-/* Return the length of YYSTR.  */
-static YYSIZE_T
-yystrlen (const char *yystr)
-{
-  YYSIZE_T yylen;
-  for (yylen = 0; yystr[yylen]; yylen++)
-    continue;
-  return yylen;
-}
-#  endif
-# endif
-
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
-/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
-   YYDEST.  */
-static char *
-yystpcpy (char *yydest, const char *yysrc)
-{
-  char *yyd = yydest;
-  const char *yys = yysrc;
-
-  while ((*yyd++ = *yys++) != '\0')
-    continue;
-
-  return yyd - 1;
-}
-#  endif
-# endif
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
 
-# ifndef yytnamerr
-/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
-   quotes and backslashes, so that it's suitable for yyerror.  The
-   heuristic is that double-quoting is unnecessary unless the string
-   contains an apostrophe, a comma, or backslash (other than
-   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
-   null, do not copy; instead, return the length of what the result
-   would have been.  */
-static YYSIZE_T
-yytnamerr (char *yyres, const char *yystr)
-{
-  if (*yystr == '"')
-    {
-      YYSIZE_T yyn = 0;
-      char const *yyp = yystr;
-
-      for (;;)
-        switch (*++yyp)
-          {
-          case '\'':
-          case ',':
-            goto do_not_strip_quotes;
-
-          case '\\':
-            if (*++yyp != '\\')
-              goto do_not_strip_quotes;
-            /* Fall through.  */
-          default:
-            if (yyres)
-              yyres[yyn] = *yyp;
-            yyn++;
-            break;
-
-          case '"':
-            if (yyres)
-              yyres[yyn] = '\0';
-            return yyn;
-          }
-    do_not_strip_quotes: ;
-    }
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize;
 
-  if (! yyres)
-    return yystrlen (yystr);
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss;
+    yy_state_t *yyssp;
 
-  return yystpcpy (yyres, yystr) - yyres;
-}
-# endif
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs;
+    YYSTYPE *yyvsp;
 
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.
+    /* The location stack: array, bottom, top.  */
+    YYLTYPE yylsa[YYINITDEPTH];
+    YYLTYPE *yyls;
+    YYLTYPE *yylsp;
+    /* Whether this instance has not started parsing yet.
+     * If 2, it corresponds to a finished parsing.  */
+    int yynew;
+  };
 
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store.  */
-static int
-yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
-                yytype_int16 *yyssp, int yytoken)
-{
-  YYSIZE_T yysize0 = yytnamerr (YY_NULLPTR, yytname[yytoken]);
-  YYSIZE_T yysize = yysize0;
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = YY_NULLPTR;
-  /* Arguments of yyformat. */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-  /* Number of reported tokens (one for the "unexpected", one per
-     "expected"). */
-  int yycount = 0;
-
-  /* There are many possibilities here to consider:
-     - If this state is a consistent state with a default action, then
-       the only way this function was invoked is if the default action
-       is an error action.  In that case, don't check for expected
-       tokens because there are none.
-     - The only way there can be no lookahead present (in yychar) is if
-       this state is a consistent state with a default action.  Thus,
-       detecting the absence of a lookahead is sufficient to determine
-       that there is no unexpected or expected token to report.  In that
-       case, just report a simple "syntax error".
-     - Don't assume there isn't a lookahead just because this state is a
-       consistent state with a default action.  There might have been a
-       previous inconsistent state, consistent state with a non-default
-       action, or user semantic action that manipulated yychar.
-     - Of course, the expected token list depends on states to have
-       correct lookahead information, and it depends on the parser not
-       to perform extra reductions after fetching a lookahead from the
-       scanner and before detecting a syntax error.  Thus, state merging
-       (from LALR or IELR) and default reductions corrupt the expected
-       token list.  However, the list is correct for canonical LR with
-       one exception: it will still contain any token that will not be
-       accepted due to an error action in a later state.
-  */
-  if (yytoken != YYEMPTY)
-    {
-      int yyn = yypact[*yyssp];
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          /* Start YYX at -YYN if negative to avoid negative indexes in
-             YYCHECK.  In other words, skip the first -YYN actions for
-             this state because they are default actions.  */
-          int yyxbegin = yyn < 0 ? -yyn : 0;
-          /* Stay within bounds of both yycheck and yytname.  */
-          int yychecklim = YYLAST - yyn + 1;
-          int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-          int yyx;
-
-          for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR
-                && !yytable_value_is_error (yytable[yyx + yyn]))
-              {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                {
-                  YYSIZE_T yysize1 = yysize + yytnamerr (YY_NULLPTR, yytname[yyx]);
-                  if (! (yysize <= yysize1
-                         && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-                    return 2;
-                  yysize = yysize1;
-                }
-              }
-        }
-    }
 
-  switch (yycount)
-    {
-# define YYCASE_(N, S)                      \
-      case N:                               \
-        yyformat = S;                       \
-      break
-      YYCASE_(0, YY_("syntax error"));
-      YYCASE_(1, YY_("syntax error, unexpected %s"));
-      YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
-      YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
-      YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
-      YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
-    }
 
-  {
-    YYSIZE_T yysize1 = yysize + yystrlen (yyformat);
-    if (! (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-      return 2;
-    yysize = yysize1;
-  }
 
-  if (*yymsg_alloc < yysize)
-    {
-      *yymsg_alloc = 2 * yysize;
-      if (! (yysize <= *yymsg_alloc
-             && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
-        *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
-    }
 
-  /* Avoid sprintf, as that infringes on the user's name space.
-     Don't have undefined behavior even if the translation
-     produced a string with the wrong number of "%s"s.  */
-  {
-    char *yyp = *yymsg;
-    int yyi = 0;
-    while ((*yyp = *yyformat) != '\0')
-      if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
-        {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
-          yyformat += 2;
-        }
-      else
-        {
-          yyp++;
-          yyformat++;
-        }
-  }
-  return 0;
-}
-#endif /* YYERROR_VERBOSE */
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, YYLTYPE *yylocationp)
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, YYLTYPE *yylocationp, SealParse *parse)
 {
-  YYUSE (yyvaluep);
-  YYUSE (yylocationp);
+  YY_USE (yyvaluep);
+  YY_USE (yylocationp);
+  YY_USE (parse);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
 
 
-/* The lookahead symbol.  */
-int yychar;
 
-/* The semantic value of the lookahead symbol.  */
-YYSTYPE yylval;
-/* Location data for the lookahead symbol.  */
-YYLTYPE yylloc
+int
+yyparse (SealParse *parse)
+{
+  yypstate *yyps = yypstate_new ();
+  if (!yyps)
+    {
+      static YYLTYPE yyloc_default
+# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+  = { 1, 1, 1, 1 }
+# endif
+;
+      YYLTYPE yylloc = yyloc_default;
+      yyerror (&yylloc, parse, YY_("memory exhausted"));
+      return 2;
+    }
+  int yystatus = yypull_parse (yyps, parse);
+  yypstate_delete (yyps);
+  return yystatus;
+}
+
+int
+yypull_parse (yypstate *yyps, SealParse *parse)
+{
+  YY_ASSERT (yyps);
+  static YYLTYPE yyloc_default
 # if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
   = { 1, 1, 1, 1 }
 # endif
 ;
-/* Number of syntax errors so far.  */
-int yynerrs;
+  YYLTYPE yylloc = yyloc_default;
+  int yystatus;
+  do {
+    YYSTYPE yylval;
+    int yychar = yylex (&yylval, &yylloc, parse);
+    yystatus = yypush_parse (yyps, yychar, &yylval, &yylloc, parse);
+  } while (yystatus == YYPUSH_MORE);
+  return yystatus;
+}
+
+#define seal_yynerrs yyps->seal_yynerrs
+#define yystate yyps->yystate
+#define yyerrstatus yyps->yyerrstatus
+#define yyssa yyps->yyssa
+#define yyss yyps->yyss
+#define yyssp yyps->yyssp
+#define yyvsa yyps->yyvsa
+#define yyvs yyps->yyvs
+#define yyvsp yyps->yyvsp
+#define yylsa yyps->yylsa
+#define yyls yyps->yyls
+#define yylsp yyps->yylsp
+#define yystacksize yyps->yystacksize
+
+/* Initialize the parser data structure.  */
+static void
+yypstate_clear (yypstate *yyps)
+{
+  yynerrs = 0;
+  yystate = 0;
+  yyerrstatus = 0;
 
+  yyssp = yyss;
+  yyvsp = yyvs;
+  yylsp = yyls;
 
-/*----------.
-| yyparse.  |
-`----------*/
+  /* Initialize the state stack, in case yypcontext_expected_tokens is
+     called before the first call to yyparse. */
+  *yyssp = 0;
+  yyps->yynew = 1;
+}
 
-int
-yyparse (void)
+/* Initialize the parser data structure.  */
+yypstate *
+yypstate_new (void)
 {
-    int yystate;
-    /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
+  yypstate *yyps;
+  yyps = YY_CAST (yypstate *, YYMALLOC (sizeof *yyps));
+  if (!yyps)
+    return YY_NULLPTR;
+  yystacksize = YYINITDEPTH;
+  yyss = yyssa;
+  yyvs = yyvsa;
+  yyls = yylsa;
+  yypstate_clear (yyps);
+  return yyps;
+}
 
-    /* The stacks and their tools:
-       'yyss': related to states.
-       'yyvs': related to semantic values.
-       'yyls': related to locations.
+void
+yypstate_delete (yypstate *yyps)
+{
+  if (yyps)
+    {
+#ifndef yyoverflow
+      /* If the stack was reallocated but the parse did not complete, then the
+         stack still needs to be freed.  */
+      if (yyss != yyssa)
+        YYSTACK_FREE (yyss);
+#endif
+      YYFREE (yyps);
+    }
+}
 
-       Refer to the stacks through separate pointers, to allow yyoverflow
-       to reallocate them elsewhere.  */
 
-    /* The state stack.  */
-    yytype_int16 yyssa[YYINITDEPTH];
-    yytype_int16 *yyss;
-    yytype_int16 *yyssp;
 
-    /* The semantic value stack.  */
-    YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+/*---------------.
+| yypush_parse.  |
+`---------------*/
+
+int
+yypush_parse (yypstate *yyps,
+              int yypushed_char, YYSTYPE const *yypushed_val, YYLTYPE *yypushed_loc, SealParse *parse)
+{
+/* Lookahead token kind.  */
+int yychar;
 
-    /* The location stack.  */
-    YYLTYPE yylsa[YYINITDEPTH];
-    YYLTYPE *yyls;
-    YYLTYPE *yylsp;
 
-    /* The locations where the error started and ended.  */
-    YYLTYPE yyerror_range[3];
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
 
-    YYSIZE_T yystacksize;
+/* Location data for the lookahead symbol.  */
+static YYLTYPE yyloc_default
+# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+  = { 1, 1, 1, 1 }
+# endif
+;
+YYLTYPE yylloc = yyloc_default;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken = 0;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
   YYLTYPE yyloc;
 
-#if YYERROR_VERBOSE
-  /* Buffer for error messages, and its allocated size.  */
-  char yymsgbuf[128];
-  char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+  /* The locations where the error started and ended.  */
+  YYLTYPE yyerror_range[3];
+
+
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N), yylsp -= (N))
 
@@ -1491,43 +1580,63 @@ yyparse (void)
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yyssp = yyss = yyssa;
-  yyvsp = yyvs = yyvsa;
-  yylsp = yyls = yylsa;
-  yystacksize = YYINITDEPTH;
+  switch (yyps->yynew)
+    {
+    case 0:
+      yyn = yypact[yystate];
+      goto yyread_pushed_token;
+
+    case 2:
+      yypstate_clear (yyps);
+      break;
+
+    default:
+      break;
+    }
 
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
-  yylsp[0] = yylloc;
+
+  yylsp[0] = *yypushed_loc;
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
         /* Give user a chance to reallocate the stack.  Use copies of
            these so that the &'s don't force the real ones into
            memory.  */
+        yy_state_t *yyss1 = yyss;
         YYSTYPE *yyvs1 = yyvs;
-        yytype_int16 *yyss1 = yyss;
         YYLTYPE *yyls1 = yyls;
 
         /* Each stack pointer address is followed by the size of the
@@ -1535,32 +1644,29 @@ yyparse (void)
            conditional around just the two extra args, but that might
            be undefined if yyoverflow is a macro.  */
         yyoverflow (YY_("memory exhausted"),
-                    &yyss1, yysize * sizeof (*yyssp),
-                    &yyvs1, yysize * sizeof (*yyvsp),
-                    &yyls1, yysize * sizeof (*yylsp),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yyls1, yysize * YYSIZEOF (*yylsp),
                     &yystacksize);
-
-        yyls = yyls1;
         yyss = yyss1;
         yyvs = yyvs1;
+        yyls = yyls1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-        goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
         yystacksize = YYMAXDEPTH;
 
       {
-        yytype_int16 *yyss1 = yyss;
+        yy_state_t *yyss1 = yyss;
         union yyalloc *yyptr =
-          (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
         if (! yyptr)
-          goto yyexhaustedlab;
+          YYNOMEM;
         YYSTACK_RELOCATE (yyss_alloc, yyss);
         YYSTACK_RELOCATE (yyvs_alloc, yyvs);
         YYSTACK_RELOCATE (yyls_alloc, yyls);
@@ -1569,31 +1675,32 @@ yyparse (void)
           YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
       yylsp = yyls + yysize - 1;
 
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-                  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
         YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
 
   if (yystate == YYFINAL)
     YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
      lookahead token if we need one and don't already have one.  */
 
@@ -1604,18 +1711,42 @@ yybackup:
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = yylex ();
+      if (!yyps->yynew)
+        {
+          YYDPRINTF ((stderr, "Return for a new token:\n"));
+          yyresult = YYPUSH_MORE;
+          goto yypushreturn;
+        }
+      yyps->yynew = 0;
+yyread_pushed_token:
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yypushed_char;
+      if (yypushed_val)
+        yylval = *yypushed_val;
+      if (yypushed_loc)
+        yylloc = *yypushed_loc;
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      yyerror_range[1] = yylloc;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1643,15 +1774,14 @@ yybackup:
 
   /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token.  */
-  yychar = YYEMPTY;
-
   yystate = yyn;
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
   YY_IGNORE_MAYBE_UNINITIALIZED_END
   *++yylsp = yylloc;
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -1666,7 +1796,7 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
@@ -1682,614 +1812,616 @@ yyreduce:
      GCC warning that YYVAL may be used uninitialized.  */
   yyval = yyvsp[1-yylen];
 
-  /* Default location.  */
+  /* Default location. */
   YYLLOC_DEFAULT (yyloc, (yylsp - yylen), yylen);
+  yyerror_range[1] = yyloc;
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 2:
-#line 186 "seal.y" /* yacc.c:1646  */
-    {
+  case 2: /* program: decl_list  */
+#line 221 "seal.y"
+                                {
 					(yyloc) = (yylsp[0]);
-					ast_root = program((yyvsp[0].decls)); 
+					parse->program = program((yyvsp[0].decls));
 				}
-#line 1697 "seal.tab.c" /* yacc.c:1646  */
+#line 1828 "seal-parse.cc"
     break;
 
-  case 3:
-#line 191 "seal.y" /* yacc.c:1646  */
-    {
+  case 3: /* decl: variableDecl  */
+#line 227 "seal.y"
+                                {
 					(yyval.decl) = (yyvsp[0].variableDecl);
 				}
-#line 1705 "seal.tab.c" /* yacc.c:1646  */
+#line 1836 "seal-parse.cc"
     break;
 
-  case 4:
-#line 194 "seal.y" /* yacc.c:1646  */
-    {
+  case 4: /* decl: callDecl  */
+#line 230 "seal.y"
+                                        {
 					(yyval.decl) = (yyvsp[0].callDecl);
 				}
-#line 1713 "seal.tab.c" /* yacc.c:1646  */
+#line 1844 "seal-parse.cc"
     break;
 
-  case 5:
-#line 199 "seal.y" /* yacc.c:1646  */
-    { 
+  case 5: /* decl_list: decl  */
+#line 235 "seal.y"
+                        {
 					(yyval.decls) = single_Decls((yyvsp[0].decl));
 				}
-#line 1721 "seal.tab.c" /* yacc.c:1646  */
+#line 1852 "seal-parse.cc"
     break;
 
-  case 6:
-#line 202 "seal.y" /* yacc.c:1646  */
-    { 
-					(yyval.decls) = append_Decls((yyvsp[-1].decls), single_Decls((yyvsp[0].decl))); 
+  case 6: /* decl_list: decl_list decl  */
+#line 238 "seal.y"
+                                                {
+					(yyval.decls) = append_Decls((yyvsp[-1].decls), single_Decls((yyvsp[0].decl)));
 				}
-#line 1729 "seal.tab.c" /* yacc.c:1646  */
+#line 1860 "seal-parse.cc"
     break;
 
-  case 7:
-#line 208 "seal.y" /* yacc.c:1646  */
-    {
+  case 7: /* variableDecl: VAR variable ';'  */
+#line 244 "seal.y"
+                                        {
 					(yyval.variableDecl) = variableDecl((yyvsp[-1].variable));
 				}
-#line 1737 "seal.tab.c" /* yacc.c:1646  */
+#line 1868 "seal-parse.cc"
     break;
 
-  case 8:
-#line 213 "seal.y" /* yacc.c:1646  */
-    { 
+  case 8: /* variableDecl_list: variableDecl  */
+#line 249 "seal.y"
+                                        {
 					(yyval.variableDecls) = single_VariableDecls((yyvsp[0].variableDecl));
 				}
-#line 1745 "seal.tab.c" /* yacc.c:1646  */
+#line 1876 "seal-parse.cc"
     break;
 
-  case 9:
-#line 216 "seal.y" /* yacc.c:1646  */
-    { 
-					(yyval.variableDecls) = append_VariableDecls((yyvsp[-1].variableDecls), single_VariableDecls((yyvsp[0].variableDecl))); 
+  case 9: /* variableDecl_list: variableDecl_list variableDecl  */
+#line 252 "seal.y"
+                                                                {
+					(yyval.variableDecls) = append_VariableDecls((yyvsp[-1].variableDecls), single_VariableDecls((yyvsp[0].variableDecl)));
 				}
-#line 1753 "seal.tab.c" /* yacc.c:1646  */
+#line 1884 "seal-parse.cc"
     break;
 
-  case 10:
-#line 221 "seal.y" /* yacc.c:1646  */
-    {
+  case 10: /* variable: OBJECTID TYPEID  */
+#line 257 "seal.y"
+                                        {
 					(yyval.variable) = variable((yyvsp[-1].symbol), (yyvsp[0].symbol));
 				}
-#line 1761 "seal.tab.c" /* yacc.c:1646  */
+#line 1892 "seal-parse.cc"
     break;
 
-  case 11:
-#line 225 "seal.y" /* yacc.c:1646  */
-    {
+  case 11: /* variable_list: %empty  */
+#line 262 "seal.y"
+                        {
 					(yyval.variables) = nil_Variables();
 				}
-#line 1769 "seal.tab.c" /* yacc.c:1646  */
+#line 1900 "seal-parse.cc"
     break;
 
-  case 12:
-#line 228 "seal.y" /* yacc.c:1646  */
-    { 
+  case 12: /* variable_list: variable  */
+#line 265 "seal.y"
+                                        {
 					(yyval.variables) = single_Variables((yyvsp[0].variable));
 				}
-#line 1777 "seal.tab.c" /* yacc.c:1646  */
+#line 1908 "seal-parse.cc"
     break;
 
-  case 13:
-#line 231 "seal.y" /* yacc.c:1646  */
-    {
+  case 13: /* variable_list: variable_list ',' variable  */
+#line 268 "seal.y"
+                                                        {
 					(yyval.variables) = append_Variables((yyvsp[-2].variables), single_Variables((yyvsp[0].variable)));
 				}
-#line 1785 "seal.tab.c" /* yacc.c:1646  */
+#line 1916 "seal-parse.cc"
     break;
 
-  case 14:
-#line 237 "seal.y" /* yacc.c:1646  */
-    {
+  case 14: /* callDecl: FUNC OBJECTID '(' variable_list ')' TYPEID stmtBlock  */
+#line 274 "seal.y"
+                                                                        {
 					(yyval.callDecl) = callDecl((yyvsp[-5].symbol), (yyvsp[-3].variables), (yyvsp[-1].symbol), (yyvsp[0].stmtBlock));
 				}
-#line 1793 "seal.tab.c" /* yacc.c:1646  */
+#line 1924 "seal-parse.cc"
     break;
 
-  case 15:
-#line 242 "seal.y" /* yacc.c:1646  */
-    {
+  case 15: /* stmtBlock: '{' variableDecl_list stmt_list '}'  */
+#line 279 "seal.y"
+                                                        {
 					(yyval.stmtBlock) = stmtBlock((yyvsp[-2].variableDecls), (yyvsp[-1].stmts));
 				}
-#line 1801 "seal.tab.c" /* yacc.c:1646  */
+#line 1932 "seal-parse.cc"
     break;
 
-  case 16:
-#line 245 "seal.y" /* yacc.c:1646  */
-    {
+  case 16: /* stmtBlock: '{' stmt_list '}'  */
+#line 282 "seal.y"
+                                                {
 					(yyval.stmtBlock) = stmtBlock(nil_VariableDecls(), (yyvsp[-1].stmts));
 				}
-#line 1809 "seal.tab.c" /* yacc.c:1646  */
+#line 1940 "seal-parse.cc"
     break;
 
-  case 17:
-#line 248 "seal.y" /* yacc.c:1646  */
-    {
+  case 17: /* stmtBlock: '{' variableDecl_list '}'  */
+#line 285 "seal.y"
+                                                        {
 					(yyval.stmtBlock) = stmtBlock((yyvsp[-1].variableDecls), nil_Stmts());
 				}
-#line 1817 "seal.tab.c" /* yacc.c:1646  */
+#line 1948 "seal-parse.cc"
     break;
 
-  case 18:
-#line 251 "seal.y" /* yacc.c:1646  */
-    {
+  case 18: /* stmtBlock: '{' '}'  */
+#line 288 "seal.y"
+                                        {
 					(yyval.stmtBlock) = stmtBlock(nil_VariableDecls(), nil_Stmts());
 				}
-#line 1825 "seal.tab.c" /* yacc.c:1646  */
+#line 1956 "seal-parse.cc"
     break;
 
-  case 19:
-#line 256 "seal.y" /* yacc.c:1646  */
-    {
+  case 19: /* stmt: ';'  */
+#line 293 "seal.y"
+                        {
 					(yyval.stmt) = no_expr();
 				}
-#line 1833 "seal.tab.c" /* yacc.c:1646  */
+#line 1964 "seal-parse.cc"
     break;
 
-  case 20:
-#line 259 "seal.y" /* yacc.c:1646  */
-    {
+  case 20: /* stmt: expr ';'  */
+#line 296 "seal.y"
+                                        {
 					(yyval.stmt) = (yyvsp[-1].expr);
 				}
-#line 1841 "seal.tab.c" /* yacc.c:1646  */
+#line 1972 "seal-parse.cc"
     break;
 
-  case 21:
-#line 262 "seal.y" /* yacc.c:1646  */
-    {
+  case 21: /* stmt: ifStmt  */
+#line 299 "seal.y"
+                                        {
 					(yyval.stmt) = (yyvsp[0].ifStmt);
 				}
-#line 1849 "seal.tab.c" /* yacc.c:1646  */
+#line 1980 "seal-parse.cc"
     break;
 
-  case 22:
-#line 265 "seal.y" /* yacc.c:1646  */
-    {
+  case 22: /* stmt: whileStmt  */
+#line 302 "seal.y"
+                                        {
 					(yyval.stmt) = (yyvsp[0].whileStmt);
 				}
-#line 1857 "seal.tab.c" /* yacc.c:1646  */
+#line 1988 "seal-parse.cc"
     break;
 
-  case 23:
-#line 268 "seal.y" /* yacc.c:1646  */
-    {
+  case 23: /* stmt: forStmt  */
+#line 305 "seal.y"
+                                        {
 					(yyval.stmt) = (yyvsp[0].forStmt);
 				}
-#line 1865 "seal.tab.c" /* yacc.c:1646  */
+#line 1996 "seal-parse.cc"
     break;
 
-  case 24:
-#line 271 "seal.y" /* yacc.c:1646  */
-    {
+  case 24: /* stmt: breakStmt  */
+#line 308 "seal.y"
+                                        {
 					(yyval.stmt) = (yyvsp[0].breakStmt);
 				}
-#line 1873 "seal.tab.c" /* yacc.c:1646  */
+#line 2004 "seal-parse.cc"
     break;
 
-  case 25:
-#line 274 "seal.y" /* yacc.c:1646  */
-    {
+  case 25: /* stmt: continueStmt  */
+#line 311 "seal.y"
+                                        {
 					(yyval.stmt) = (yyvsp[0].continueStmt);
 				}
-#line 1881 "seal.tab.c" /* yacc.c:1646  */
+#line 2012 "seal-parse.cc"
     break;
 
-  case 26:
-#line 277 "seal.y" /* yacc.c:1646  */
-    {
+  case 26: /* stmt: returnStmt  */
+#line 314 "seal.y"
+                                        {
 					(yyval.stmt) = (yyvsp[0].returnStmt);
 				}
-#line 1889 "seal.tab.c" /* yacc.c:1646  */
+#line 2020 "seal-parse.cc"
     break;
 
-  case 27:
-#line 280 "seal.y" /* yacc.c:1646  */
-    {
+  case 27: /* stmt: stmtBlock  */
+#line 317 "seal.y"
+                                        {
 					(yyval.stmt) = (yyvsp[0].stmtBlock);
 				}
-#line 1897 "seal.tab.c" /* yacc.c:1646  */
+#line 2028 "seal-parse.cc"
     break;
 
-  case 28:
-#line 285 "seal.y" /* yacc.c:1646  */
-    { 
+  case 28: /* stmt_list: stmt  */
+#line 322 "seal.y"
+                        {
 					(yyval.stmts) = single_Stmts((yyvsp[0].stmt));
 				}
-#line 1905 "seal.tab.c" /* yacc.c:1646  */
+#line 2036 "seal-parse.cc"
     break;
 
-  case 29:
-#line 288 "seal.y" /* yacc.c:1646  */
-    {
+  case 29: /* stmt_list: stmt_list stmt  */
+#line 325 "seal.y"
+                                                {
 					(yyval.stmts) = append_Stmts((yyvsp[-1].stmts), single_Stmts((yyvsp[0].stmt)));
 				}
-#line 1913 "seal.tab.c" /* yacc.c:1646  */
+#line 2044 "seal-parse.cc"
     break;
 
-  case 30:
-#line 293 "seal.y" /* yacc.c:1646  */
-    {
+  case 30: /* ifStmt: IF expr stmtBlock  */
+#line 330 "seal.y"
+                                        {
 					(yyval.ifStmt) = ifstmt((yyvsp[-1].expr), (yyvsp[0].stmtBlock), stmtBlock(nil_VariableDecls(), nil_Stmts()));
 				}
-#line 1921 "seal.tab.c" /* yacc.c:1646  */
+#line 2052 "seal-parse.cc"
     break;
 
-  case 31:
-#line 296 "seal.y" /* yacc.c:1646  */
-    {
+  case 31: /* ifStmt: IF expr stmtBlock ELSE stmtBlock  */
+#line 333 "seal.y"
+                                                                {
 					(yyval.ifStmt) = ifstmt((yyvsp[-3].expr), (yyvsp[-2].stmtBlock), (yyvsp[0].stmtBlock));
 				}
-#line 1929 "seal.tab.c" /* yacc.c:1646  */
+#line 2060 "seal-parse.cc"
     break;
 
-  case 32:
-#line 301 "seal.y" /* yacc.c:1646  */
-    {
+  case 32: /* whileStmt: WHILE expr stmtBlock  */
+#line 338 "seal.y"
+                                        {
 					(yyval.whileStmt) = whilestmt((yyvsp[-1].expr), (yyvsp[0].stmtBlock));
 				}
-#line 1937 "seal.tab.c" /* yacc.c:1646  */
+#line 2068 "seal-parse.cc"
     break;
 
-  case 33:
-#line 306 "seal.y" /* yacc.c:1646  */
-    {
+  case 33: /* forStmt: FOR expr ';' expr ';' expr stmtBlock  */
+#line 343 "seal.y"
+                                                        {
 					(yyval.forStmt) = forstmt((yyvsp[-5].expr), (yyvsp[-3].expr), (yyvsp[-1].expr), (yyvsp[0].stmtBlock));
 				}
-#line 1945 "seal.tab.c" /* yacc.c:1646  */
+#line 2076 "seal-parse.cc"
     break;
 
-  case 34:
-#line 309 "seal.y" /* yacc.c:1646  */
-    {
+  case 34: /* forStmt: FOR ';' expr ';' expr stmtBlock  */
+#line 346 "seal.y"
+                                                                {
 					(yyval.forStmt) = forstmt(no_expr(), (yyvsp[-3].expr), (yyvsp[-1].expr), (yyvsp[0].stmtBlock));
 				}
-#line 1953 "seal.tab.c" /* yacc.c:1646  */
+#line 2084 "seal-parse.cc"
     break;
 
-  case 35:
-#line 312 "seal.y" /* yacc.c:1646  */
-    {
+  case 35: /* forStmt: FOR expr ';' ';' expr stmtBlock  */
+#line 349 "seal.y"
+                                                                {
 					(yyval.forStmt) = forstmt((yyvsp[-4].expr), no_expr(), (yyvsp[-1].expr), (yyvsp[0].stmtBlock));
 				}
-#line 1961 "seal.tab.c" /* yacc.c:1646  */
+#line 2092 "seal-parse.cc"
     break;
 
-  case 36:
-#line 315 "seal.y" /* yacc.c:1646  */
-    {
+  case 36: /* forStmt: FOR expr ';' expr ';' stmtBlock  */
+#line 352 "seal.y"
+                                                                {
 					(yyval.forStmt) = forstmt((yyvsp[-4].expr), (yyvsp[-2].expr), no_expr(), (yyvsp[0].stmtBlock));
 				}
-#line 1969 "seal.tab.c" /* yacc.c:1646  */
+#line 2100 "seal-parse.cc"
     break;
 
-  case 37:
-#line 318 "seal.y" /* yacc.c:1646  */
-    {
+  case 37: /* forStmt: FOR ';' ';' expr stmtBlock  */
+#line 355 "seal.y"
+                                                        {
 					(yyval.forStmt) = forstmt(no_expr(), no_expr(), (yyvsp[-1].expr), (yyvsp[0].stmtBlock));
 				}
-#line 1977 "seal.tab.c" /* yacc.c:1646  */
+#line 2108 "seal-parse.cc"
     break;
 
-  case 38:
-#line 321 "seal.y" /* yacc.c:1646  */
-    {
+  case 38: /* forStmt: FOR ';' expr ';' stmtBlock  */
+#line 358 "seal.y"
+                                                        {
 					(yyval.forStmt) = forstmt(no_expr(), (yyvsp[-2].expr), no_expr(), (yyvsp[0].stmtBlock));
 				}
-#line 1985 "seal.tab.c" /* yacc.c:1646  */
+#line 2116 "seal-parse.cc"
     break;
 
-  case 39:
-#line 324 "seal.y" /* yacc.c:1646  */
-    {
+  case 39: /* forStmt: FOR expr ';' ';' stmtBlock  */
+#line 361 "seal.y"
+                                                        {
 					(yyval.forStmt) = forstmt((yyvsp[-3].expr), no_expr(), no_expr(), (yyvsp[0].stmtBlock));
 				}
-#line 1993 "seal.tab.c" /* yacc.c:1646  */
+#line 2124 "seal-parse.cc"
     break;
 
-  case 40:
-#line 327 "seal.y" /* yacc.c:1646  */
-    {
+  case 40: /* forStmt: FOR ';' ';' stmtBlock  */
+#line 364 "seal.y"
+                                                {
 					(yyval.forStmt) = forstmt(no_expr(), no_expr(), no_expr(), (yyvsp[0].stmtBlock));
 				}
-#line 2001 "seal.tab.c" /* yacc.c:1646  */
+#line 2132 "seal-parse.cc"
     break;
 
-  case 41:
-#line 332 "seal.y" /* yacc.c:1646  */
-    {
+  case 41: /* breakStmt: BREAK ';'  */
+#line 369 "seal.y"
+                                {
 					(yyval.breakStmt) = breakstmt();
 				}
-#line 2009 "seal.tab.c" /* yacc.c:1646  */
+#line 2140 "seal-parse.cc"
     break;
 
-  case 42:
-#line 337 "seal.y" /* yacc.c:1646  */
-    {
+  case 42: /* continueStmt: CONTINUE ';'  */
+#line 374 "seal.y"
+                                {
 					(yyval.continueStmt) = continuestmt();
 				}
-#line 2017 "seal.tab.c" /* yacc.c:1646  */
+#line 2148 "seal-parse.cc"
     break;
 
-  case 43:
-#line 342 "seal.y" /* yacc.c:1646  */
-    {
+  case 43: /* returnStmt: RETURN expr ';'  */
+#line 379 "seal.y"
+                                        {
 					(yyval.returnStmt) = returnstmt((yyvsp[-1].expr));
 				}
-#line 2025 "seal.tab.c" /* yacc.c:1646  */
+#line 2156 "seal-parse.cc"
     break;
 
-  case 44:
-#line 345 "seal.y" /* yacc.c:1646  */
-    {
+  case 44: /* returnStmt: RETURN ';'  */
+#line 382 "seal.y"
+                                        {
 					(yyval.returnStmt) = returnstmt(no_expr());
 				}
-#line 2033 "seal.tab.c" /* yacc.c:1646  */
+#line 2164 "seal-parse.cc"
     break;
 
-  case 45:
-#line 350 "seal.y" /* yacc.c:1646  */
-    {
+  case 45: /* expr: OBJECTID '=' expr  */
+#line 387 "seal.y"
+                                        {
 					(yyval.expr) = assign((yyvsp[-2].symbol), (yyvsp[0].expr));
 				}
-#line 2041 "seal.tab.c" /* yacc.c:1646  */
+#line 2172 "seal-parse.cc"
     break;
 
-  case 46:
-#line 353 "seal.y" /* yacc.c:1646  */
-    {
+  case 46: /* expr: CONST_INT  */
+#line 390 "seal.y"
+                                        {
 					(yyval.expr) = const_int((yyvsp[0].symbol));
 				}
-#line 2049 "seal.tab.c" /* yacc.c:1646  */
+#line 2180 "seal-parse.cc"
     break;
 
-  case 47:
-#line 356 "seal.y" /* yacc.c:1646  */
-    {
+  case 47: /* expr: CONST_STRING  */
+#line 393 "seal.y"
+                                        {
 					(yyval.expr) = const_string((yyvsp[0].symbol));
 				}
-#line 2057 "seal.tab.c" /* yacc.c:1646  */
+#line 2188 "seal-parse.cc"
     break;
 
-  case 48:
-#line 359 "seal.y" /* yacc.c:1646  */
-    {
+  case 48: /* expr: CONST_FLOAT  */
+#line 396 "seal.y"
+                                        {
 					(yyval.expr) = const_float((yyvsp[0].symbol));
 				}
-#line 2065 "seal.tab.c" /* yacc.c:1646  */
+#line 2196 "seal-parse.cc"
     break;
 
-  case 49:
-#line 362 "seal.y" /* yacc.c:1646  */
-    {
+  case 49: /* expr: CONST_BOOL  */
+#line 399 "seal.y"
+                                        {
 					(yyval.expr) = const_bool((yyvsp[0].boolean));
 				}
-#line 2073 "seal.tab.c" /* yacc.c:1646  */
+#line 2204 "seal-parse.cc"
     break;
 
-  case 50:
-#line 365 "seal.y" /* yacc.c:1646  */
-    {
+  case 50: /* expr: OBJECTID  */
+#line 402 "seal.y"
+                                        {
 					(yyval.expr) = object((yyvsp[0].symbol));
 				}
-#line 2081 "seal.tab.c" /* yacc.c:1646  */
+#line 2212 "seal-parse.cc"
     break;
 
-  case 51:
-#line 368 "seal.y" /* yacc.c:1646  */
-    {
+  case 51: /* expr: call  */
+#line 405 "seal.y"
+                                {
 					(yyval.expr) = (yyvsp[0].call);
 				}
-#line 2089 "seal.tab.c" /* yacc.c:1646  */
+#line 2220 "seal-parse.cc"
     break;
 
-  case 52:
-#line 371 "seal.y" /* yacc.c:1646  */
-    {
+  case 52: /* expr: '(' expr ')'  */
+#line 408 "seal.y"
+                                        {
 					(yyval.expr) = (yyvsp[-1].expr);
 				}
-#line 2097 "seal.tab.c" /* yacc.c:1646  */
+#line 2228 "seal-parse.cc"
     break;
 
-  case 53:
-#line 374 "seal.y" /* yacc.c:1646  */
-    {
+  case 53: /* expr: expr '+' expr  */
+#line 411 "seal.y"
+                                        {
 					(yyval.expr) = add((yyvsp[-2].expr), (yyvsp[0].expr));
 				}
-#line 2105 "seal.tab.c" /* yacc.c:1646  */
+#line 2236 "seal-parse.cc"
     break;
 
-  case 54:
-#line 377 "seal.y" /* yacc.c:1646  */
-    {
+  case 54: /* expr: expr '-' expr  */
+#line 414 "seal.y"
+                                        {
 					(yyval.expr) = minus((yyvsp[-2].expr), (yyvsp[0].expr));
 				}
-#line 2113 "seal.tab.c" /* yacc.c:1646  */
+#line 2244 "seal-parse.cc"
     break;
 
-  case 55:
-#line 380 "seal.y" /* yacc.c:1646  */
-    {
+  case 55: /* expr: expr '*' expr  */
+#line 417 "seal.y"
+                                        {
 					(yyval.expr) = multi((yyvsp[-2].expr), (yyvsp[0].expr));
 				}
-#line 2121 "seal.tab.c" /* yacc.c:1646  */
+#line 2252 "seal-parse.cc"
     break;
 
-  case 56:
-#line 383 "seal.y" /* yacc.c:1646  */
-    {
+  case 56: /* expr: expr '/' expr  */
+#line 420 "seal.y"
+                                        {
 					(yyval.expr) = divide((yyvsp[-2].expr), (yyvsp[0].expr));
 				}
-#line 2129 "seal.tab.c" /* yacc.c:1646  */
+#line 2260 "seal-parse.cc"
     break;
 
-  case 57:
-#line 386 "seal.y" /* yacc.c:1646  */
-    {
+  case 57: /* expr: expr '%' expr  */
+#line 423 "seal.y"
+                                        {
 					(yyval.expr) = mod((yyvsp[-2].expr), (yyvsp[0].expr));
 				}
-#line 2137 "seal.tab.c" /* yacc.c:1646  */
+#line 2268 "seal-parse.cc"
     break;
 
-  case 58:
-#line 389 "seal.y" /* yacc.c:1646  */
-    {
+  case 58: /* expr: '-' expr  */
+#line 426 "seal.y"
+                                                {
 					(yyval.expr) = neg((yyvsp[0].expr));
 				}
-#line 2145 "seal.tab.c" /* yacc.c:1646  */
+#line 2276 "seal-parse.cc"
     break;
 
-  case 59:
-#line 392 "seal.y" /* yacc.c:1646  */
-    {
+  case 59: /* expr: expr '<' expr  */
+#line 429 "seal.y"
+                                        {
 					(yyval.expr) = lt((yyvsp[-2].expr), (yyvsp[0].expr));
 				}
-#line 2153 "seal.tab.c" /* yacc.c:1646  */
+#line 2284 "seal-parse.cc"
     break;
 
-  case 60:
-#line 395 "seal.y" /* yacc.c:1646  */
-    {
+  case 60: /* expr: expr LE expr  */
+#line 432 "seal.y"
+                                        {
 					(yyval.expr) = le((yyvsp[-2].expr), (yyvsp[0].expr));
 				}
-#line 2161 "seal.tab.c" /* yacc.c:1646  */
+#line 2292 "seal-parse.cc"
     break;
 
-  case 61:
-#line 398 "seal.y" /* yacc.c:1646  */
-    {
+  case 61: /* expr: expr EQUAL expr  */
+#line 435 "seal.y"
+                                                {
 					(yyval.expr) = equ((yyvsp[-2].expr), (yyvsp[0].expr));
 				}
-#line 2169 "seal.tab.c" /* yacc.c:1646  */
+#line 2300 "seal-parse.cc"
     break;
 
-  case 62:
-#line 401 "seal.y" /* yacc.c:1646  */
-    {
+  case 62: /* expr: expr NE expr  */
+#line 438 "seal.y"
+                                        {
 					(yyval.expr) = neq((yyvsp[-2].expr), (yyvsp[0].expr));
 				}
-#line 2177 "seal.tab.c" /* yacc.c:1646  */
+#line 2308 "seal-parse.cc"
     break;
 
-  case 63:
-#line 404 "seal.y" /* yacc.c:1646  */
-    {
+  case 63: /* expr: expr GE expr  */
+#line 441 "seal.y"
+                                        {
 					(yyval.expr) = ge((yyvsp[-2].expr), (yyvsp[0].expr));
 				}
-#line 2185 "seal.tab.c" /* yacc.c:1646  */
+#line 2316 "seal-parse.cc"
     break;
 
-  case 64:
-#line 407 "seal.y" /* yacc.c:1646  */
-    {
+  case 64: /* expr: expr '>' expr  */
+#line 444 "seal.y"
+                                        {
 					(yyval.expr) = gt((yyvsp[-2].expr), (yyvsp[0].expr));
 				}
-#line 2193 "seal.tab.c" /* yacc.c:1646  */
+#line 2324 "seal-parse.cc"
     break;
 
-  case 65:
-#line 410 "seal.y" /* yacc.c:1646  */
-    {
+  case 65: /* expr: expr AND expr  */
+#line 447 "seal.y"
+                                        {
 					(yyval.expr) = and_((yyvsp[-2].expr), (yyvsp[0].expr));
 				}
-#line 2201 "seal.tab.c" /* yacc.c:1646  */
+#line 2332 "seal-parse.cc"
     break;
 
-  case 66:
-#line 413 "seal.y" /* yacc.c:1646  */
-    {
+  case 66: /* expr: expr OR expr  */
+#line 450 "seal.y"
+                                        {
 					(yyval.expr) = or_((yyvsp[-2].expr), (yyvsp[0].expr));
 				}
-#line 2209 "seal.tab.c" /* yacc.c:1646  */
+#line 2340 "seal-parse.cc"
     break;
 
-  case 67:
-#line 416 "seal.y" /* yacc.c:1646  */
-    {
+  case 67: /* expr: '!' expr  */
+#line 453 "seal.y"
+                                        {
 					(yyval.expr) = not_((yyvsp[0].expr));
 				}
-#line 2217 "seal.tab.c" /* yacc.c:1646  */
+#line 2348 "seal-parse.cc"
     break;
 
-  case 68:
-#line 419 "seal.y" /* yacc.c:1646  */
-    {
+  case 68: /* expr: '~' expr  */
+#line 456 "seal.y"
+                                                {
 					(yyval.expr) = bitnot((yyvsp[0].expr));
 				}
-#line 2225 "seal.tab.c" /* yacc.c:1646  */
+#line 2356 "seal-parse.cc"
     break;
 
-  case 69:
-#line 422 "seal.y" /* yacc.c:1646  */
-    {
+  case 69: /* expr: expr '&' expr  */
+#line 459 "seal.y"
+                                        {
 					(yyval.expr) = bitand_((yyvsp[-2].expr), (yyvsp[0].expr));
 				}
-#line 2233 "seal.tab.c" /* yacc.c:1646  */
+#line 2364 "seal-parse.cc"
     break;
 
-  case 70:
-#line 425 "seal.y" /* yacc.c:1646  */
-    {
+  case 70: /* expr: expr '|' expr  */
+#line 462 "seal.y"
+                                        {
 					(yyval.expr) = bitor_((yyvsp[-2].expr), (yyvsp[0].expr));
 				}
-#line 2241 "seal.tab.c" /* yacc.c:1646  */
+#line 2372 "seal-parse.cc"
     break;
 
-  case 71:
-#line 428 "seal.y" /* yacc.c:1646  */
-    {
+  case 71: /* expr: expr '^' expr  */
+#line 465 "seal.y"
+                                        {
 					(yyval.expr) = xor_((yyvsp[-2].expr), (yyvsp[0].expr));
 				}
-#line 2249 "seal.tab.c" /* yacc.c:1646  */
+#line 2380 "seal-parse.cc"
     break;
 
-  case 72:
-#line 433 "seal.y" /* yacc.c:1646  */
-    {
+  case 72: /* call: OBJECTID '(' actual_list ')'  */
+#line 470 "seal.y"
+                                                {
 					(yyval.call) = call((yyvsp[-3].symbol), (yyvsp[-1].actuals));
 				}
-#line 2257 "seal.tab.c" /* yacc.c:1646  */
+#line 2388 "seal-parse.cc"
     break;
 
-  case 73:
-#line 438 "seal.y" /* yacc.c:1646  */
-    {
+  case 73: /* actual: expr  */
+#line 475 "seal.y"
+                        {
 					(yyval.actual) = actual((yyvsp[0].expr));
 				}
-#line 2265 "seal.tab.c" /* yacc.c:1646  */
+#line 2396 "seal-parse.cc"
     break;
 
-  case 74:
-#line 442 "seal.y" /* yacc.c:1646  */
-    {
+  case 74: /* actual_list: %empty  */
+#line 480 "seal.y"
+                        {
 					(yyval.actuals) = nil_Actuals();
 				}
-#line 2273 "seal.tab.c" /* yacc.c:1646  */
+#line 2404 "seal-parse.cc"
     break;
 
-  case 75:
-#line 445 "seal.y" /* yacc.c:1646  */
-    { 
+  case 75: /* actual_list: actual  */
+#line 483 "seal.y"
+                                        {
 					(yyval.actuals) = single_Actuals((yyvsp[0].actual));
 				}
-#line 2281 "seal.tab.c" /* yacc.c:1646  */
+#line 2412 "seal-parse.cc"
     break;
 
-  case 76:
-#line 448 "seal.y" /* yacc.c:1646  */
-    { 
-					(yyval.actuals) = append_Actuals((yyvsp[-2].actuals), single_Actuals((yyvsp[0].actual))); 
+  case 76: /* actual_list: actual_list ',' actual  */
+#line 486 "seal.y"
+                                                        {
+					(yyval.actuals) = append_Actuals((yyvsp[-2].actuals), single_Actuals((yyvsp[0].actual)));
 				}
-#line 2289 "seal.tab.c" /* yacc.c:1646  */
+#line 2420 "seal-parse.cc"
     break;
 
 
-#line 2293 "seal.tab.c" /* yacc.c:1646  */
+#line 2424 "seal-parse.cc"
+
       default: break;
     }
   /* User semantic actions sometimes alter yychar, and that requires
@@ -2303,11 +2435,10 @@ yyreduce:
      case of YYERROR or YYBACKUP, subsequent parser actions might lead
      to an incorrect destructor call or verbose syntax error message
      before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
   *++yylsp = yyloc;
@@ -2315,14 +2446,13 @@ yyreduce:
   /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
@@ -2333,50 +2463,15 @@ yyreduce:
 yyerrlab:
   /* Make sure we have latest lookahead translation.  See comments at
      user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
-      yyerror (YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyssp, yytoken)
-      {
-        char const *yymsgp = YY_("syntax error");
-        int yysyntax_error_status;
-        yysyntax_error_status = YYSYNTAX_ERROR;
-        if (yysyntax_error_status == 0)
-          yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
-          {
-            if (yymsg != yymsgbuf)
-              YYSTACK_FREE (yymsg);
-            yymsg = (char *) YYSTACK_ALLOC (yymsg_alloc);
-            if (!yymsg)
-              {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
-              }
-            else
-              {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
-              }
-          }
-        yyerror (yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
-      }
-# undef YYSYNTAX_ERROR
-#endif
+      yyerror (&yylloc, parse, YY_("syntax error"));
     }
 
   yyerror_range[1] = yylloc;
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
@@ -2391,7 +2486,7 @@ yyerrlab:
       else
         {
           yydestruct ("Error: discarding",
-                      yytoken, &yylval, &yylloc);
+                      yytoken, &yylval, &yylloc, parse);
           yychar = YYEMPTY;
         }
     }
@@ -2405,14 +2500,12 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
-
-  yyerror_range[1] = yylsp[1-yylen];
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
   YYPOPSTACK (yylen);
@@ -2428,13 +2521,14 @@ yyerrorlab:
 yyerrlab1:
   yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
       if (!yypact_value_is_default (yyn))
         {
-          yyn += YYTERROR;
-          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
             {
               yyn = yytable[yyn];
               if (0 < yyn)
@@ -2448,7 +2542,7 @@ yyerrlab1:
 
       yyerror_range[1] = *yylsp;
       yydestruct ("Error: popping",
-                  yystos[yystate], yyvsp, yylsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, yylsp, parse);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -2459,13 +2553,11 @@ yyerrlab1:
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 
   yyerror_range[2] = yylloc;
-  /* Using YYLLOC is tempting, but would change the location of
-     the lookahead.  YYLOC is available though.  */
-  YYLLOC_DEFAULT (yyloc, yyerror_range, 2);
-  *++yylsp = yyloc;
+  ++yylsp;
+  YYLLOC_DEFAULT (*yylsp, yyerror_range, 2);
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -2476,33 +2568,37 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
-#if !defined yyoverflow || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
-  yyerror (YY_("memory exhausted"));
+  yyerror (&yylloc, parse, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
+
 
-yyreturn:
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
          user semantic actions for why this is necessary.  */
       yytoken = YYTRANSLATE (yychar);
       yydestruct ("Cleanup: discarding lookahead",
-                  yytoken, &yylval, &yylloc);
+                  yytoken, &yylval, &yylloc, parse);
     }
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
@@ -2511,32 +2607,94 @@ yyreturn:
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-                  yystos[*yyssp], yyvsp, yylsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, yylsp, parse);
       YYPOPSTACK (1);
     }
-#ifndef yyoverflow
-  if (yyss != yyssa)
-    YYSTACK_FREE (yyss);
-#endif
-#if YYERROR_VERBOSE
-  if (yymsg != yymsgbuf)
-    YYSTACK_FREE (yymsg);
-#endif
+  yyps->yynew = 2;
+  goto yypushreturn;
+
+
+/*-------------------------.
+| yypushreturn -- return.  |
+`-------------------------*/
+yypushreturn:
+
   return yyresult;
 }
-#line 454 "seal.y" /* yacc.c:1906  */
+#undef seal_yynerrs
+#undef yystate
+#undef yyerrstatus
+#undef yyssa
+#undef yyss
+#undef yyssp
+#undef yyvsa
+#undef yyvs
+#undef yyvsp
+#undef yylsa
+#undef yyls
+#undef yylsp
+#undef yystacksize
+#line 492 "seal.y"
+
+
+    extern thread_local YYSTYPE seal_yylval;
+
+    /* Note the lookahead for yyerror; every token the parser reads
+    passes through here. */
+    static int lookahead(SealParse *parse, int token, YYSTYPE *value)
+    {
+      stats_token();
+      parse->token = token > 0 ? token : 0;
+      parse->value = *value;
+      return token;
+    }
+
+    /* The pull parser's lexer: the next token from the scanner, with its
+    location. */
+    static int yylex(YYSTYPE *value, YYLTYPE *loc, SealParse *parse)
+    {
+      int token = scanner_lex();
+      if (token == LEX_ERROR) {
+        seal_lex_error(parse, lex_message.str());
+        /* straight to error recovery, which finds no error rule and
+        aborts the parse, without a syntax error of its own */
+        token = YYerror;
+      }
+      *value = seal_yylval;
+      loc->first_line = loc->last_line = curr_loc;
+      return lookahead(parse, token, value);
+    }
+
+    /* Hand the push parser ps the next token, its value and its
+    location.  Returns YYPUSH_MORE until the parse is over, then 0 if
+    it succeeded. */
+    int seal_push_token(seal_yypstate *ps, int token, YYSTYPE *value,
+                        SourceLoc loc, SealParse *parse)
+    {
+      YYLTYPE l;
+      l.first_line = l.last_line = loc;
+      l.first_column = l.last_column = 0;
+      lookahead(parse, token, value);
+      return seal_yypush_parse(ps, token, value, &l, parse);
+    }
+
+    /* Report the lexical error whose message is message, and count it
+    with the syntax errors, so that the file fails. */
+    void seal_lex_error(SealParse *parse, const std::string &message)
+    {
+      *diag_stream << message;
+      parse->errors++;
+      parse->lex_error = true;
+    }
 
-    
     /* This function is called automatically when Bison detects a parse error. */
-    void yyerror(char *s)
+    void yyerror(YYLTYPE *loc, SealParse *parse, const char *s)
     {
-      extern int curr_lineno;
-      
-      cerr << "\"" << curr_filename << "\", line " << curr_lineno << ": " \
+      *diag_stream << "\"" << curr_filename << "\", line " << source_manager.line(LOC(*loc)) << ": " \
       << s << " at or near ";
-      print_seal_token(yychar);
-      cerr << endl;
-      omerrs++;
-      
-      if(omerrs>50) {fprintf(stdout, "More than 50 errors\n"); exit(1);}
+      print_seal_token(parse->token, &parse->value);
+      *diag_stream << endl;
+      parse->errors++;
+
+      if(parse->errors>50) {fprintf(stdout, "More than 50 errors\n"); exit(1);}
     }
@@ -193,7 +193,7 @@ typedef union YYSTYPE
 # define YYSTYPE_IS_TRIVIAL 1
 #endif
 
-extern YYSTYPE seal_yylval;
+extern thread_local YYSTYPE seal_yylval;
 
 #if ! defined YYLTYPE && ! defined YYLTYPE_IS_DECLARED
 typedef struct YYLTYPE
@@ -208,5 +208,41 @@ typedef struct YYLTYPE
 # define YYLTYPE_IS_TRIVIAL 1
 #endif
 
-extern YYLTYPE seal_yylloc;
+//
+// The parser, from seal.y, which declares the same.  A parse keeps its
+// state in a seal_yypstate and its result in a SealParse, so parses
+// are independent of each other.  seal_yyparse pulls tokens from the
+// scanner; a caller that has the tokens itself pushes them one at a
+// time with seal_push_token instead, each with its SourceLoc, which the
+// parser keeps in the first_line of its YYLTYPE:
+//
+//   SealParse parse;
+//   seal_yypstate *ps = seal_yypstate_new();
+//   while (seal_push_token(ps, token, &value, loc, &parse) == YYPUSH_MORE)
+//     ... next token ...
+//   seal_yypstate_delete(ps);
+//
+#ifndef YYPUSH_MORE_DEFINED
+# define YYPUSH_MORE_DEFINED
+enum { YYPUSH_MORE = 4 };
+#endif
+
+typedef struct seal_yypstate seal_yypstate;
+
+struct SealParse {
+  Program program;            /* the result, once the parse is accepted */
+  int errors;                 /* syntax and lexical errors reported */
+  bool lex_error;             /* the parse ended at a lexical error */
+  int token;                  /* the lookahead, for error messages */
+  YYSTYPE value;
+
+  SealParse() : program(NULL), errors(0), lex_error(false), token(0) { }
+};
+
+int seal_yyparse(SealParse *parse);
+seal_yypstate *seal_yypstate_new(void);
+void seal_yypstate_delete(seal_yypstate *ps);
+int seal_push_token(seal_yypstate *ps, int token, YYSTYPE *value,
+                    SourceLoc loc, SealParse *parse);
+void seal_lex_error(SealParse *parse, const std::string &message);
 #endif
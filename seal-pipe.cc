@@ -0,0 +1,202 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+///////////////////////////////////////////////////////////////////////////
+//
+// file: seal-pipe.cc
+//
+// The pipelined front end selected with -P.  seal_pipe_parse starts a
+// lexer thread that runs the scanner over the whole input and passes
+// each token, with its semantic value and location, through a ring
+// buffer to the parsing thread, which pushes them to the push parser
+// as they arrive.  Lexing and parsing then overlap on two cores, and
+// with a pipe for input, so does reading it.
+//
+// The ring has one producer and one consumer, so it needs no locks:
+// each side owns one index, on a cache line of its own, and publishes
+// it with a release store.  Both sides publish in batches rather than
+// per token, which keeps the two cores from trading the index lines
+// back and forth on every token.
+//
+// The lexer thread interns into its own (thread_local) string tables.
+// When it finishes it swaps them with the parsing thread's tables,
+// which are empty until then: entries do not move, so every Symbol in
+// the token stream stays valid, and afterwards the parsing thread owns
+// them as if it had scanned the input itself.  The parsing thread
+// must not use the tables until it has joined the lexer.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include "seal-parse.h"
+#include "stringtab.h"
+#include "seal-lex.h"
+#include "utilities.h"
+
+extern thread_local FILE *fin;
+extern thread_local YYSTYPE seal_yylval;
+
+enum {
+    CACHE_LINE = 64,
+    RING_SIZE = 1 << 14,        // records; a power of two
+    BATCH = 64                  // records between index updates
+};
+
+struct TokenRecord {
+    int token;                  // 0 at the end, LEX_ERROR on an error
+    SourceLoc loc;              // curr_loc after the token
+    YYSTYPE value;
+};
+
+struct Pipe {
+    // written by the parsing thread
+    alignas(CACHE_LINE) std::atomic<unsigned> head;  // records consumed
+    unsigned tail_seen;         // last tail read by the consumer
+    std::atomic<bool> stop;     // the parser is done; stop lexing
+
+    // written by the lexer thread
+    alignas(CACHE_LINE) std::atomic<unsigned> tail;  // records produced
+    unsigned head_seen;         // last head read by the producer
+
+    alignas(CACHE_LINE) TokenRecord ring[RING_SIZE];
+
+    FILE *input;
+    SourceLoc start;            // location of its first byte
+    std::string message;        // the lexical error, if any
+    IdTable *ids;               // the parsing thread's tables
+    StrTable *strings;
+    IntTable *ints;
+    IdTable *floats;            // floatspellings
+    std::thread lexer;
+};
+
+// back off while waiting for the other side
+static void wait_step(int &spins)
+{
+    if (++spins < 100) {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    } else {
+        std::this_thread::yield();
+    }
+}
+
+//
+// Producer side.  write is the next record to fill; it is published
+// every BATCH records and before waiting for room.  Returns false if
+// the parser has stopped reading.
+//
+static bool push(Pipe *p, unsigned &write, const TokenRecord &r)
+{
+    if (write - p->head_seen == RING_SIZE) {
+        p->tail.store(write, std::memory_order_release);
+        int spins = 0;
+        while (write - (p->head_seen = p->head.load(std::memory_order_acquire))
+               == RING_SIZE) {
+            if (p->stop.load(std::memory_order_relaxed))
+                return false;
+            wait_step(spins);
+        }
+    }
+    p->ring[write % RING_SIZE] = r;
+    write++;
+    if (write % BATCH == 0)
+        p->tail.store(write, std::memory_order_release);
+    return true;
+}
+
+static void lexer_main(Pipe *p)
+{
+    fin = p->input;
+    scanner_open(p->input, p->start);
+
+    unsigned write = 0;
+    TokenRecord r;
+    do {
+        r.token = scanner_lex();
+        r.loc = curr_loc;
+        r.value = seal_yylval;
+        if (r.token == LEX_ERROR)
+            p->message = lex_message.str();
+    } while (push(p, write, r) && r.token > 0);
+    p->tail.store(write, std::memory_order_release);
+
+    scanner_close();
+    p->ids->swap(idtable);
+    p->strings->swap(stringtable);
+    p->ints->swap(inttable);
+    p->floats->swap(floatspellings);
+}
+
+//
+// Consumer side.  read is the next record to take; records taken are
+// handed back to the producer every BATCH records and before waiting
+// for more.
+//
+static TokenRecord pop(Pipe *p, unsigned &read)
+{
+    if (read == p->tail_seen) {
+        p->head.store(read, std::memory_order_release);
+        int spins = 0;
+        while ((p->tail_seen = p->tail.load(std::memory_order_acquire))
+               == read)
+            wait_step(spins);
+    }
+    TokenRecord r = p->ring[read % RING_SIZE];
+    read++;
+    if (read % BATCH == 0)
+        p->head.store(read, std::memory_order_release);
+    return r;
+}
+
+// stop the lexer thread and take over its tables
+static void finish(Pipe *p)
+{
+    p->stop.store(true);
+    p->lexer.join();
+    delete p;
+}
+
+//
+// Parse input into parse, pushing the tokens to the parser as they
+// come off the ring.  A lexical error ends the parse: it is reported
+// where syntax errors are and counted as one, so that only the file
+// being compiled fails.
+//
+void seal_pipe_parse(FILE *input, SourceLoc start, SealParse *parse)
+{
+    Pipe *p = new Pipe;
+    p->head.store(0);
+    p->tail_seen = 0;
+    p->stop.store(false);
+    p->tail.store(0);
+    p->head_seen = 0;
+    p->input = input;
+    p->start = start;
+    p->ids = &idtable;
+    p->strings = &stringtable;
+    p->ints = &inttable;
+    p->floats = &floatspellings;
+    p->lexer = std::thread(lexer_main, p);
+
+    seal_yypstate *ps = seal_yypstate_new();
+    unsigned read = 0;
+    int status;
+    do {
+        TokenRecord r = pop(p, read);
+        curr_loc = r.loc;
+        if (r.token == LEX_ERROR) {
+            seal_lex_error(parse, p->message);
+            break;
+        }
+        status = seal_push_token(ps, r.token, &r.value, r.loc, parse);
+    } while (status == YYPUSH_MORE);
+    seal_yypstate_delete(ps);
+    finish(p);
+}
@@ -0,0 +1,707 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+///////////////////////////////////////////////////////////////////////////
+//
+// file: seal-scan.cc
+//
+// A hand-written scanner for SEAL, selected with -L.  It implements the
+// same contract as the flex scanner in seal-lex.cc: seal_scan_lex()
+// returns the next token and leaves its value in seal_yylval, its
+// offset in the input is seal_scan_offset(), and lexical errors are
+// reported exactly as the flex rules report them.  The token stream is
+// identical.
+//
+// The whole input is read into one buffer followed by zero padding.
+// The loops that dominate on large sources -- whitespace runs,
+// identifier and number runs, comments and string bodies -- are done
+// by kernels that classify 16 or 32 bytes at a time with SSE2 or AVX2.
+// Newlines are not counted; lines are looked up from offsets only
+// when they are needed (see source.h).  The widest kernel set the CPU
+// supports is chosen at startup; a table-driven scalar set is the
+// fallback.  Every kernel stops at a NUL byte, so the padding bounds
+// every loop; a NUL before the end of the buffer is input text.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SCAN_X86 1
+#endif
+#include "seal-parse.h"
+#include "stringtab.h"
+#include "utilities.h"
+#include "seal-lex.h"
+
+extern thread_local YYSTYPE seal_yylval;
+
+// bytes of zeros after the text; covers a 32-byte load at the end
+#define SCAN_PADDING 64
+
+static thread_local char *scan_buf = NULL;   // the input and its padding
+static thread_local const char *scan_pos;    // next unscanned byte
+static thread_local const char *scan_end;    // end of the input
+
+///////////////////////////////////////////////////////////////////////////
+//
+// Kernels
+//
+///////////////////////////////////////////////////////////////////////////
+
+struct ScanKernels {
+    const char *name;
+    // first byte not in [ \t\n\v\f\r]
+    const char *(*skip_space)(const char *p);
+    // first byte not in [A-Za-z0-9_]
+    const char *(*skip_word)(const char *p);
+    // first '\n' or NUL
+    const char *(*find_line_end)(const char *p);
+    // first "*/" or NUL
+    const char *(*find_comment_end)(const char *p);
+    // first close, '\\', '\n' or NUL
+    const char *(*find_string_stop)(const char *p, char close);
+};
+
+enum { SPACE = 1, WORD = 2 };
+static unsigned char char_class[256];
+
+static int init_char_class()
+{
+    for (int c = '\t'; c <= '\r'; c++) char_class[c] = SPACE;
+    char_class[(unsigned char) ' '] = SPACE;
+    for (int c = 'a'; c <= 'z'; c++) char_class[c] = WORD;
+    for (int c = 'A'; c <= 'Z'; c++) char_class[c] = WORD;
+    for (int c = '0'; c <= '9'; c++) char_class[c] = WORD;
+    char_class[(unsigned char) '_'] = WORD;
+    return 0;
+}
+
+static int char_class_ready = init_char_class();
+
+static inline int cls(const char *p) { return char_class[(unsigned char) *p]; }
+
+static const char *scalar_skip_space(const char *p)
+{
+    while (cls(p) == SPACE) p++;
+    return p;
+}
+
+static const char *scalar_skip_word(const char *p)
+{
+    while (cls(p) == WORD) p++;
+    return p;
+}
+
+static const char *scalar_find_line_end(const char *p)
+{
+    while (*p != '\n' && *p != '\0') p++;
+    return p;
+}
+
+static const char *scalar_find_comment_end(const char *p)
+{
+    while (*p != '\0' && !(p[0] == '*' && p[1] == '/')) p++;
+    return p;
+}
+
+static const char *scalar_find_string_stop(const char *p, char close)
+{
+    while (*p != close && *p != '\\' && *p != '\n' && *p != '\0') p++;
+    return p;
+}
+
+static const ScanKernels scalar_kernels = {
+    "scalar", scalar_skip_space, scalar_skip_word, scalar_find_line_end,
+    scalar_find_comment_end, scalar_find_string_stop
+};
+
+#ifdef SCAN_X86
+
+//
+// The vector kernels test a block of bytes at once and turn the result
+// into a bit mask with movemask; the first set bit of the "stop" mask
+// is the answer.  Byte ranges are tested as unsigned
+// (v - lo) <= (hi - lo) using a saturating subtract.
+//
+
+static inline __m128i sse2_range(__m128i v, char lo, char hi)
+{
+    __m128i d = _mm_subs_epu8(_mm_sub_epi8(v, _mm_set1_epi8(lo)),
+			      _mm_set1_epi8(hi - lo));
+    return _mm_cmpeq_epi8(d, _mm_setzero_si128());
+}
+
+static inline __m128i sse2_eq(__m128i v, char c)
+{
+    return _mm_cmpeq_epi8(v, _mm_set1_epi8(c));
+}
+
+static inline unsigned sse2_mask(__m128i v)
+{
+    return (unsigned) _mm_movemask_epi8(v);
+}
+
+static const char *sse2_skip_space(const char *p)
+{
+    for (;; p += 16) {
+	__m128i v = _mm_loadu_si128((const __m128i *) p);
+	unsigned stop = ~sse2_mask(_mm_or_si128(sse2_eq(v, ' '),
+					     sse2_range(v, '\t', '\r'))) & 0xffff;
+	if (stop)
+	    return p + __builtin_ctz(stop);
+    }
+}
+
+static const char *sse2_skip_word(const char *p)
+{
+    for (;; p += 16) {
+	__m128i v = _mm_loadu_si128((const __m128i *) p);
+	__m128i word = _mm_or_si128(
+	    _mm_or_si128(sse2_range(v, 'a', 'z'), sse2_range(v, 'A', 'Z')),
+	    _mm_or_si128(sse2_range(v, '0', '9'), sse2_eq(v, '_')));
+	unsigned stop = ~sse2_mask(word) & 0xffff;
+	if (stop)
+	    return p + __builtin_ctz(stop);
+    }
+}
+
+static const char *sse2_find_line_end(const char *p)
+{
+    for (;; p += 16) {
+	__m128i v = _mm_loadu_si128((const __m128i *) p);
+	unsigned stop = sse2_mask(_mm_or_si128(sse2_eq(v, '\n'), sse2_eq(v, '\0')));
+	if (stop)
+	    return p + __builtin_ctz(stop);
+    }
+}
+
+static const char *sse2_find_comment_end(const char *p)
+{
+    for (;; p += 16) {
+	__m128i v = _mm_loadu_si128((const __m128i *) p);
+	__m128i next = _mm_loadu_si128((const __m128i *) (p + 1));
+	__m128i close = _mm_and_si128(sse2_eq(v, '*'), sse2_eq(next, '/'));
+	unsigned stop = sse2_mask(_mm_or_si128(close, sse2_eq(v, '\0')));
+	if (stop)
+	    return p + __builtin_ctz(stop);
+    }
+}
+
+static const char *sse2_find_string_stop(const char *p, char close)
+{
+    for (;; p += 16) {
+	__m128i v = _mm_loadu_si128((const __m128i *) p);
+	__m128i s = _mm_or_si128(_mm_or_si128(sse2_eq(v, close), sse2_eq(v, '\\')),
+				 _mm_or_si128(sse2_eq(v, '\n'), sse2_eq(v, '\0')));
+	unsigned stop = sse2_mask(s);
+	if (stop)
+	    return p + __builtin_ctz(stop);
+    }
+}
+
+static const ScanKernels sse2_kernels = {
+    "sse2", sse2_skip_space, sse2_skip_word, sse2_find_line_end,
+    sse2_find_comment_end, sse2_find_string_stop
+};
+
+#define AVX2 __attribute__((target("avx2,popcnt")))
+
+AVX2 static inline __m256i avx2_range(__m256i v, char lo, char hi)
+{
+    __m256i d = _mm256_subs_epu8(_mm256_sub_epi8(v, _mm256_set1_epi8(lo)),
+				 _mm256_set1_epi8(hi - lo));
+    return _mm256_cmpeq_epi8(d, _mm256_setzero_si256());
+}
+
+AVX2 static inline __m256i avx2_eq(__m256i v, char c)
+{
+    return _mm256_cmpeq_epi8(v, _mm256_set1_epi8(c));
+}
+
+AVX2 static inline unsigned avx2_mask(__m256i v)
+{
+    return (unsigned) _mm256_movemask_epi8(v);
+}
+
+AVX2 static const char *avx2_skip_space(const char *p)
+{
+    for (;; p += 32) {
+	__m256i v = _mm256_loadu_si256((const __m256i *) p);
+	unsigned stop = ~avx2_mask(_mm256_or_si256(avx2_eq(v, ' '),
+						avx2_range(v, '\t', '\r')));
+	if (stop)
+	    return p + __builtin_ctz(stop);
+    }
+}
+
+AVX2 static const char *avx2_skip_word(const char *p)
+{
+    for (;; p += 32) {
+	__m256i v = _mm256_loadu_si256((const __m256i *) p);
+	__m256i word = _mm256_or_si256(
+	    _mm256_or_si256(avx2_range(v, 'a', 'z'), avx2_range(v, 'A', 'Z')),
+	    _mm256_or_si256(avx2_range(v, '0', '9'), avx2_eq(v, '_')));
+	unsigned stop = ~avx2_mask(word);
+	if (stop)
+	    return p + __builtin_ctz(stop);
+    }
+}
+
+AVX2 static const char *avx2_find_line_end(const char *p)
+{
+    for (;; p += 32) {
+	__m256i v = _mm256_loadu_si256((const __m256i *) p);
+	unsigned stop = avx2_mask(_mm256_or_si256(avx2_eq(v, '\n'), avx2_eq(v, '\0')));
+	if (stop)
+	    return p + __builtin_ctz(stop);
+    }
+}
+
+AVX2 static const char *avx2_find_comment_end(const char *p)
+{
+    for (;; p += 32) {
+	__m256i v = _mm256_loadu_si256((const __m256i *) p);
+	__m256i next = _mm256_loadu_si256((const __m256i *) (p + 1));
+	__m256i close = _mm256_and_si256(avx2_eq(v, '*'), avx2_eq(next, '/'));
+	unsigned stop = avx2_mask(_mm256_or_si256(close, avx2_eq(v, '\0')));
+	if (stop)
+	    return p + __builtin_ctz(stop);
+    }
+}
+
+AVX2 static const char *avx2_find_string_stop(const char *p, char close)
+{
+    for (;; p += 32) {
+	__m256i v = _mm256_loadu_si256((const __m256i *) p);
+	__m256i s = _mm256_or_si256(
+	    _mm256_or_si256(avx2_eq(v, close), avx2_eq(v, '\\')),
+	    _mm256_or_si256(avx2_eq(v, '\n'), avx2_eq(v, '\0')));
+	unsigned stop = avx2_mask(s);
+	if (stop)
+	    return p + __builtin_ctz(stop);
+    }
+}
+
+static const ScanKernels avx2_kernels = {
+    "avx2", avx2_skip_space, avx2_skip_word, avx2_find_line_end,
+    avx2_find_comment_end, avx2_find_string_stop
+};
+
+#endif // SCAN_X86
+
+//
+// Build with -DSEAL_SCAN_KERNELS=scalar_kernels (or sse2_kernels) to
+// force a narrower kernel set, e.g. to compare them.
+//
+static const ScanKernels *choose_kernels()
+{
+#if defined(SEAL_SCAN_KERNELS)
+    return &SEAL_SCAN_KERNELS;
+#elif defined(SCAN_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt"))
+	return &avx2_kernels;
+    if (__builtin_cpu_supports("sse2"))
+	return &sse2_kernels;
+#endif
+    return &scalar_kernels;
+}
+
+static const ScanKernels *kernels = choose_kernels();
+
+///////////////////////////////////////////////////////////////////////////
+//
+// Input
+//
+///////////////////////////////////////////////////////////////////////////
+
+//
+// Read all of input into scan_buf.  Regular files are read in one
+// piece; pipes are read until EOF.
+//
+void seal_scan_open(FILE *input)
+{
+    struct stat st;
+    size_t cap = 1 << 16, len = 0, n;
+    if (fstat(fileno(input), &st) == 0 && S_ISREG(st.st_mode))
+	cap = st.st_size + 1;
+
+    free(scan_buf);
+    scan_buf = (char *) malloc(cap + SCAN_PADDING);
+    while ((n = fread(scan_buf + len, 1, cap - len, input)) > 0) {
+	len += n;
+	if (len == cap) {
+	    cap *= 2;
+	    scan_buf = (char *) realloc(scan_buf, cap + SCAN_PADDING);
+	}
+    }
+    memset(scan_buf + len, 0, SCAN_PADDING);
+    scan_pos = scan_buf;
+    scan_end = scan_buf + len;
+}
+
+void seal_scan_close()
+{
+    free(scan_buf);
+    scan_buf = NULL;
+    scan_pos = scan_end = NULL;
+}
+
+unsigned seal_scan_offset()
+{
+    return scan_pos - scan_buf;
+}
+
+// the line of p, in scan_buf
+static int line_at(const char *p)
+{
+    return scan_line(p - scan_buf);
+}
+
+///////////////////////////////////////////////////////////////////////////
+//
+// Tokens
+//
+///////////////////////////////////////////////////////////////////////////
+
+// report a lexical error the way the flex rules do
+static int lex_error(const char *what, const char *text, int len)
+{
+    lex_message << line_at(text) << ": " << what;
+    lex_message.write(text, strnlen(text, len));
+    lex_message << ".\n";
+    return lexical_error();
+}
+
+static inline int is_octal(char c) { return c >= '0' && c <= '7'; }
+static inline int is_digit(char c) { return c >= '0' && c <= '9'; }
+static inline int is_hex(char c)
+{
+    return is_digit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+// \x takes any two letters or digits, valued as in the flex rules
+static inline int is_alnum(char c) { return cls(&c) == WORD && c != '_'; }
+
+static int digit_value(char c)
+{
+    if (c >= 'a') return c - 'a' + 10;
+    if (c >= 'A') return c - 'A' + 10;
+    return c - '0';
+}
+
+//
+// The value of the octal or hexadecimal constant at s, whose digits
+// start at digits, computed like the flex rules do: the place value is
+// a wrapping 32-bit int.
+//
+static Symbol radix_constant(const char *digits, const char *end, unsigned radix)
+{
+    long r = 0;
+    unsigned place = 1;
+    for (const char *q = end - 1; q >= digits; q--) {
+	r += (int) ((unsigned) digit_value(*q) * place);
+	place *= radix;
+    }
+    return inttable.add_int(r);
+}
+
+static int keyword(const char *s, int len)
+{
+    switch (len) {
+    case 2:
+	if (!memcmp(s, "if", 2)) return IF;
+	break;
+    case 3:
+	if (!memcmp(s, "for", 3)) return FOR;
+	if (!memcmp(s, "var", 3)) return VAR;
+	break;
+    case 4:
+	if (!memcmp(s, "else", 4)) return ELSE;
+	if (!memcmp(s, "func", 4)) return FUNC;
+	if (!memcmp(s, "true", 4)) { seal_yylval.boolean = 1; return CONST_BOOL; }
+	break;
+    case 5:
+	if (!memcmp(s, "while", 5)) return WHILE;
+	if (!memcmp(s, "break", 5)) return BREAK;
+	if (!memcmp(s, "false", 5)) { seal_yylval.boolean = 0; return CONST_BOOL; }
+	break;
+    case 6:
+	if (!memcmp(s, "return", 6)) return RETURN;
+	break;
+    case 8:
+	if (!memcmp(s, "continue", 8)) return CONTINUE;
+	break;
+    }
+    return 0;
+}
+
+static int is_type_name(const char *s, int len)
+{
+    switch (len) {
+    case 3: return !memcmp(s, "Int", 3);
+    case 4: return !memcmp(s, "Bool", 4) || !memcmp(s, "Void", 4);
+    case 5: return !memcmp(s, "Float", 5);
+    case 6: return !memcmp(s, "String", 6);
+    }
+    return 0;
+}
+
+//
+// A number starts at s.  Of the constant forms that match there --
+// decimal 0|[1-9][0-9]*, octal 0[0-7]+, hexadecimal 0[xX][0-9a-fA-F]+,
+// float (0|[1-9][0-9]*)\.[0-9]+ and the illegal identifier
+// [0-9][A-Za-z0-9_]* -- the longest wins, and the earlier one in that
+// list on a tie.
+//
+static int scan_number(const char *s)
+{
+    const char *word = kernels->skip_word(s);
+    const char *best = s + 1;            // decimal "0" or first digit
+    int form = CONST_INT;
+
+    const char *q = s + 1;
+    if (*s != '0') {
+	while (is_digit(*q)) q++;
+	best = q;
+    }
+    const char *intpart = q;
+
+    if (*s == '0') {
+	const char *o = s + 1;
+	while (is_octal(*o)) o++;
+	if (o - s > best - s) { best = o; form = 'o'; }
+	if ((s[1] == 'x' || s[1] == 'X') && is_hex(s[2])) {
+	    const char *h = s + 2;
+	    while (is_hex(*h)) h++;
+	    if (h - s > best - s) { best = h; form = 'x'; }
+	}
+    }
+    if (intpart[0] == '.' && is_digit(intpart[1])) {
+	const char *f = intpart + 1;
+	while (is_digit(*f)) f++;
+	if (f - s > best - s) { best = f; form = CONST_FLOAT; }
+    }
+    if (word - s > best - s)
+	return lex_error("Illegal Identifier name ", s, word - s);
+
+    scan_pos = best;
+    switch (form) {
+    case 'o':
+	seal_yylval.symbol = radix_constant(s + 1, best, 8);
+	return CONST_INT;
+    case 'x':
+	seal_yylval.symbol = radix_constant(s + 2, best, 16);
+	return CONST_INT;
+    case CONST_FLOAT:
+	seal_yylval.symbol = floatspellings.add_chars((char *) s, best - s);
+	return CONST_FLOAT;
+    default:
+	seal_yylval.symbol = inttable.add_chars((char *) s, best - s);
+	return CONST_INT;
+    }
+}
+
+//
+// The body of a "..." constant starts at s.  Escapes are decoded into
+// the string table's arena only if there are any; the text is cut at
+// the first NUL, as the flex rules do.
+//
+static int scan_quoted(const char *s)
+{
+    const char *q = s;
+    int escaped = 0, null_escape = 0;
+    for (;;) {
+	q = kernels->find_string_stop(q, '"');
+	if (q >= scan_end) {
+	    lex_message << line_at(q) << ": String constant meets an EOF.\n";
+	    return lexical_error();
+	}
+	if (*q == '"')
+	    break;
+	if (*q == '\n') {
+	    lex_message << line_at(q) << ": String constant contains an unescaped newline.\n";
+	    return lexical_error();
+	}
+	if (*q == '\0') {
+	    q++;
+	    continue;
+	}
+	// a backslash
+	if (q + 1 >= scan_end) {
+	    q++;
+	    continue;
+	}
+	escaped = 1;
+	if (q[1] == 'x' && is_alnum(q[2]) && is_alnum(q[3]))
+	    q += 4;
+	else if (is_octal(q[1]) && is_octal(q[2]) && is_octal(q[3]))
+	    q += 4;
+	else {
+	    if (q[1] == '0') null_escape = 1;
+	    q += 2;
+	}
+    }
+    if (null_escape) {
+	lex_message << line_at(q) << ": String contains a '\0'.\n";
+	return lexical_error();
+    }
+
+    if (!escaped) {
+	seal_yylval.symbol = stringtable.add_chars((char *) s, strnlen(s, q - s));
+    } else {
+	char *out = stringtable.reserve_string(q - s);
+	int len = 0;
+	for (const char *e = s; e < q; e++) {
+	    if (*e != '\\') {
+		out[len++] = *e;
+		continue;
+	    }
+	    e++;
+	    if (*e == 'x' && is_alnum(e[1]) && is_alnum(e[2])) {
+		out[len++] = (char) (digit_value(e[1]) * 16 + digit_value(e[2]));
+		e += 2;
+	    } else if (is_octal(e[0]) && is_octal(e[1]) && is_octal(e[2])) {
+		out[len++] = (char) ((e[0] - '0') * 64 + (e[1] - '0') * 8 + (e[2] - '0'));
+		e += 2;
+	    } else {
+		switch (*e) {
+		case 'b': out[len++] = '\b'; break;
+		case 'f': out[len++] = '\f'; break;
+		case 'n': out[len++] = '\n'; break;
+		case 't': out[len++] = '\t'; break;
+		default:  out[len++] = *e;
+		}
+	    }
+	}
+	seal_yylval.symbol = stringtable.add_reserved(strnlen(out, len));
+    }
+    scan_pos = q + 1;
+    return CONST_STRING;
+}
+
+// the body of a `...` constant starts at s; it has no escapes
+static int scan_raw(const char *s)
+{
+    const char *q = s;
+    for (;;) {
+	q = kernels->find_string_stop(q, '`');
+	if (q >= scan_end) {
+	    lex_message << line_at(q) << ": String constant meets an EOF.\n";
+	    return lexical_error();
+	}
+	if (*q == '`')
+	    break;
+	q++;
+    }
+    seal_yylval.symbol = stringtable.add_chars((char *) s, strnlen(s, q - s));
+    scan_pos = q + 1;
+    return CONST_STRING;
+}
+
+int seal_scan_lex()
+{
+    const char *p = scan_pos;
+    for (;;) {
+	p = kernels->skip_space(p);
+	if (p >= scan_end) {
+	    scan_pos = scan_end;
+	    return 0;
+	}
+
+	const char *s = p;
+	switch (*p) {
+	case '/':
+	    if (p[1] == '/') {
+		// to the end of the line, which is consumed too
+		for (p += 2; ; p++) {
+		    p = kernels->find_line_end(p);
+		    if (p >= scan_end) break;
+		    if (*p == '\n') { p++; break; }
+		}
+		continue;
+	    }
+	    if (p[1] == '*') {
+		for (p += 2; ; p++) {
+		    p = kernels->find_comment_end(p);
+		    if (p >= scan_end) {
+			lex_message << line_at(p) << ": Comment meets an EOF.\n";
+			return lexical_error();
+		    }
+		    if (*p == '*') { p += 2; break; }
+		}
+		continue;
+	    }
+	    scan_pos = p + 1;
+	    return '/';
+	case '*':
+	    if (p[1] == '/') {
+		lex_message << line_at(p) << ": Unmatched */.\n";
+		return lexical_error();
+	    }
+	    scan_pos = p + 1;
+	    return '*';
+	case '=':
+	    if (p[1] == '=') { scan_pos = p + 2; return EQUAL; }
+	    scan_pos = p + 1;
+	    return '=';
+	case '&':
+	    if (p[1] == '&') { scan_pos = p + 2; return AND; }
+	    scan_pos = p + 1;
+	    return '&';
+	case '|':
+	    if (p[1] == '|') { scan_pos = p + 2; return OR; }
+	    scan_pos = p + 1;
+	    return '|';
+	case '!':
+	    if (p[1] == '=') { scan_pos = p + 2; return NE; }
+	    scan_pos = p + 1;
+	    return '!';
+	case '<':
+	    if (p[1] == '=') { scan_pos = p + 2; return LE; }
+	    scan_pos = p + 1;
+	    return '<';
+	case '>':
+	    if (p[1] == '=') { scan_pos = p + 2; return GE; }
+	    scan_pos = p + 1;
+	    return '>';
+	case '{': case '}': case '(': case ')': case '~': case ',':
+	case ';': case '+': case '-': case '%': case '^':
+	    scan_pos = p + 1;
+	    return *p;
+	case '"':
+	    return scan_quoted(p + 1);
+	case '`':
+	    return scan_raw(p + 1);
+	case '0': case '1': case '2': case '3': case '4':
+	case '5': case '6': case '7': case '8': case '9':
+	    return scan_number(p);
+	}
+
+	if (*p >= 'a' && *p <= 'z') {
+	    p = kernels->skip_word(p);
+	    scan_pos = p;
+	    int kw = keyword(s, p - s);
+	    if (kw)
+		return kw;
+	    seal_yylval.symbol = idtable.add_chars((char *) s, p - s);
+	    return OBJECTID;
+	}
+	if (*p >= 'A' && *p <= 'Z') {
+	    p = kernels->skip_word(p);
+	    if (!is_type_name(s, p - s))
+		return lex_error("Illegal Type name ", s, p - s);
+	    scan_pos = p;
+	    seal_yylval.symbol = idtable.add_chars((char *) s, p - s);
+	    return TYPEID;
+	}
+	return lex_error("Illegal character ", s, 1);
+    }
+}
@@ -0,0 +1,304 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+///////////////////////////////////////////////////////////////////////////
+//
+// file: seal-split.cc
+//
+// Parallel parsing of one source file, used for -j N outside batch
+// mode.  A SEAL program is a flat list of top-level declarations, so
+// the source can be cut between two of them and the pieces parsed on
+// their own:
+//
+//   1. A pre-scan finds where each top-level declaration ends -- after
+//      a ';' or a '}' at brace depth 0 -- skipping comments and string
+//      constants the way the lexer does.
+//   2. The declarations are grouped into pieces of about equal size.
+//      Worker threads take pieces in turn; each runs its own scanner
+//      and parser over its piece, starting at the piece's location in
+//      the file, so every node gets the location it would have had
+//      anyway.
+//   3. The Decls of the pieces are appended in source order under one
+//      Program.
+//
+// The workers intern into the parsing thread's string tables through
+// per-thread caches (see StringTable::share), so Symbols compare equal
+// across pieces, and hand their AST chunks over to the parsing
+// thread's arena.
+//
+// Only a program that parses cleanly is handled here.  If any piece
+// has a lexical or syntax error -- or the pre-scan finds nothing to
+// split -- everything is thrown away and the caller parses the file
+// the ordinary way, which reports the errors exactly as before.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <atomic>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "seal-lex.h"
+#include "seal-parse.h"
+#include "seal-stmt.h"
+#include "stats.h"
+#include "stringtab.h"
+#include "utilities.h"
+
+extern thread_local FILE *fin;
+extern thread_local SourceLoc node_loc;
+
+// pieces per thread; more than one evens out pieces of unequal cost
+#define PIECES_PER_THREAD 4
+
+struct Piece {
+    size_t begin, end;          // byte range of the source
+    Program program;            // the parse, if it succeeded
+    bool ok;
+    long tokens;                // -X counters of the piece
+    long descent_fallbacks;
+    long nodes[NODE_KIND_COUNT];
+};
+
+struct Split {
+    const char *text;
+    SourceLoc start;            // location of text[0]
+    std::vector<Piece> pieces;
+    std::atomic<size_t> next;   // next piece to parse
+    std::mutex arena_lock;      // held while handing nodes to ast_arena
+    AstArena *arena;            // the parsing thread's tables and arena
+    IdTable *ids;
+    StrTable *strings;
+    IntTable *ints;
+    FloatTable *floats;
+    IdTable *float_spellings;
+};
+
+// Read all of input, a regular file, into text; false if it is not one.
+static bool read_source(FILE *input, std::string &text)
+{
+    struct stat st;
+    if (fstat(fileno(input), &st) != 0 || !S_ISREG(st.st_mode))
+        return false;
+    text.resize(st.st_size);
+    size_t n = fread(&text[0], 1, text.size(), input);
+    text.resize(n);
+    return true;
+}
+
+// the bytes the pre-scan has to look at; it skips over the rest
+static bool special[256];
+
+static int init_special()
+{
+    for (const char *p = "/\"`{};"; *p; p++)
+        special[(unsigned char) *p] = true;
+    return 0;
+}
+
+static int special_ready = init_special();
+
+//
+// The pre-scan.  Appends to ends the offset just past each top-level
+// declaration.  Returns false if the braces do not balance, in which
+// case the file is not split.
+//
+static bool find_declarations(const char *s, size_t len,
+                              std::vector<size_t> &ends)
+{
+    int depth = 0;
+    size_t i = 0;
+    while (i < len) {
+        while (i < len && !special[(unsigned char) s[i]])
+            i++;
+        if (i == len)
+            break;
+        char c = s[i++];
+        switch (c) {
+        case '/':
+            if (i < len && s[i] == '/') {
+                while (i < len && s[i] != '\n')
+                    i++;
+            } else if (i < len && s[i] == '*') {
+                i++;
+                while (i < len && !(s[i] == '*' && i + 1 < len && s[i + 1] == '/'))
+                    i++;
+                i += 2;
+            }
+            break;
+        case '"':
+            for (; i < len && s[i] != '"' && s[i] != '\n'; i++)
+                if (s[i] == '\\' && i + 1 < len)
+                    i++;
+            i++;
+            break;
+        case '`':
+            while (i < len && s[i] != '`')
+                i++;
+            i++;
+            break;
+        case '{':
+            depth++;
+            break;
+        case '}':
+            if (--depth < 0)
+                return false;
+            if (depth == 0)
+                ends.push_back(i);
+            break;
+        case ';':
+            if (depth == 0)
+                ends.push_back(i);
+            break;
+        }
+    }
+    return depth == 0;
+}
+
+// Parse one piece on the calling thread, a worker.
+static void parse_piece(Split *split, Piece &piece)
+{
+    FILE *f = fmemopen((void *) (split->text + piece.begin),
+                       piece.end - piece.begin, "r");
+    fin = f;
+    stats_reset();
+    SourceLoc start = split->start + piece.begin;
+    SealParse parse;
+    if (!(descent_parser && seal_descent_parse(f, start, &parse))) {
+        scanner_open(f, start);
+        seal_yyparse(&parse);
+        scanner_close();
+    }
+    fclose(f);
+
+    piece.program = parse.program;
+    piece.ok = parse.errors == 0 && parse.program != NULL &&
+               lex_message.str().empty();
+    piece.tokens = compile_stats.tokens;
+    piece.descent_fallbacks = compile_stats.descent_fallbacks;
+    for (int k = 0; k < NODE_KIND_COUNT; k++)
+        piece.nodes[k] = compile_stats.nodes[k];
+    // the piece's Program is replaced by the one for the whole file
+    if (parse.program != NULL)
+        piece.nodes[NODE_PROGRAM]--;
+
+    std::lock_guard<std::mutex> hold(split->arena_lock);
+    split->arena->adopt(ast_arena);
+}
+
+static void worker(Split *split)
+{
+    // syntax errors are reported by the sequential parse, if at all
+    std::ostringstream discarded;
+    diag_stream = &discarded;
+    idtable.share(split->ids);
+    stringtable.share(split->strings);
+    inttable.share(split->ints);
+    floattable.share(split->floats);
+    floatspellings.share(split->float_spellings);
+
+    size_t i;
+    while ((i = split->next++) < split->pieces.size())
+        parse_piece(split, split->pieces[i]);
+
+    idtable.share(NULL);
+    stringtable.share(NULL);
+    inttable.share(NULL);
+    floattable.share(NULL);
+    floatspellings.share(NULL);
+}
+
+//
+// Parse input into parse on up to threads threads.  Returns 1 if that
+// worked; 0 if the caller should parse input itself, in which case
+// input is back at its beginning and nothing else has changed.
+//
+int seal_split_parse(FILE *input, SourceLoc start, int threads,
+                     SealParse *parse)
+{
+    std::string text;
+    if (!read_source(input, text)) {
+        rewind(input);
+        return 0;
+    }
+
+    std::vector<size_t> ends;
+    bool balanced = find_declarations(text.data(), text.size(), ends);
+    if (!balanced || ends.size() < 2) {
+        rewind(input);
+        return 0;
+    }
+
+    Split split;
+    split.text = text.data();
+    split.start = start;
+    split.next = 0;
+    split.arena = &ast_arena;
+    split.ids = &idtable;
+    split.strings = &stringtable;
+    split.ints = &inttable;
+    split.floats = &floattable;
+    split.float_spellings = &floatspellings;
+
+    // cut after the declaration that brings a piece to its share of the
+    // text; anything after the last declaration joins the last piece
+    size_t target = text.size() / (threads * PIECES_PER_THREAD) + 1;
+    Piece piece;
+    piece.begin = 0;
+    for (size_t d = 0; d + 1 < ends.size(); d++) {
+        if (ends[d] - piece.begin < target)
+            continue;
+        piece.end = ends[d];
+        split.pieces.push_back(piece);
+        piece.begin = ends[d];
+    }
+    piece.end = text.size();
+    split.pieces.push_back(piece);
+
+    int n = threads;
+    if ((size_t) n > split.pieces.size())
+        n = split.pieces.size();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < n; t++)
+        workers.push_back(std::thread(worker, &split));
+    for (int t = 0; t < n; t++)
+        workers[t].join();
+
+    bool ok = true;
+    for (size_t i = 0; i < split.pieces.size(); i++)
+        ok = ok && split.pieces[i].ok;
+    if (!ok) {
+        ast_arena.release();
+        idtable.release();
+        stringtable.release();
+        inttable.release();
+        floattable.release();
+        floatspellings.release();
+        rewind(input);
+        return 0;
+    }
+
+    Program first = split.pieces[0].program;
+    Decls decls = first->get_decls();
+    for (size_t i = 1; i < split.pieces.size(); i++)
+        decls = append_Decls(decls, split.pieces[i].program->get_decls());
+    node_loc = first->get_location();
+    parse->program = program(decls);
+
+    // every piece but the last read an end of input the file has once
+    for (size_t i = 0; i < split.pieces.size(); i++) {
+        Piece &p = split.pieces[i];
+        compile_stats.tokens += p.tokens - (i + 1 < split.pieces.size());
+        compile_stats.descent_fallbacks += p.descent_fallbacks;
+        for (int k = 0; k < NODE_KIND_COUNT; k++)
+            compile_stats.nodes[k] += p.nodes[k];
+    }
+    return 1;
+}
@@ -12,13 +12,14 @@ protected:
 public:
     Program_class(Decls a1) {
        decls = a1;
+       set_kind(NODE_PROGRAM);
     }
     Program copy_Program();
 	tree_node *copy()		 { return copy_Program(); }
+	Decls get_decls()		 { return decls; }
     void dump(ostream& stream, int n);
-    void dump_with_types(ostream&, int);
 
-	void semant();
+	int semant();
 	// for semantic analysis
 };
 
@@ -27,9 +28,7 @@ class Stmt_class : public tree_node {
 public:
 	tree_node *copy()		 { return copy_Stmt(); }
 	virtual Stmt copy_Stmt() = 0;
-	virtual void dump_with_types(ostream&,int) = 0; 
 	virtual void dump(ostream&,int) = 0;
-	virtual void check(Symbol) = 0;
 };
 
 class StmtBlock_class : public Stmt_class {
@@ -40,15 +39,14 @@ public:
 	StmtBlock_class(VariableDecls a1, Stmts a2) {
 		vars = a1;
 	    stmts = a2;
+		set_kind(NODE_STMT_BLOCK);
 	}
 	Stmt copy_Stmt(){return copy_StmtBlock();}
 	Stmts getStmts(){return stmts;}
 
 	VariableDecls getVariableDecls(){return vars;};
 	StmtBlock copy_StmtBlock();
-	void check(Symbol);
 	void dump(ostream& , int );
-	void dump_with_types(ostream&,int);
 };
 
 class IfStmt_class : public Stmt_class {
@@ -61,14 +59,13 @@ public:
 		condition = a1;
 		thenexpr = a2;
 		elseexpr = a3;
+		set_kind(NODE_IF);
 	}
 	Expr getCondition(){return condition;}
 	StmtBlock getThen(){return thenexpr;}
 	StmtBlock getElse(){return elseexpr;}
     Stmt copy_Stmt();
-	void check(Symbol);
 	void dump(ostream& stream, int n);
-	void dump_with_types(ostream&,int);
 };
 
 
@@ -82,13 +79,12 @@ public:
     WhileStmt_class(Expr a1, StmtBlock a2) {
 		condition = a1;
 		body = a2;
+		set_kind(NODE_WHILE);
 	}
 	Expr getCondition(){return condition;}
 	StmtBlock getBody(){return body;}
     Stmt copy_Stmt();
-	void check(Symbol);
 	void dump(ostream& stream, int n);
-	void dump_with_types(ostream&,int);
 };
 
 class ForStmt_class : public Stmt_class {
@@ -101,15 +97,14 @@ public:
 		condition = a2;
 		loopact = a3;
 		body = a4;
+		set_kind(NODE_FOR);
 	}
 	Expr getInit(){return initexpr;}
 	Expr getCondition(){return condition;}
 	Expr getLoop(){return loopact;}
 	StmtBlock getBody(){return body;}
-	void check(Symbol);
     Stmt copy_Stmt();
 	void dump(ostream& stream, int n);
-	void dump_with_types(ostream&,int);
 };
 
 
@@ -120,30 +115,25 @@ protected:
 public:
 	ReturnStmt_class(Expr a2) {
         value = a2;
+        set_kind(NODE_RETURN);
     }
 	Expr getValue(){return value;}
     Stmt copy_Stmt();
-	void check(Symbol);
-    void dump_with_types(ostream&,int);
     void dump(ostream& stream, int n);
 };
 
 class ContinueStmt_class : public Stmt_class {
 public:
-	ContinueStmt_class() {}
+	ContinueStmt_class() { set_kind(NODE_CONTINUE); }
     Stmt copy_Stmt();
-	void check(Symbol);
-    void dump_with_types(ostream&,int);
     void dump(ostream& stream, int n);
 };
 
 
 class BreakStmt_class : public Stmt_class {
 public:
-	BreakStmt_class() {}
+	BreakStmt_class() { set_kind(NODE_BREAK); }
     Stmt copy_Stmt();
-	void check(Symbol);
-    void dump_with_types(ostream&,int);
     void dump(ostream& stream, int n);
 };
 
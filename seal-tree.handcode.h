@@ -8,8 +8,7 @@
 #include "tree.h"
 #include "seal.h"
 #include "stringtab.h"
-#define yylineno curr_lineno;
-extern int yylineno;
+#include "dumpwriter.h"
 
 inline Boolean copy_Boolean(Boolean b) {return b; }
 inline void assert_Boolean(Boolean) {}
@@ -0,0 +1,554 @@
+/*
+*  seal.y
+*              Parser definition for the SEAL language.
+*
+*/
+%{
+  /* Locations are Bison's own YYLTYPE, of which only first_line is
+  used: it holds the SourceLoc of the token (see source.h), and LOC
+  gets it back.  Bison can move the stacks only if it knows the location type
+  to be trivial, which it does for its own; they start with YYINITDEPTH
+  entries and are moved to twice the size whenever they fill up, so
+  nesting is limited only by memory. */
+  #define YYMAXDEPTH 100000000
+
+  #include <iostream>
+  #include "seal-decl.h"
+  #include "seal-stmt.h"
+  #include "seal-expr.h"
+  #include "seal-lex.h"
+  #include "stats.h"
+  #include "stringtab.h"
+  #include "utilities.h"
+
+  extern thread_local char *curr_filename;
+
+    extern thread_local SourceLoc node_loc; /* set before constructing a tree node
+    to whatever you want the location
+    for the tree node to be */
+
+    #define LOC(Current) ((SourceLoc) (Current).first_line)
+
+      #define YYLLOC_DEFAULT(Current, Rhs, N)         \
+      (Current) = (Rhs)[1];                           \
+      node_loc = LOC(Current);
+
+
+    #define SET_NODELOC(Current)  \
+    node_loc = LOC(Current);
+
+    /* IMPORTANT NOTE ON LINE NUMBERS
+    *********************************
+    * The above definitions and macros cause every terminal in your grammar to
+    * have the line number supplied by the lexer. The only task you have to
+    * implement for line numbers to work correctly, is to use SET_NODELOC()
+    * before constructing any constructs from non-terminals in your grammar.
+    * Example: Consider you are matching on the following very restrictive
+    * (fictional) construct that matches a plus between two integer constants.
+    * (SUCH A RULE SHOULD NOT BE  PART OF YOUR PARSER):
+
+    plus_consts	: INT_CONST '+' INT_CONST
+
+    * where INT_CONST is a terminal for an integer constant. Now, a correct
+    * action for this rule that attaches the correct line number to plus_const
+    * would look like the following:
+
+    plus_consts	: INT_CONST '+' INT_CONST
+    {
+      // Set the line number of the current non-terminal:
+      // ***********************************************
+      // You can access the line numbers of the i'th item with @i, just
+      // like you acess the value of the i'th exporession with $i.
+      //
+      // Here, we choose the line number of the last INT_CONST (@3) as the
+      // line number of the resulting expression (@$). You are free to pick
+      // any reasonable line as the line number of non-terminals. If you
+      // omit the statement @$=..., bison has default rules for deciding which
+      // line number to use. Check the manual for details if you are interested.
+      @$ = @3;
+
+
+      // Observe that we call SET_NODELOC(@3); this will set the global variable
+      // node_loc to @3. Since the constructor call "plus" uses the value of
+      // this global, the plus node will now have the correct line number.
+      SET_NODELOC(@3);
+
+      // construct the result node:
+      $$ = plus(int_const($1), int_const($3));
+    }
+
+    */
+
+
+
+    /* The parser is pure: a parse keeps its stacks, lookahead and
+    result to itself, so any number of parses can be in progress at
+    once.  It can be driven either way:
+
+    seal_yyparse(&parse) pulls tokens from the scanner until the end of
+    input, or
+
+    a caller holding a seal_yypstate hands it one token at a time with
+    seal_push_token, which returns YYPUSH_MORE until the token that
+    ends the parse.
+
+    Either way parse.program is the result, and parse.errors the number
+    of errors reported.  A lexical error is one of them, and the last:
+    the parse ends at it, with parse.lex_error set. */
+
+    %}
+
+    %define api.pure full
+    %define api.push-pull both
+    %name-prefix "seal_yy"
+    %locations
+    %debug
+    %parse-param {SealParse *parse}
+    %lex-param {SealParse *parse}
+
+    /* repeated in seal-parse.h for the rest of the compiler */
+    %code provides {
+    struct SealParse {
+      Program program;            /* the result, once the parse is accepted */
+      int errors;                 /* syntax and lexical errors reported */
+      bool lex_error;             /* the parse ended at a lexical error */
+      int token;                  /* the lookahead, for error messages */
+      YYSTYPE value;
+
+      SealParse() : program(NULL), errors(0), lex_error(false), token(0) { }
+    };
+
+    int seal_push_token(seal_yypstate *ps, int token, YYSTYPE *value,
+                        SourceLoc loc, SealParse *parse);
+    void seal_lex_error(SealParse *parse, const std::string &message);
+    }
+
+    /* after the definitions of YYSTYPE and YYLTYPE */
+    %code {
+    void yyerror(YYLTYPE *loc, SealParse *parse, const char *s);
+    static int yylex(YYSTYPE *value, YYLTYPE *loc, SealParse *parse);
+    }
+
+    /* A union of all the types that can be the result of parsing actions. */
+    %union {
+      Boolean boolean;
+      Symbol symbol;
+      Program program;
+      Decl decl;
+      Decls decls;
+      VariableDecl variableDecl;
+      VariableDecls variableDecls;
+      Variable variable;
+      Variables variables;
+      CallDecl callDecl;
+      StmtBlock stmtBlock;
+      Stmt stmt;
+      Stmts stmts;
+      IfStmt ifStmt;
+      WhileStmt whileStmt;
+      ForStmt forStmt;
+      ReturnStmt returnStmt;
+      ContinueStmt continueStmt;
+      BreakStmt breakStmt;
+      Expr expr;
+      Exprs exprs;
+      Call call;
+      Actual actual;
+      Actuals actuals;
+
+      char *error_msg;
+    }
+
+    /*
+    Declare the terminals; a few have types for associated lexemes.
+    The token ERROR is never used in the parser; thus, it is a parse
+    error when the lexer returns it.
+
+    The token numbers are the ones in seal-parse.h, which the lexers
+    return.
+    */
+
+    %token IF 258 ELSE 260 WHILE 261 FOR 262 BREAK 263 CONTINUE 264 FUNC 265 RETURN 266
+    %token VAR 271 ERROR 273 AND 274 OR 275 EQUAL 276 NE 277 GE 278 LE 279
+    %token INT 280 STRING 281 BOOL 282 FLOAT 283
+    %token <boolean> CONST_BOOL 267
+    %token <symbol>  CONST_INT 268 CONST_STRING 269 CONST_FLOAT 270
+    %token <symbol>  OBJECTID 284 TYPEID 285
+    %token UMINUS 287
+
+    /*  DON'T CHANGE ANYTHING ABOVE THIS LINE, OR YOUR PARSER WONT WORK       */
+    /**************************************************************************/
+
+    /* Declare types for the grammar's non-terminals. */
+    %type <program> program
+    %type <decl> decl
+    %type <decls> decl_list
+    %type <variableDecl> variableDecl
+    %type <variableDecls> variableDecl_list
+    %type <variable> variable
+    %type <variables> variable_list
+    %type <callDecl> callDecl
+    %type <stmtBlock> stmtBlock
+    %type <stmt> stmt
+    %type <stmts> stmt_list
+    %type <ifStmt> ifStmt
+    %type <whileStmt> whileStmt
+    %type <forStmt> forStmt
+    %type <breakStmt> breakStmt
+    %type <continueStmt> continueStmt
+    %type <returnStmt> returnStmt
+    %type <expr> expr
+    %type <call> call
+    %type <actual> actual
+    %type <actuals> actual_list
+
+    /* Precedence declarations go here. */
+    %right '='
+    %right OR
+    %right AND
+    %nonassoc EQUAL NE
+    %nonassoc '<' '>' LE GE
+    %left '+' '-'
+    %left '*' '/' '%'
+    %right UMINUS '!' '~'
+    %left '&' '|' '^'
+    %left '.'
+
+    %%
+    /*
+    Save the root of the abstract syntax tree in the parse.
+    */
+    program	: decl_list	{
+					@$ = @1;
+					parse->program = program($1);
+				}
+			;
+
+decl		: variableDecl	{
+					$$ = $1;
+				}
+			| callDecl	{
+					$$ = $1;
+				}
+			;
+
+decl_list	: decl	{
+					$$ = single_Decls($1);
+				}
+			| decl_list decl	{
+					$$ = append_Decls($1, single_Decls($2));
+				}
+			;
+
+
+variableDecl	: VAR variable ';'	{
+					$$ = variableDecl($2);
+				}
+			;
+
+variableDecl_list	: variableDecl	{
+					$$ = single_VariableDecls($1);
+				}
+			| variableDecl_list variableDecl	{
+					$$ = append_VariableDecls($1, single_VariableDecls($2));
+				}
+			;
+
+variable	: OBJECTID TYPEID	{
+					$$ = variable($1, $2);
+				}
+			;
+
+variable_list	:	{
+					$$ = nil_Variables();
+				}
+			| variable	{
+					$$ = single_Variables($1);
+				}
+			| variable_list ',' variable	{
+					$$ = append_Variables($1, single_Variables($3));
+				}
+			;
+
+
+callDecl	: FUNC OBJECTID '(' variable_list ')' TYPEID stmtBlock	{
+					$$ = callDecl($2, $4, $6, $7);
+				}
+			;
+
+stmtBlock	: '{' variableDecl_list stmt_list '}'	{
+					$$ = stmtBlock($2, $3);
+				}
+			| '{' stmt_list '}'	{
+					$$ = stmtBlock(nil_VariableDecls(), $2);
+				}
+			| '{' variableDecl_list '}'	{
+					$$ = stmtBlock($2, nil_Stmts());
+				}
+			| '{' '}'	{
+					$$ = stmtBlock(nil_VariableDecls(), nil_Stmts());
+				}
+			;
+
+stmt		: ';'	{
+					$$ = no_expr();
+				}
+			| expr ';'	{
+					$$ = $1;
+				}
+			| ifStmt	{
+					$$ = $1;
+				}
+			| whileStmt	{
+					$$ = $1;
+				}
+			| forStmt	{
+					$$ = $1;
+				}
+			| breakStmt	{
+					$$ = $1;
+				}
+			| continueStmt	{
+					$$ = $1;
+				}
+			| returnStmt	{
+					$$ = $1;
+				}
+			| stmtBlock	{
+					$$ = $1;
+				}
+			;
+
+stmt_list	: stmt	{
+					$$ = single_Stmts($1);
+				}
+			| stmt_list stmt	{
+					$$ = append_Stmts($1, single_Stmts($2));
+				}
+			;
+
+ifStmt		: IF expr stmtBlock	{
+					$$ = ifstmt($2, $3, stmtBlock(nil_VariableDecls(), nil_Stmts()));
+				}
+			| IF expr stmtBlock ELSE stmtBlock	{
+					$$ = ifstmt($2, $3, $5);
+				}
+			;
+
+whileStmt	: WHILE expr stmtBlock	{
+					$$ = whilestmt($2, $3);
+				}
+			;
+
+forStmt		: FOR expr ';' expr ';' expr stmtBlock	{
+					$$ = forstmt($2, $4, $6, $7);
+				}
+			| FOR ';' expr ';' expr stmtBlock	{
+					$$ = forstmt(no_expr(), $3, $5, $6);
+				}
+			| FOR expr ';' ';' expr stmtBlock	{
+					$$ = forstmt($2, no_expr(), $5, $6);
+				}
+			| FOR expr ';' expr ';' stmtBlock	{
+					$$ = forstmt($2, $4, no_expr(), $6);
+				}
+			| FOR ';' ';' expr stmtBlock	{
+					$$ = forstmt(no_expr(), no_expr(), $4, $5);
+				}
+			| FOR ';' expr ';' stmtBlock	{
+					$$ = forstmt(no_expr(), $3, no_expr(), $5);
+				}
+			| FOR expr ';' ';' stmtBlock	{
+					$$ = forstmt($2, no_expr(), no_expr(), $5);
+				}
+			| FOR ';' ';' stmtBlock	{
+					$$ = forstmt(no_expr(), no_expr(), no_expr(), $4);
+				}
+			;
+
+breakStmt	: BREAK ';'	{
+					$$ = breakstmt();
+				}
+			;
+
+continueStmt	: CONTINUE ';'	{
+					$$ = continuestmt();
+				}
+			;
+
+returnStmt	: RETURN expr ';'	{
+					$$ = returnstmt($2);
+				}
+			| RETURN ';'	{
+					$$ = returnstmt(no_expr());
+				}
+			;
+
+expr		: OBJECTID '=' expr	{
+					$$ = assign($1, $3);
+				}
+			| CONST_INT	{
+					$$ = const_int($1);
+				}
+			| CONST_STRING	{
+					$$ = const_string($1);
+				}
+			| CONST_FLOAT	{
+					$$ = const_float($1);
+				}
+			| CONST_BOOL	{
+					$$ = const_bool($1);
+				}
+			| OBJECTID	{
+					$$ = object($1);
+				}
+			| call	{
+					$$ = $1;
+				}
+			| '(' expr ')'	{
+					$$ = $2;
+				}
+			| expr '+' expr	{
+					$$ = add($1, $3);
+				}
+			| expr '-' expr	{
+					$$ = minus($1, $3);
+				}
+			| expr '*' expr	{
+					$$ = multi($1, $3);
+				}
+			| expr '/' expr	{
+					$$ = divide($1, $3);
+				}
+			| expr '%' expr	{
+					$$ = mod($1, $3);
+				}
+			| '-' expr %prec UMINUS	{
+					$$ = neg($2);
+				}
+			| expr '<' expr	{
+					$$ = lt($1, $3);
+				}
+			| expr LE expr	{
+					$$ = le($1, $3);
+				}
+			| expr EQUAL expr	{
+					$$ = equ($1, $3);
+				}
+			| expr NE expr	{
+					$$ = neq($1, $3);
+				}
+			| expr GE expr	{
+					$$ = ge($1, $3);
+				}
+			| expr '>' expr	{
+					$$ = gt($1, $3);
+				}
+			| expr AND expr	{
+					$$ = and_($1, $3);
+				}
+			| expr OR expr	{
+					$$ = or_($1, $3);
+				}
+			| '!' expr	{
+					$$ = not_($2);
+				}
+			| '~' expr %prec '.'	{
+					$$ = bitnot($2);
+				}
+			| expr '&' expr	{
+					$$ = bitand_($1, $3);
+				}
+			| expr '|' expr	{
+					$$ = bitor_($1, $3);
+				}
+			| expr '^' expr	{
+					$$ = xor_($1, $3);
+				}
+			;
+
+call		: OBJECTID '(' actual_list ')'	{
+					$$ = call($1, $3);
+				}
+			;
+
+actual		: expr	{
+					$$ = actual($1);
+				}
+			;
+
+actual_list	:	{
+					$$ = nil_Actuals();
+				}
+			| actual	{
+					$$ = single_Actuals($1);
+				}
+			| actual_list ',' actual	{
+					$$ = append_Actuals($1, single_Actuals($3));
+				}
+			;
+
+/* end of grammar */
+%%
+
+    extern thread_local YYSTYPE seal_yylval;
+
+    /* Note the lookahead for yyerror; every token the parser reads
+    passes through here. */
+    static int lookahead(SealParse *parse, int token, YYSTYPE *value)
+    {
+      stats_token();
+      parse->token = token > 0 ? token : 0;
+      parse->value = *value;
+      return token;
+    }
+
+    /* The pull parser's lexer: the next token from the scanner, with its
+    location. */
+    static int yylex(YYSTYPE *value, YYLTYPE *loc, SealParse *parse)
+    {
+      int token = scanner_lex();
+      if (token == LEX_ERROR) {
+        seal_lex_error(parse, lex_message.str());
+        /* straight to error recovery, which finds no error rule and
+        aborts the parse, without a syntax error of its own */
+        token = YYerror;
+      }
+      *value = seal_yylval;
+      loc->first_line = loc->last_line = curr_loc;
+      return lookahead(parse, token, value);
+    }
+
+    /* Hand the push parser ps the next token, its value and its
+    location.  Returns YYPUSH_MORE until the parse is over, then 0 if
+    it succeeded. */
+    int seal_push_token(seal_yypstate *ps, int token, YYSTYPE *value,
+                        SourceLoc loc, SealParse *parse)
+    {
+      YYLTYPE l;
+      l.first_line = l.last_line = loc;
+      l.first_column = l.last_column = 0;
+      lookahead(parse, token, value);
+      return seal_yypush_parse(ps, token, value, &l, parse);
+    }
+
+    /* Report the lexical error whose message is message, and count it
+    with the syntax errors, so that the file fails. */
+    void seal_lex_error(SealParse *parse, const std::string &message)
+    {
+      *diag_stream << message;
+      parse->errors++;
+      parse->lex_error = true;
+    }
+
+    /* This function is called automatically when Bison detects a parse error. */
+    void yyerror(YYLTYPE *loc, SealParse *parse, const char *s)
+    {
+      *diag_stream << "\"" << curr_filename << "\", line " << source_manager.line(LOC(*loc)) << ": " \
+      << s << " at or near ";
+      print_seal_token(parse->token, &parse->value);
+      *diag_stream << endl;
+      parse->errors++;
+
+      if(parse->errors>50) {fprintf(stdout, "More than 50 errors\n"); exit(1);}
+    }
@@ -1,33 +1,262 @@
 #include <stdio.h>
 #include <unistd.h>    // for getopt
-#include "seal-decl.h"
-#include "seal-expr.h"
-#include "seal-stmt.h"
+#include <string>
+#include <sstream>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include "semant.h"
+#include "utilities.h"
+#include "stats.h"
+#include "flatast.h"
+#include "seal-lex.h"
+#include "seal-parse.h"
 
-extern Program ast_root;      // root of the abstract syntax tree
-FILE *fin;                    // input file
+//
+// Everything a compilation touches is thread_local, so each thread of
+// a parallel batch has its own lexer, parser, tables, arena and checker.
+//
+thread_local Program ast_root; // root of the abstract syntax tree
+thread_local FILE *fin;       // input file
+thread_local SourceLoc fin_start;  // location of its first byte
 extern int optind;  // used for option processing (man 3 getopt for more info)
-extern int seal_yyparse(void); // entry point to the AST parser
-extern int omerrs;            // syntax check errors
-char *curr_filename = "<stdin>";
+thread_local int omerrs = 0;  // syntax check errors
+thread_local bool lex_failed = false;  // the parse ended at a lexical error
+extern thread_local SourceLoc node_loc; // location given to new tree nodes
+extern int mem_stats;         // -M: report string table and AST memory
+extern int batch_mode;        // -b: compile many files in one process
+extern int num_jobs;          // -j: threads for a batch, or for one parse
+extern int flat_ast;          // -A: check and dump a flat copy of the AST
+thread_local char *curr_filename = "<stdin>";
+
+static std::mutex report_lock;  // serializes writes to cerr from workers
 
 void handle_flags(int argc, char *argv[]);
 
+static void print_ast_memory() {
+  cerr << "ast: " << ast_arena.bytes_used() << " node bytes ("
+       << ast_arena.bytes_reserved() << " reserved)\n";
+}
+
+// with -A the pointer AST is gone by now, and print_ast_memory has
+// reported it
+static void print_memory_stats(FlatAst *flat) {
+  idtable.print_stats(cerr, "idtable");
+  stringtable.print_stats(cerr, "stringtable");
+  inttable.print_stats(cerr, "inttable");
+  floattable.print_stats(cerr, "floattable");
+  floatspellings.print_stats(cerr, "floatspellings");
+  if (flat)
+    cerr << "flat ast: " << flat->size() << " nodes, "
+         << flat->bytes_used() << " bytes (" << flat->bytes_reserved()
+         << " reserved)\n";
+  else
+    print_ast_memory();
+}
+
+// free every AST node and interned symbol at once, and forget the
+// source file; the AST must not be used afterwards
+static void release_compilation() {
+  ast_root = NULL;
+  source_manager.remove_file(fin_start);
+  ast_arena.release();
+  idtable.release();
+  stringtable.release();
+  inttable.release();
+  floattable.release();
+  floatspellings.release();
+}
+
+//
+// Parse fin into ast_root.  With -j N a single file is split at its
+// top-level declarations and parsed on N threads (seal-split.cc); the
+// lexer thread of -P and batch mode's own threads take precedence.
+// With -R the hand-written parser (seal-descent.cc) has the first go,
+// and bison parses whatever it gives up on.
+//
+static void parse() {
+  SealParse parse;
+  if (pipeline_lexer) {
+    seal_pipe_parse(fin, fin_start, &parse);
+  } else if (!(num_jobs > 1 && !batch_mode &&
+               seal_split_parse(fin, fin_start, num_jobs, &parse)) &&
+             !(descent_parser && seal_descent_parse(fin, fin_start, &parse))) {
+    scanner_open(fin, fin_start);
+    seal_yyparse(&parse);
+    scanner_close();
+  }
+  ast_root = parse.program;
+  omerrs = parse.errors;
+  lex_failed = parse.lex_error;
+}
+
+//
+// Check and dump ast_root by way of a flat copy of it (-A).  Returns 0
+// on success and 1 on semantic errors.  The pointer AST is freed as
+// soon as the copy is made, so the two are never held at once past
+// that point.
+//
+static int run_flat_phases(ostream& out) {
+  FlatAst flat;
+  stats_phase(PHASE_FLATTEN);
+  flat.build(ast_root, ast_arena.node_count());
+  stats_phase(PHASE_NONE);
+  if (mem_stats)
+    print_ast_memory();
+  ast_root = NULL;
+  ast_arena.release();
+  if (flat.semant() > 0)
+    return 1;
+  {
+    stats_phase(PHASE_DUMP);
+    AstDumpWriter writer(out);
+    flat.dump_with_types(writer,0);
+    writer.flush();
+    stats_phase(PHASE_NONE);
+  }
+  if (mem_stats)
+    print_memory_stats(&flat);
+  return 0;
+}
+
+//
+// Parse, check and dump the program read from fin.  Returns 0 on
+// success, -1 on a syntax or lexical error and 1 on semantic errors.
+// A lexical error has been reported on diag_stream by the parser, and
+// nothing is written to out.
+//
+static int run_phases(ostream& out) {
+  stats_phase(PHASE_PARSE);
+  parse();
+  stats_phase(PHASE_NONE);
+  if (lex_failed)
+    return -1;
+  if(omerrs != 0 || ast_root == NULL){
+    out << "syntax analyze failed. Please make sure syntax parser passed." << endl;
+    return -1;
+  }
+  if (flat_ast)
+    return run_flat_phases(out);
+  if (ast_root->semant() > 0)
+    return 1;
+  {
+    stats_phase(PHASE_DUMP);
+    AstDumpWriter writer(out);
+    ast_root->dump_with_types(writer,0);
+    writer.flush();
+    stats_phase(PHASE_NONE);
+  }
+  if (mem_stats)
+    print_memory_stats(NULL);
+  return 0;
+}
+
+// run_phases on fin, which is called filename, reporting -X statistics
+// afterwards
+static int compile(ostream& out, const char *filename) {
+  fin_start = source_manager.add_file(filename, fin);
+  stats_reset();
+  int result = run_phases(out);
+  if (stats_mode)
+    stats_print(*diag_stream, filename);
+  return result;
+}
+
+//
+// Compile one file of a batch, writing its dump to "<filename>.out".
+// Diagnostics are collected and written to cerr under the file's name.
+// The calling thread's compiler state is reset first.  Returns nonzero
+// on failure.
+//
+static int compile_batch_file(char *filename) {
+  fin = fopen(filename, "r");
+  if (fin == NULL) {
+    std::lock_guard<std::mutex> hold(report_lock);
+    cerr << "Could not open input file " << filename << endl;
+    return 1;
+  }
+  std::string out_name = std::string(filename) + ".out";
+  ofstream out(out_name.c_str());
+  if (!out) {
+    std::lock_guard<std::mutex> hold(report_lock);
+    cerr << "Could not open output file " << out_name << endl;
+    fclose(fin);
+    return 1;
+  }
+
+  curr_filename = filename;
+  omerrs = 0;
+  node_loc = 0;
+  reset_semant();
+
+  std::ostringstream diagnostics;
+  diag_stream = &diagnostics;
+  int result = compile(out, filename);
+  diag_stream = &cerr;
+  if (!diagnostics.str().empty()) {
+    std::lock_guard<std::mutex> hold(report_lock);
+    cerr << filename << ":\n" << diagnostics.str();
+  }
+
+  release_compilation();
+  fclose(fin);
+  return result;
+}
+
+//
+// Compile each file named on the command line, or, if there are none,
+// each file named on a line of standard input.  With -j N the files are
+// shared out to N threads; each thread takes the next unclaimed file.
+//
+static int batch_main(int argc, char *argv[]) {
+  std::vector<std::string> files;
+  if (optind < argc) {
+    for (int i = optind; i < argc; i++)
+      files.push_back(argv[i]);
+  } else {
+    std::string line;
+    while (std::getline(std::cin, line))
+      if (!line.empty())
+        files.push_back(line);
+  }
+
+  std::atomic<size_t> next(0);
+  std::atomic<int> failed(0);
+  auto worker = [&]() {
+    size_t i;
+    while ((i = next++) < files.size())
+      if (compile_batch_file(&files[i][0]) != 0)
+        failed++;
+  };
+
+  int jobs = num_jobs;
+  if ((size_t) jobs > files.size())
+    jobs = files.size();
+  std::vector<std::thread> threads;
+  for (int j = 1; j < jobs; j++)
+    threads.push_back(std::thread(worker));
+  worker();
+  for (size_t j = 0; j < threads.size(); j++)
+    threads[j].join();
+  return failed ? 1 : 0;
+}
+
 int main(int argc, char *argv[]) {
+  handle_flags(argc,argv);
+  if (batch_mode)
+    return batch_main(argc, argv);
+
   fin = fopen(argv[optind], "r");
 	    if (fin == NULL) {
 		cerr << "Could not open input file " << argv[optind] << endl;
 		exit(1);
 	}
-  curr_lineno = 1;
-  handle_flags(argc,argv);
-  seal_yyparse();
-  if(omerrs != 0 || ast_root == NULL){
-    cout << "syntax analyze failed. Please make sure syntax parser passed." << endl;
+  int result = compile(cout, argv[optind]);
+  if (result < 0)
     exit(-1);
-  }
-  ast_root->semant();
-  ast_root->dump_with_types(cout,0);
+  if (result > 0)
+    exit(1);
+  release_compilation();
   fclose(fin);
 }
-
@@ -3,27 +3,24 @@
 #include <stdarg.h>
 #include "semant.h"
 #include "utilities.h"
+#include "stats.h"
+#include "flatast.h"
+#include "visitor.h"
 
 extern int semant_debug;
-extern char *curr_filename;
+extern thread_local char *curr_filename;
 
-static ostream& error_stream = cerr;
-static int semant_errors = 0;
-static Decl curr_decl = 0;
-
-typedef SymbolTable<Symbol, Symbol> ObjectEnvironment; // name, type
-ObjectEnvironment objectEnv;
-
-
-//typedef SymbolTable<Symbol, Decl_class> Call_table;
-//Call_table call_table;
+//
+// All checker state is thread-local, so independent programs can be
+// checked concurrently on different threads.
+//
 
-typedef std::map<Symbol, Decl> Call_table;
-Call_table call_table;
+static thread_local int semant_errors = 0;
+static thread_local Decl curr_decl = 0;
 
-int inloop = 0;
-int inif = 0;
-bool returnflag = false;
+thread_local int inloop = 0;
+thread_local int inif = 0;
+thread_local bool returnflag = false;
 
 
 ///////////////////////////////////////////////
@@ -33,17 +30,17 @@ bool returnflag = false;
 
 static ostream& semant_error() {
     semant_errors++;
-    return error_stream;
+    return *diag_stream;
 }
 
-static ostream& semant_error(tree_node *t) {
-    error_stream << t->get_line_number() << ": ";
+static ostream& semant_error_at(SourceLoc loc) {
+    *diag_stream << source_manager.line(loc) << ": ";
     return semant_error();
 }
 
 static ostream& internal_error(int lineno) {
-    error_stream << "FATAL:" << lineno << ": ";
-    return error_stream;
+    *diag_stream << "FATAL:" << lineno << ": ";
+    return *diag_stream;
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -56,7 +53,7 @@ static ostream& internal_error(int lineno) {
 //
 //////////////////////////////////////////////////////////////////////
 
-static Symbol 
+static thread_local Symbol 
     Int,
     Float,
     String,
@@ -66,6 +63,25 @@ static Symbol
     print
     ;
 
+//
+// Dense ids for the basic types, used to index the operator rule tables.
+// TypeOther stands for any other type name; TypeError marks an operand
+// combination an operator rejects.
+//
+enum TypeId {
+    TypeInt,
+    TypeFloat,
+    TypeString,
+    TypeBool,
+    TypeVoid,
+    TypeOther,
+    TypeCount,
+    TypeError = TypeCount
+};
+
+static thread_local Symbol type_symbols[TypeOther];   // TypeId -> Symbol
+static thread_local std::vector<unsigned char> type_ids;   // idtable index -> TypeId
+
 
 bool isValidCallName(Symbol type) {
     return type != (Symbol)print;
@@ -91,6 +107,17 @@ static void initialize_constants(void) {
 
     // classical function to print things, so defined here for call.
     print        = idtable.add_string("printf");
+
+    type_symbols[TypeInt]    = Int;
+    type_symbols[TypeFloat]  = Float;
+    type_symbols[TypeString] = String;
+    type_symbols[TypeBool]   = Bool;
+    type_symbols[TypeVoid]   = Void;
+
+    type_ids.assign(idtable.size(), TypeOther);
+    for (int i = 0; i < TypeOther; i++) {
+        type_ids[type_symbols[i]->get_index()] = i;
+    }
 }
 
 /*
@@ -100,618 +127,1081 @@ static void initialize_constants(void) {
     Of course, you can add any other functions to help.
 */
 
+//
+// Every type and call name is interned in idtable, so two Symbols name
+// the same type exactly when they are the same Entry.
+//
 static bool sameType(Symbol name1, Symbol name2) {
-    return strcmp(name1->get_string(), name2->get_string()) == 0;
+    return name1 == name2;
+}
+
+//
+// Operator typing rules.  Each rule table maps the type ids of the
+// operands to the type id of the result, or TypeError if the operator
+// does not accept those operands.  The tables are constants; a type's
+// id comes from type_ids, so typing an operator takes one load from
+// its table.
+//
+
+static TypeId typeId(Symbol type) {
+    unsigned i = type->get_index();
+    return i < type_ids.size() ? (TypeId) type_ids[i] : TypeOther;
+}
+
+#define E TypeError
+struct ArithRule {
+    //                                                  Int        Float      String  Bool      Void  other
+    static constexpr TypeId rule[TypeCount][TypeCount] = {
+        /* Int    */                                  { TypeInt,   TypeFloat, E,      E,        E,    E },
+        /* Float  */                                  { TypeFloat, TypeFloat, E,      E,        E,    E },
+        /* String */                                  { E,         E,         E,      E,        E,    E },
+        /* Bool   */                                  { E,         E,         E,      E,        E,    E },
+        /* Void   */                                  { E,         E,         E,      E,        E,    E },
+        /* other  */                                  { E,         E,         E,      E,        E,    E },
+    };
+};
+
+struct ModRule {
+    static constexpr TypeId rule[TypeCount][TypeCount] = {
+        /* Int    */                                  { TypeInt,   E,         E,      E,        E,    E },
+        /* Float  */                                  { E,         E,         E,      E,        E,    E },
+        /* String */                                  { E,         E,         E,      E,        E,    E },
+        /* Bool   */                                  { E,         E,         E,      E,        E,    E },
+        /* Void   */                                  { E,         E,         E,      E,        E,    E },
+        /* other  */                                  { E,         E,         E,      E,        E,    E },
+    };
+};
+
+struct OrderRule {
+    static constexpr TypeId rule[TypeCount][TypeCount] = {
+        /* Int    */                                  { TypeBool,  TypeBool,  E,      E,        E,    E },
+        /* Float  */                                  { TypeBool,  TypeBool,  E,      E,        E,    E },
+        /* String */                                  { E,         E,         E,      E,        E,    E },
+        /* Bool   */                                  { E,         E,         E,      E,        E,    E },
+        /* Void   */                                  { E,         E,         E,      E,        E,    E },
+        /* other  */                                  { E,         E,         E,      E,        E,    E },
+    };
+};
+
+struct EqualityRule {
+    static constexpr TypeId rule[TypeCount][TypeCount] = {
+        /* Int    */                                  { TypeBool,  TypeBool,  E,      TypeBool, E,    E },
+        /* Float  */                                  { TypeBool,  TypeBool,  E,      TypeBool, E,    E },
+        /* String */                                  { E,         E,         E,      E,        E,    E },
+        /* Bool   */                                  { TypeBool,  TypeBool,  E,      TypeBool, E,    E },
+        /* Void   */                                  { E,         E,         E,      E,        E,    E },
+        /* other  */                                  { E,         E,         E,      E,        E,    E },
+    };
+};
+
+struct LogicRule {
+    static constexpr TypeId rule[TypeCount][TypeCount] = {
+        /* Int    */                                  { E,         E,         E,      E,        E,    E },
+        /* Float  */                                  { E,         E,         E,      E,        E,    E },
+        /* String */                                  { E,         E,         E,      E,        E,    E },
+        /* Bool   */                                  { E,         E,         E,      TypeBool, E,    E },
+        /* Void   */                                  { E,         E,         E,      E,        E,    E },
+        /* other  */                                  { E,         E,         E,      E,        E,    E },
+    };
+};
+
+struct NegRule {
+    static constexpr TypeId rule[TypeCount] =
+                                                  { TypeInt,   TypeFloat, E,      E,        E,    E };
+};
+
+struct NotRule {
+    static constexpr TypeId rule[TypeCount] =
+                                                  { E,         E,         E,      TypeBool, E,    E };
+};
+#undef E
+
+//
+// BinaryOp<Tag> and UnaryOp<Tag> describe the operator whose node class
+// is Tag: its rule, and the words around the operand types in the
+// error reported when the rule rejects them.
+//
+template <class Tag> struct BinaryOp;
+template <class Tag> struct UnaryOp;
+
+struct CompareWords {
+    static constexpr const char *before = "Cannot compare a ";
+    static constexpr const char *between = " and a ";
+};
+
+template <> struct BinaryOp<Add_class> : ArithRule {
+    static constexpr const char *before = "Cannot add a ";
+    static constexpr const char *between = " and a ";
+};
+template <> struct BinaryOp<Minus_class> : ArithRule {
+    static constexpr const char *before = "Cannot minus a ";
+    static constexpr const char *between = " and a ";
+};
+template <> struct BinaryOp<Multi_class> : ArithRule {
+    static constexpr const char *before = "Cannot multi a ";
+    static constexpr const char *between = " and a ";
+};
+template <> struct BinaryOp<Divide_class> : ArithRule {
+    static constexpr const char *before = "Cannot div a ";
+    static constexpr const char *between = " and a ";
+};
+template <> struct BinaryOp<Mod_class> : ModRule {
+    static constexpr const char *before = "Cannot mod a ";
+    static constexpr const char *between = " and a ";
+};
+template <> struct BinaryOp<Lt_class> : OrderRule, CompareWords { };
+template <> struct BinaryOp<Le_class> : OrderRule, CompareWords { };
+template <> struct BinaryOp<Ge_class> : OrderRule, CompareWords { };
+template <> struct BinaryOp<Gt_class> : OrderRule, CompareWords { };
+template <> struct BinaryOp<Equ_class> : EqualityRule, CompareWords { };
+template <> struct BinaryOp<Neq_class> : EqualityRule, CompareWords { };
+template <> struct BinaryOp<And_class> : LogicRule {
+    static constexpr const char *before = "Cannot use && between ";
+    static constexpr const char *between = " and ";
+};
+template <> struct BinaryOp<Or_class> : LogicRule {
+    static constexpr const char *before = "Cannot use || between ";
+    static constexpr const char *between = " and ";
+};
+template <> struct BinaryOp<Xor_class> : LogicRule {
+    static constexpr const char *before = "Cannot use ^ between ";
+    static constexpr const char *between = " and ";
+};
+template <> struct BinaryOp<Bitand_class> : LogicRule {
+    static constexpr const char *before = "Cannot use & between ";
+    static constexpr const char *between = " and ";
+};
+template <> struct BinaryOp<Bitor_class> : LogicRule {
+    static constexpr const char *before = "Cannot use | between ";
+    static constexpr const char *between = " and ";
+};
+
+template <> struct UnaryOp<Neg_class> : NegRule {
+    static constexpr const char *before = "A";
+    static constexpr const char *after = "doesn't have a negative.";
+};
+template <> struct UnaryOp<Not_class> : NotRule {
+    static constexpr const char *before = "Cannot use ! upon ";
+    static constexpr const char *after = ".";
+};
+template <> struct UnaryOp<Bitnot_class> : NotRule {
+    static constexpr const char *before = "Cannot use unary op ~ upon ";
+    static constexpr const char *after = ".";
+};
+
+static_assert(BinaryOp<Add_class>::rule[TypeInt][TypeFloat] == TypeFloat, "Int + Float is Float");
+static_assert(BinaryOp<Equ_class>::rule[TypeBool][TypeInt] == TypeBool, "Bool == Int is Bool");
+static_assert(UnaryOp<Not_class>::rule[TypeInt] == TypeError, "!Int is ill-typed");
+
+//
+// The type of the operator Tag applied to operands of the given types.
+// If the operator rejects them, the error is reported at loc and the
+// type is Void.
+//
+template <class Tag>
+static Symbol binaryType(SourceLoc loc, Symbol type1, Symbol type2) {
+    TypeId result = BinaryOp<Tag>::rule[typeId(type1)][typeId(type2)];
+    if (result == TypeError) {
+        semant_error_at(loc) << BinaryOp<Tag>::before << type1 << BinaryOp<Tag>::between << type2 << "." << std::endl;
+        return Void;
+    }
+    return type_symbols[result];
 }
 
-static void install_calls(Decls decls) {
+template <class Tag>
+static Symbol unaryType(SourceLoc loc, Symbol type1) {
+    TypeId result = UnaryOp<Tag>::rule[typeId(type1)];
+    if (result == TypeError) {
+        semant_error_at(loc) << UnaryOp<Tag>::before << type1 << UnaryOp<Tag>::after << std::endl;
+        return Void;
+    }
+    return type_symbols[result];
+}
+
+//
+// The checker is written once, over the node-access layer of astview.h,
+// and instantiated for both forms of the AST: TreeView for the pointer
+// AST, FlatView for the flat copy of -A.  Each view has its own scopes
+// and call table, holding its own handles.  They are function-local
+// statics: g++ does not run the constructor of a thread_local variable
+// template that only templates use.
+//
+
+template <class View>
+static typename View::Environment &objectEnv() {	// name, declaration
+	static thread_local typename View::Environment env;
+	return env;
+}
+
+template <class View>
+static std::map<Symbol, typename View::CallDecl> &call_table() {
+	static thread_local std::map<Symbol, typename View::CallDecl> table;
+	return table;
+}
+
+template <class View, class H>
+static ostream& semant_error(View view, H t) {
+    return semant_error_at(view.location(t));
+}
+
+template <class View>
+static void install_calls(View view, typename View::Program program) {
 	
 	
-	for (int i=decls->first(); decls->more(i); i=decls->next(i)) {
-		if (decls->nth(i)->isCallDecl()) {
-			Symbol call_name = decls->nth(i)->getName();
-			if (call_table.find(call_name) != call_table.end()) {
-				semant_error(decls->nth(i)) << "Function " << decls->nth(i)->getName() <<" was previously defined." << std::endl;
+	for (int i=0; i<view.decl_count(program); i++) {
+		if (view.kind(view.decl(program, i)) == NODE_CALL_DECL) {
+			typename View::CallDecl call = view.template as<NODE_CALL_DECL>(view.decl(program, i));
+			Symbol call_name = view.name(call);
+			if (call_table<View>().find(call_name) != call_table<View>().end()) {
+				semant_error(view, call) << "Function " << call_name <<" was previously defined." << std::endl;
 			}
 			else if (call_name == print) {
-				semant_error(decls->nth(i)) << "Function printf cannot be redefination." << std::endl;
+				semant_error(view, call) << "Function printf cannot be redefination." << std::endl;
 			}
 			else {
-				call_table.insert(std::make_pair(call_name, decls->nth(i)));
+				call_table<View>().insert(std::make_pair(call_name, call));
 			}
 		}
 	}
 }
 
-static void install_globalVars(Decls decls) {
+template <class View>
+static void install_globalVars(View view, typename View::Program program) {
+	typename View::Environment &env = objectEnv<View>();
 	
-	objectEnv.enterscope();
-	for (int i=decls->first(); decls->more(i); i=decls->next(i)) {
-		if (!decls->nth(i)->isCallDecl()) {
-			if (objectEnv.probe(decls->nth(i)->getName()) != NULL) {
-				semant_error(decls->nth(i)) << "var " << decls->nth(i)->getName() << " was previously defined." << endl;
+	env.enterscope();
+	for (int i=0; i<view.decl_count(program); i++) {
+		if (view.kind(view.decl(program, i)) == NODE_VARIABLE_DECL) {
+			typename View::VariableDecl decl = view.template as<NODE_VARIABLE_DECL>(view.decl(program, i));
+			typename View::Variable var = view.variable(decl);
+			if (env.probe(view.name(var))) {
+				semant_error(view, decl) << "var " << view.name(var) << " was previously defined." << endl;
 			}
-			else if (sameType(decls->nth(i)->getType(), Void)) {
-				semant_error(decls->nth(i)) << "var " << decls->nth(i)->getName() << " cannot be of type Void." << endl;
+			else if (sameType(view.type(var), Void)) {
+				semant_error(view, decl) << "var " << view.name(var) << " cannot be of type Void." << endl;
 			}
-			else if (sameType(decls->nth(i)->getName(), print)) {
-				semant_error(decls->nth(i)) << "Variable printf cannot be named printf." << endl;
+			else if (sameType(view.name(var), print)) {
+				semant_error(view, decl) << "Variable printf cannot be named printf." << endl;
 			}
 			else {
-				Symbol type = decls->nth(i)->getType();
-				objectEnv.addid(decls->nth(i)->getName(), new Symbol(type));
+				env.addid(view.name(var), var);
 			}
 		}
 	}
 }
 
-static void check_calls(Decls decls) {
+//
+// Name binding.  Before anything is type checked, one walk over each
+// function resolves every name in it, with the scopes the checker used
+// to keep, and records the result on the node that uses the name: a
+// Call gets the CallDecl it calls, an Object or Assign the Variable
+// that declares its name, and a parameter or local that repeats a name
+// already declared in its scope gets the earlier Variable as its
+// prior.  A name that does not resolve is left none.  Binding reports
+// no errors; the checker finds them on the nodes, in its own order,
+// and never looks a name up.
+//
+// Like checking, binding walks the AST with a work stack rather than
+// by recursion: each step of Binder returns the next child to bind.
+//
+
+// declare var in the innermost scope, unless its name is already there
+template <class View>
+static void declare(View view, typename View::Variable var) {
+	typename View::Variable prior = objectEnv<View>().probe(view.name(var));
+	view.set_prior(var, prior);
+	if (!prior) {
+		objectEnv<View>().addid(view.name(var), var);
+	}
+}
+
+template <class View> class Binder;
+template <class View, class Pass>
+static void walk(typename View::Node root, Pass &pass);
+
+template <class View>
+static void bind_call(View view, typename View::CallDecl call) {
+	Binder<View> binder(view);
 
-	for (int i=decls->first(); decls->more(i); i=decls->next(i)) {
-		if (decls->nth(i)->isCallDecl()) {
-			
-			decls->nth(i)->check();
+	objectEnv<View>().enterscope();
+	for (int i=0; i<view.param_count(call); i++) {
+		declare(view, view.param(call, i));
+	}
+	walk<View>(view.body(call), binder);
+	objectEnv<View>().exitscope();
+}
+
+template <class View>
+static void bind_calls(View view, typename View::Program program) {
+
+	for (int i=0; i<view.decl_count(program); i++) {
+		if (view.kind(view.decl(program, i)) == NODE_CALL_DECL) {
+			bind_call(view, view.template as<NODE_CALL_DECL>(view.decl(program, i)));
 		}
 	}
 }
 
-static void check_main() {
-	if (call_table.find(Main) == call_table.end()) {
-		semant_error() << "Main function is not defined." << std::endl;
+//
+// Frame slots.  Once a function is checked, each of its parameters and
+// locals is numbered with a slot in the function's frame, so that code
+// run from the AST can keep variables in an array.  The parameters take
+// the first slots, in order, and the locals of a block the next free
+// ones when the block is reached.  A variable lives as long as its
+// scope, so when an if branch or a loop body ends its slots are free
+// again, for the next sibling to reuse.  The frame size is the most
+// slots in use at once.  Only statements are walked; the scopes are
+// those of binding.
+//
+static thread_local int next_slot;
+static thread_local int frame_size;
+static thread_local std::vector<int> slot_marks;	// next_slot at each open scope
+
+template <class View>
+static void give_slot(View view, typename View::Variable var) {
+	view.set_slot(var, next_slot++);
+	if (next_slot > frame_size) {
+		frame_size = next_slot;
 	}
 }
 
-void VariableDecl_class::check() {
+static void open_slots() {
+	slot_marks.push_back(next_slot);
+}
+
+// free the slots of the scope opened last
+static void close_slots() {
+	next_slot = slot_marks.back();
+	slot_marks.pop_back();
+}
+
+template <class View>
+static void assign_slots(View view, typename View::CallDecl call);
+
+template <class View>
+static void check_variable_decl(View view, typename View::VariableDecl decl) {
 	
-	Symbol name = this->getName();
-	Symbol type = this->getType();
+	Symbol name = view.name(view.variable(decl));
+	Symbol type = view.type(view.variable(decl));
 	if (sameType(type, Void)) {
-		semant_error(this) << "var " << this->getName() << " cannot be of type Void. Void can just be used as return type." << std::endl;
+		semant_error(view, decl) << "var " << name << " cannot be of type Void. Void can just be used as return type." << std::endl;
 	}
 }
 
-void CallDecl_class::check() {
-	Variables vars = this->getVariables();
-	
-	objectEnv.enterscope();
+template <class View>
+static void check_stmt(View view, typename View::Node stmt, Symbol type);
+
+template <class View>
+static void check_call(View view, typename View::CallDecl call) {
 	
-	for (int i=vars->first(); vars->more(i); i=vars->next(i)) {
-		Symbol name = vars->nth(i)->getName();
+	for (int i=0; i<view.param_count(call); i++) {
+		typename View::Variable var = view.param(call, i);
+		Symbol name = view.name(var);
 		
-		if (objectEnv.probe(name) != NULL) {
-			semant_error(vars->nth(i)) << "Function " << this->getName() << " 's parameter has a duplicate name " << name << "." << std::endl;
-		}
-		else {
-			Symbol vartype = vars->nth(i)->getType();
-			objectEnv.addid(name, new Symbol(vartype));
+		if (view.prior(var)) {
+			semant_error(view, var) << "Function " << view.name(call) << " 's parameter has a duplicate name " << name << "." << std::endl;
 		}
 	}
 	
 	//main() has return type 'void' and no params
-	if (sameType(this->getName(), Main)) {
-		if (!sameType(this->getType(), Void)) {
-			semant_error(this) << "Main function should have return type Void." << std::endl;
+	if (sameType(view.name(call), Main)) {
+		if (!sameType(view.type(call), Void)) {
+			semant_error(view, call) << "Main function should have return type Void." << std::endl;
 		}
-		if (vars->len()) {
-			semant_error(this) << "Main function should not have any parameters" << std::endl;
+		if (view.param_count(call)) {
+			semant_error(view, call) << "Main function should not have any parameters" << std::endl;
 		}
 	}
 	
-	this->body->check(this->getType());
+	check_stmt(view, view.body(call), view.type(call));
 	
-	objectEnv.exitscope();
 	if (!returnflag) {
-		semant_error(this) << "Function " << this->getName() << " must have an overall return statement." << std::endl;
+		semant_error(view, call) << "Function " << view.name(call) << " must have an overall return statement." << std::endl;
 	}
 	returnflag = false;
 }
 
-void StmtBlock_class::check(Symbol type) {
+template <class View>
+static void check_calls(View view, typename View::Program program) {
 
-	/*class StmtBlock_class : public Stmt_class {
-		protected:
-			VariableDecls vars;
-			Stmts	stmts;
-	*/
-	//VariableDecls
-	
-	VariableDecls var_decls = this->getVariableDecls();
-	//check for duplicate variable declarations and add variables to var_scope
-	
-	for (int i=var_decls->first(); var_decls->more(i); i=var_decls->next(i)) {
-		if (objectEnv.probe(var_decls->nth(i)->getName()) != NULL) {
-			semant_error(var_decls->nth(i)) << "var " << var_decls->nth(i)->getName() << " was previously defined." << std::endl;
-		}
-		else {
-			Symbol type = var_decls->nth(i)->getType();
-			objectEnv.addid(var_decls->nth(i)->getName(), new Symbol(type));
+	for (int i=0; i<view.decl_count(program); i++) {
+		if (view.kind(view.decl(program, i)) == NODE_CALL_DECL) {
+			typename View::CallDecl call = view.template as<NODE_CALL_DECL>(view.decl(program, i));
+			check_call(view, call);
+			assign_slots(view, call);
 		}
-		
-		//check variable declarations one by one
-		var_decls->nth(i)->check();
 	}
-	
-	//Stmts : list of Stmt
-	//this part is unfinished yet. should lookup variables used in stmts in var_scope
-	Stmts stmts = this->getStmts();
-	for (int i=stmts->first(); stmts->more(i); i=stmts->next(i)) {
-		stmts->nth(i)->check(type);
-	}
-}
-
-void IfStmt_class::check(Symbol type) {
-
-	/*class IfStmt_class : public Stmt_class {
-	protected:
-		Expr condition;
-		StmtBlock thenexpr, elseexpr;
-	*/
-	this->getCondition()->checkType();
-	++inif;
-	objectEnv.enterscope();
-	this->getThen()->check(type);
-	objectEnv.exitscope();
-	
-	objectEnv.enterscope();
-	this->getElse()->check(type);
-	objectEnv.exitscope();
-	--inif;
 }
 
-void WhileStmt_class::check(Symbol type) {
-
-	/*class WhileStmt_class : public Stmt_class {
-	protected:
-		Expr condition; getCondition()
-		StmtBlock body; getBody()
-	*/
-	this->getCondition()->checkType();
-	
-	++inloop;
-	objectEnv.enterscope();
-	this->getBody()->check(type);
-	objectEnv.exitscope();
-	--inloop;
+template <class View>
+static void check_main() {
+	if (call_table<View>().find(Main) == call_table<View>().end()) {
+		semant_error() << "Main function is not defined." << std::endl;
+	}
 }
 
-void ForStmt_class::check(Symbol type) {
-
-	/*class ForStmt_class : public Stmt_class {
-	protected:
-	Expr initexpr, condition, loopact;
-	StmtBlock body;	getInit(), getCondition(), getLoop(), getBody()
-	*/
-	
-	this->getInit()->checkType();
-	this->getCondition()->checkType();
-	this->getLoop()->checkType();
-
-	++inloop;
-	objectEnv.enterscope();
-	this->getBody()->check(type);
-	objectEnv.exitscope();
-	--inloop;
+//
+// Statements and expressions are checked by walking the AST with work
+// stacks on the heap rather than by recursion, so a deeply nested
+// program needs no more C++ stack than a flat one.  A node is checked
+// in steps: each step does whatever the node does before its next
+// child and returns that child, which is checked completely before the
+// node takes its next step.  The last step returns none.  For an
+// expression, the types of the operands checked so far are kept on a
+// second stack and passed to the step.
+//
+template <class View>
+struct StmtFrame {
+	typename View::Node stmt;
+	int step;
+};
+
+template <class View>
+struct ExprFrame {
+	typename View::Node expr;
+	int step;
+	size_t operands;	// index in expr_types of the first operand
+};
+
+template <class View>
+static std::vector<StmtFrame<View> > &stmt_work() {
+	static thread_local std::vector<StmtFrame<View> > work;
+	return work;
 }
-
-void ReturnStmt_class::check(Symbol type) {
-
-	/*class ReturnStmt_class : public Stmt_class {
-	protected:
-	Expr value;  getValue()
-	*/
-	Symbol exprtype = this->getValue()->checkType();
-	
-	if (!sameType(type, exprtype)) {
-		semant_error(this) << "Returns " << exprtype << " , but need " << type << std::endl;
-	}
-	if(inif == 0 && inloop == 0) returnflag = true;
+template <class View>
+static std::vector<ExprFrame<View> > &expr_work() {
+	static thread_local std::vector<ExprFrame<View> > work;
+	return work;
 }
+static thread_local std::vector<Symbol> expr_types;
 
-void ContinueStmt_class::check(Symbol type) {
-	if (inloop == 0) {
-		semant_error(this) << "continue must be used in a loop sentence." << std::endl;
+//
+// The walk behind binding and frame slots: pass is visited with each
+// node in turn, as check_stmt visits StmtChecker.
+//
+template <class View, class Pass>
+static void walk(typename View::Node root, Pass &pass) {
+	std::vector<StmtFrame<View> > &work = stmt_work<View>();
+	size_t base = work.size();
+	StmtFrame<View> frame = { root, 0 };
+	work.push_back(frame);
+	while (work.size() > base) {
+		StmtFrame<View> &f = work.back();
+		typename View::Node next = pass.visit(f.stmt, f.step++);
+		if (next == View::none) {
+			work.pop_back();
+			continue;
+		}
+		// take the child's first step here, so that a leaf, which has
+		// only the one, needs no frame
+		typename View::Node grandchild = pass.visit(next, 0);
+		if (grandchild != View::none) {
+			StmtFrame<View> child = { next, 1 };
+			work.push_back(child);
+			StmtFrame<View> frame = { grandchild, 0 };
+			work.push_back(frame);
+		}
 	}
 }
 
-void BreakStmt_class::check(Symbol type) {
-	if (inloop == 0) {
-		semant_error(this) << "break must be used in a loop sentence." << std::endl;
-	}
-}
+//
+// The passes over statements and expressions (see visitor.h).  Each
+// handler takes one step of a node: given the number of steps already
+// taken, it does whatever the node does before its next child and
+// returns that child, or returns none once the node is done.
+//
 
-Symbol Call_class::checkType(){
-	Symbol name = this->getName();
-	Actuals actuals = this->getActuals();
-	
-	if(sameType(name, print)) {
-		if (actuals->len() == 0) {
-			semant_error(this) << "printf() must have at least one parameter." << std::endl;
-		}
-		if (!sameType(actuals->nth(actuals->first())->checkType(), String)) {
-			semant_error(this) << "printf()'s first parameter must be of type String." << std::endl;
+// Binding: a node with no handler here has no names in it.
+template <class View>
+class Binder : public AstVisitor<Binder<View>, View> {
+	typedef AstVisitor<Binder<View>, View> Visitor;
+	typedef typename View::Node Node;
+	using Visitor::view;
+public:
+	Binder(View v) : Visitor(v) { }
+
+	// the variables go in the enclosing scope
+	template <class H>
+	Node visit_stmt_block(H s, int step) {
+		if (step == 0) {
+			for (int i=0; i<view.var_count(s); i++) {
+				declare(view, view.variable(view.var_decl(s, i)));
+			}
 		}
-		return Void;
-	}
-	else if(call_table.find(name) == call_table.end()) {
-		semant_error(this) << "function " << name << " not defined." << std::endl;
-		return Void;
-	}
-	else {
-		if (actuals->len() != call_table.find(name)->second->getVariables()->len()) {
-			semant_error(this) << "Function " << name <<" called with wrong number of arguments." << std::endl;
+		if (step < view.stmt_count(s)) {
+			return view.stmt(s, step);
 		}
-		else {
-			Variables vars = call_table.find(name)->second->getVariables();
-			for(int i=vars->first(); vars->more(i); i=vars->next(i)) {
-				Symbol vartype = vars->nth(i)->getType();
-				Symbol actualtype = actuals->nth(i)->checkType();
-				
-				if (!sameType(actualtype, vartype)) {
-					semant_error(this) << "type " << actualtype << " of parameter " << vars->nth(i)->getName() << " does not conform to declared type " << vartype << "." << std::endl;
-				}
-			}
+		return View::none;
+	}
+
+	// each branch is a scope of its own
+	template <class H>
+	Node visit_if(H s, int step) {
+		switch (step) {
+		case 0:
+			return view.condition(s);
+		case 1:
+			objectEnv<View>().enterscope();
+			return view.then_branch(s);
+		case 2:
+			objectEnv<View>().exitscope();
+			objectEnv<View>().enterscope();
+			return view.else_branch(s);
+		default:
+			objectEnv<View>().exitscope();
+			return View::none;
 		}
-		
 	}
-	Symbol calltype = call_table.find(name)->second->getType();
-	this->setType(calltype);
-	return calltype;
-}
-
-Symbol Actual_class::checkType(){
-	this->setType(expr->checkType());
-	return type;
-}
-
-Symbol Assign_class::checkType(){
 
-	Symbol valuetype = value->checkType();
-	if(objectEnv.lookup(lvalue) == NULL) {
-		semant_error(this) << "Left value " << lvalue << " has not been defined." << std::endl;
-	}
-	else if(!sameType(*(objectEnv.lookup(lvalue)), valuetype)) {
-		semant_error(this) << "Right value must have type " << *(objectEnv.lookup(lvalue)) << " , got " << valuetype << std::endl;
+	template <class H>
+	Node visit_while(H s, int step) {
+		switch (step) {
+		case 0:
+			return view.condition(s);
+		case 1:
+			objectEnv<View>().enterscope();
+			return view.body(s);
+		default:
+			objectEnv<View>().exitscope();
+			return View::none;
+		}
 	}
-	this->setType(valuetype);
-	return valuetype;
-}
-
-Symbol Add_class::checkType(){
 
-	Symbol type1 = e1->checkType();
-	Symbol type2 = e2->checkType();	
-	
-	if (sameType(type1, Float) && (sameType(type2, Int) || sameType(type2, Float))) {
-		type = Float;
-	}
-	else if (sameType(type2, Float) && (sameType(type1, Int) || sameType(type1, Float))) {
-		type = Float;
-	}
-	else if (sameType(type1, Int) && sameType(type2, Int)) {
-		type = Int;
-	}
-	else {
-		semant_error(this) << "Cannot add a " << type1 << " and a " << type2 << "." << std::endl;
-		type = Void;
+	template <class H>
+	Node visit_for(H s, int step) {
+		switch (step) {
+		case 0:
+			return view.init(s);
+		case 1:
+			return view.condition(s);
+		case 2:
+			return view.loop(s);
+		case 3:
+			objectEnv<View>().enterscope();
+			return view.body(s);
+		default:
+			objectEnv<View>().exitscope();
+			return View::none;
+		}
 	}
-	return type;
-}
 
-Symbol Minus_class::checkType(){
-	Symbol type1 = e1->checkType();
-	Symbol type2 = e2->checkType();	
-	
-	if (sameType(type1, Float) && (sameType(type2, Int) || sameType(type2, Float))) {
-		type = Float;
-	}
-	else if (sameType(type2, Float) && (sameType(type1, Int) || sameType(type1, Float))) {
-		type = Float;
-	}
-	else if (sameType(type1, Int) && sameType(type2, Int)) {
-		type = Int;
-	}
-	else {
-		semant_error(this) << "Cannot minus a " << type1 << " and a " << type2 << "." << std::endl;
-		type = Void;
+	template <class H>
+	Node visit_return(H s, int step) {
+		return step == 0 ? view.value(s) : View::none;
 	}
-	return type;
-}
 
-Symbol Multi_class::checkType(){
-	Symbol type1 = e1->checkType();
-	Symbol type2 = e2->checkType();	
-	
-	if (sameType(type1, Float) && (sameType(type2, Int) || sameType(type2, Float))) {
-		type = Float;
-	}
-	else if (sameType(type2, Float) && (sameType(type1, Int) || sameType(type1, Float))) {
-		type = Float;
-	}
-	else if (sameType(type1, Int) && sameType(type2, Int)) {
-		type = Int;
-	}
-	else {
-		semant_error(this) << "Cannot multi a " << type1 << " and a " << type2 << "." << std::endl;
-		type = Void;
+	template <class H>
+	Node visit_call(H e, int step) {
+		if (step == 0) {
+			typename std::map<Symbol, typename View::CallDecl>::iterator it = call_table<View>().find(view.name(e));
+			view.set_callee(e, it == call_table<View>().end() ? typename View::CallDecl() : it->second);
+		}
+		if (step < view.actual_count(e)) {
+			return view.actual(e, step);
+		}
+		return View::none;
 	}
-	return type;
-}
 
-Symbol Divide_class::checkType(){
-	Symbol type1 = e1->checkType();
-	Symbol type2 = e2->checkType();	
-	
-	if (sameType(type1, Float) && (sameType(type2, Int) || sameType(type2, Float))) {
-		type = Float;
-	}
-	else if (sameType(type2, Float) && (sameType(type1, Int) || sameType(type1, Float))) {
-		type = Float;
-	}
-	else if (sameType(type1, Int) && sameType(type2, Int)) {
-		type = Int;
+	template <class H>
+	Node visit_actual(H e, int step) {
+		return step == 0 ? view.expr(e) : View::none;
 	}
-	else {
-		semant_error(this) << "Cannot div a " << type1 << " and a " << type2 << "." << std::endl;
-		type = Void;
-	}
-	return type;
-}
 
-Symbol Mod_class::checkType(){
-	Symbol type1 = e1->checkType();
-	Symbol type2 = e2->checkType();	
-	
-	if (sameType(type1, Int) && sameType(type2, Int)) {
-		type = Int;
-	}
-	else {
-		semant_error(this) << "Cannot mod a " << type1 << " and a " << type2 << "." << std::endl;
-		type = Void;
+	template <class H>
+	Node visit_assign(H e, int step) {
+		if (step == 0) {
+			view.set_decl(e, objectEnv<View>().lookup(view.name(e)));
+			return view.value(e);
+		}
+		return View::none;
 	}
-	return type;
-}
 
-Symbol Neg_class::checkType(){
-	if(!sameType(e1->getType(), Int) || !sameType(e1->getType(), Float)) {
-		semant_error(this) << "A" << e1->getType() <<"doesn't have a negative." << std::endl;
-		this->setType(Void);
+	template <class Op>
+	Node visit_binary(Op e, int step) {
+		return step == 0 ? view.left(e) : step == 1 ? view.right(e) : View::none;
 	}
-	
-	this->setType(Int);
-	return type;
-}
 
-Symbol Lt_class::checkType(){
-	Symbol type1 = e1->checkType();
-	Symbol type2 = e2->checkType();	
-	
-	if ((sameType(type1, Float) || sameType(type1, Int)) && (sameType(type2, Float) || sameType(type2, Int))) {
-		type = Bool;
-	}
-	else {
-		semant_error(this) << "Cannot compare a " << type1 << " and a " << type2 << "." << std::endl;
-		type = Void;
+	template <class Op>
+	Node visit_unary(Op e, int step) {
+		return step == 0 ? view.operand(e) : View::none;
 	}
-	return type;
-}
 
-Symbol Le_class::checkType(){
-	Symbol type1 = e1->checkType();
-	Symbol type2 = e2->checkType();	
-	
-	if ((sameType(type1, Float) || sameType(type1, Int)) && (sameType(type2, Float) || sameType(type2, Int))) {
-		type = Bool;
+	template <class H>
+	Node visit_object(H e, int step) {
+		view.set_decl(e, objectEnv<View>().lookup(view.name(e)));
+		return View::none;
 	}
-	else {
-		semant_error(this) << "Cannot compare a " << type1 << " and a " << type2 << "." << std::endl;
-		type = Void;
-	}
-	return type;
-}
+};
 
-Symbol Equ_class::checkType(){
-	Symbol type1 = e1->checkType();
-	Symbol type2 = e2->checkType();	
-	
-	if ((sameType(type1, Float) || sameType(type1, Int) || sameType(type1, Bool)) && (sameType(type2, Float) || sameType(type2, Int) || sameType(type2, Bool))) {
-		type = Bool;
-	}
-	else {
-		semant_error(this) << "Cannot compare a " << type1 << " and a " << type2 << "." << std::endl;
-		type = Void;
-	}
-	return type;
-}
+// Frame slots: only the statements that open scopes have a handler.
+template <class View>
+class SlotAssigner : public AstVisitor<SlotAssigner<View>, View> {
+	typedef AstVisitor<SlotAssigner<View>, View> Visitor;
+	typedef typename View::Node Node;
+	using Visitor::view;
+public:
+	SlotAssigner(View v) : Visitor(v) { }
 
-Symbol Neq_class::checkType(){
-	Symbol type1 = e1->checkType();
-	Symbol type2 = e2->checkType();	
-	
-	if ((sameType(type1, Float) || sameType(type1, Int) || sameType(type1, Bool)) && (sameType(type2, Float) || sameType(type2, Int) || sameType(type2, Bool))) {
-		type = Bool;
+	template <class H>
+	Node visit_stmt_block(H s, int step) {
+		if (step == 0) {
+			for (int i=0; i<view.var_count(s); i++) {
+				give_slot(view, view.variable(view.var_decl(s, i)));
+			}
+		}
+		if (step < view.stmt_count(s)) {
+			return view.stmt(s, step);
+		}
+		return View::none;
+	}
+
+	template <class H>
+	Node visit_if(H s, int step) {
+		switch (step) {
+		case 0:
+			open_slots();
+			return view.then_branch(s);
+		case 1:
+			close_slots();
+			open_slots();
+			return view.else_branch(s);
+		default:
+			close_slots();
+			return View::none;
+		}
 	}
-	else {
-		semant_error(this) << "Cannot compare a " << type1 << " and a " << type2 << "." << std::endl;
-		type = Void;
+
+	template <class H>
+	Node visit_while(H s, int step) {
+		if (step == 0) {
+			open_slots();
+			return view.body(s);
+		}
+		close_slots();
+		return View::none;
 	}
-	return type;
-}
 
-Symbol Ge_class::checkType(){
-	Symbol type1 = e1->checkType();
-	Symbol type2 = e2->checkType();	
-	
-	if ((sameType(type1, Float) || sameType(type1, Int)) && (sameType(type2, Float) || sameType(type2, Int))) {
-		type = Bool;
+	template <class H>
+	Node visit_for(H s, int step) {
+		if (step == 0) {
+			open_slots();
+			return view.body(s);
+		}
+		close_slots();
+		return View::none;
 	}
-	else {
-		semant_error(this) << "Cannot compare a " << type1 << " and a " << type2 << "." << std::endl;
-		type = Void;
+};
+
+template <class View>
+static void assign_slots(View view, typename View::CallDecl call) {
+	SlotAssigner<View> slots(view);
+
+	next_slot = frame_size = 0;
+	for (int i=0; i<view.param_count(call); i++) {
+		give_slot(view, view.param(call, i));
 	}
-	return type;
+	walk<View>(view.body(call), slots);
+	view.set_frame_size(call, frame_size);
 }
 
-Symbol Gt_class::checkType(){
-	Symbol type1 = e1->checkType();
-	Symbol type2 = e2->checkType();	
-	
-	if ((sameType(type1, Float) || sameType(type1, Int)) && (sameType(type2, Float) || sameType(type2, Int))) {
-		type = Bool;
+template <class View>
+static Symbol check_expr(View view, typename View::Node root);
+
+// Checking a statement in a function returning type.  Only statements
+// are children here; an expression is checked whole, by check_expr.
+template <class View>
+class StmtChecker : public AstVisitor<StmtChecker<View>, View> {
+	typedef AstVisitor<StmtChecker<View>, View> Visitor;
+	typedef typename View::Node Node;
+	using Visitor::view;
+public:
+	StmtChecker(View v) : Visitor(v) { }
+
+	template <class H>
+	Node visit_stmt_block(H s, int step, Symbol type) {
+		if (step == 0) {
+			//check for duplicate variable declarations and add variables to var_scope
+
+			for (int i=0; i<view.var_count(s); i++) {
+				typename View::VariableDecl decl = view.var_decl(s, i);
+				if (view.prior(view.variable(decl))) {
+					semant_error(view, decl) << "var " << view.name(view.variable(decl)) << " was previously defined." << std::endl;
+				}
+
+				//check variable declarations one by one
+				check_variable_decl(view, decl);
+			}
+		}
+
+		//the statements, one per step
+		if (step < view.stmt_count(s)) {
+			return view.stmt(s, step);
+		}
+		return View::none;
+	}
+
+	template <class H>
+	Node visit_if(H s, int step, Symbol type) {
+		switch (step) {
+		case 0:
+			check_expr(view, view.condition(s));
+			++inif;
+			return view.then_branch(s);
+		case 1:
+			return view.else_branch(s);
+		default:
+			--inif;
+			return View::none;
+		}
 	}
-	else {
-		semant_error(this) << "Cannot compare a " << type1 << " and a " << type2 << "." << std::endl;
-		type = Void;
+
+	template <class H>
+	Node visit_while(H s, int step, Symbol type) {
+		if (step == 0) {
+			check_expr(view, view.condition(s));
+
+			++inloop;
+			return view.body(s);
+		}
+		--inloop;
+		return View::none;
 	}
-	return type;
-}
 
-Symbol And_class::checkType(){
-	Symbol type1 = e1->checkType();
-	Symbol type2 = e2->checkType();	
-	
-	if (sameType(type1, Bool) && sameType(type2, Bool)) {
-		type = Bool;
+	template <class H>
+	Node visit_for(H s, int step, Symbol type) {
+		if (step == 0) {
+			check_expr(view, view.init(s));
+			check_expr(view, view.condition(s));
+			check_expr(view, view.loop(s));
+
+			++inloop;
+			return view.body(s);
+		}
+		--inloop;
+		return View::none;
 	}
-	else {
-		semant_error(this) << "Cannot use && between " << type1 << " and " << type2 << "." << std::endl;
-		type = Void;
+
+	template <class H>
+	Node visit_return(H s, int step, Symbol type) {
+		Symbol exprtype = check_expr(view, view.value(s));
+
+		if (!sameType(type, exprtype)) {
+			semant_error(view, s) << "Returns " << exprtype << " , but need " << type << std::endl;
+		}
+		if(inif == 0 && inloop == 0) returnflag = true;
+		return View::none;
 	}
-	return type;
-}
 
-Symbol Or_class::checkType(){
-	Symbol type1 = e1->checkType();
-	Symbol type2 = e2->checkType();	
-	
-	if (sameType(type1, Bool) && sameType(type2, Bool)) {
-		type = Bool;
+	template <class H>
+	Node visit_continue(H s, int step, Symbol type) {
+		if (inloop == 0) {
+			semant_error(view, s) << "continue must be used in a loop sentence." << std::endl;
+		}
+		return View::none;
 	}
-	else {
-		semant_error(this) << "Cannot use || between " << type1 << " and " << type2 << "." << std::endl;
-		type = Void;
+
+	template <class H>
+	Node visit_break(H s, int step, Symbol type) {
+		if (inloop == 0) {
+			semant_error(view, s) << "break must be used in a loop sentence." << std::endl;
+		}
+		return View::none;
+	}
+
+	// an expression used as a statement
+	template <class H>
+	Node visit_expr(H e, int step, Symbol type) {
+		check_expr(view, view.node(e));
+		return View::none;
+	}
+};
+
+// Checking an expression: operands holds the types of the operands
+// checked so far, and the last step leaves the type of the expression
+// in result.
+template <class View>
+class ExprChecker : public AstVisitor<ExprChecker<View>, View> {
+	typedef AstVisitor<ExprChecker<View>, View> Visitor;
+	typedef typename View::Node Node;
+	using Visitor::view;
+public:
+	ExprChecker(View v) : Visitor(v) { }
+
+	template <class H>
+	Node visit_call(H e, int step, Symbol *operands, Symbol &result) {
+		Symbol name = view.name(e);
+		typename View::CallDecl callee = view.callee(e);
+
+		if(sameType(name, print)) {
+			if (step == 0) {
+				if (view.actual_count(e) == 0) {
+					semant_error(view, e) << "printf() must have at least one parameter." << std::endl;
+				}
+				return view.actual(e, 0);
+			}
+			if (!sameType(operands[0], String)) {
+				semant_error(view, e) << "printf()'s first parameter must be of type String." << std::endl;
+			}
+			result = Void;
+			return View::none;
+		}
+		else if(!callee) {
+			semant_error(view, e) << "function " << name << " not defined." << std::endl;
+			result = Void;
+			return View::none;
+		}
+		else {
+			if (view.actual_count(e) != view.param_count(callee)) {
+				semant_error(view, e) << "Function " << name <<" called with wrong number of arguments." << std::endl;
+			}
+			else {
+				// step i checks the type of actual i-1 and moves on to actual i
+				if (step > 0) {
+					int i = step - 1;
+					Symbol vartype = view.type(view.param(callee, i));
+					Symbol actualtype = operands[i];
+
+					if (!sameType(actualtype, vartype)) {
+						semant_error(view, e) << "type " << actualtype << " of parameter " << view.name(view.param(callee, i)) << " does not conform to declared type " << vartype << "." << std::endl;
+					}
+				}
+				if (step < view.param_count(callee)) {
+					return view.actual(e, step);
+				}
+			}
+
+		}
+		Symbol calltype = view.type(callee);
+		view.set_type(e, calltype);
+		result = calltype;
+		return View::none;
 	}
-	return type;
-}
 
-Symbol Xor_class::checkType(){
-	Symbol type1 = e1->checkType();
-	Symbol type2 = e2->checkType();	
-	
-	if (sameType(type1, Bool) && sameType(type2, Bool)) {
-		type = Bool;
+	template <class H>
+	Node visit_actual(H e, int step, Symbol *operands, Symbol &result) {
+		if (step == 0) {
+			return view.expr(e);
+		}
+		view.set_type(e, operands[0]);
+		result = operands[0];
+		return View::none;
 	}
-	else {
-		semant_error(this) << "Cannot use ^ between " << type1 << " and " << type2 << "." << std::endl;
-		type = Void;
+
+	template <class H>
+	Node visit_assign(H e, int step, Symbol *operands, Symbol &result) {
+		if (step == 0) {
+			return view.value(e);
+		}
+		Symbol valuetype = operands[0];
+		typename View::Variable decl = view.decl(e);
+		if(!decl) {
+			semant_error(view, e) << "Left value " << view.name(e) << " has not been defined." << std::endl;
+		}
+		else if(!sameType(view.type(decl), valuetype)) {
+			semant_error(view, e) << "Right value must have type " << view.type(decl) << " , got " << valuetype << std::endl;
+		}
+		view.set_type(e, valuetype);
+		result = valuetype;
+		return View::none;
 	}
-	return type;
-}
 
-Symbol Not_class::checkType(){
-	Symbol type1 = e1->checkType();	
-	
-	if (sameType(type1, Bool)) {
-		type = Bool;
+	// the operators: the operands in turn, then the type of the
+	// operator, from its rule
+	template <class Op>
+	Node visit_binary(Op e, int step, Symbol *operands, Symbol &result) {
+		if (step == 0) {
+			return view.left(e);
+		}
+		if (step == 1) {
+			return view.right(e);
+		}
+		result = binaryType<typename HandleClass<Op>::type>(view.location(e), operands[0], operands[1]);
+		view.set_type(e, result);
+		return View::none;
 	}
-	else {
-		semant_error(this) << "Cannot use ! upon " << type1 << "." << std::endl;
-		type = Void;
+
+	template <class Op>
+	Node visit_unary(Op e, int step, Symbol *operands, Symbol &result) {
+		if (step == 0) {
+			return view.operand(e);
+		}
+		result = unaryType<typename HandleClass<Op>::type>(view.location(e), operands[0]);
+		view.set_type(e, result);
+		return View::none;
 	}
-	return type;
-}
 
-Symbol Bitand_class::checkType(){
-	Symbol type1 = e1->checkType();
-	Symbol type2 = e2->checkType();	
-	
-	if (sameType(type1, Bool) && sameType(type2, Bool)) {
-		type = Bool;
+	// an expression of fixed type
+	template <class H>
+	Node constant(H e, Symbol type, Symbol &result) {
+		view.set_type(e, type);
+		result = type;
+		return View::none;
 	}
-	else {
-		semant_error(this) << "Cannot use & between " << type1 << " and " << type2 << "." << std::endl;
-		type = Void;
+
+	template <class H>
+	Node visit_const_int(H e, int step, Symbol *operands, Symbol &result) {
+		return constant(e, Int, result);
 	}
-	return type;
-}
 
-Symbol Bitor_class::checkType(){
-	Symbol type1 = e1->checkType();
-	Symbol type2 = e2->checkType();	
-	
-	if (sameType(type1, Bool) && sameType(type2, Bool)) {
-		type = Bool;
+	template <class H>
+	Node visit_const_string(H e, int step, Symbol *operands, Symbol &result) {
+		return constant(e, String, result);
 	}
-	else {
-		semant_error(this) << "Cannot use | between " << type1 << " and " << type2 << "." << std::endl;
-		type = Void;
+
+	template <class H>
+	Node visit_const_float(H e, int step, Symbol *operands, Symbol &result) {
+		return constant(e, Float, result);
 	}
-	return type;
-}
 
-Symbol Bitnot_class::checkType(){
-	Symbol type1 = e1->checkType();	
-	
-	if (sameType(type1, Bool)) {
-		type = Bool;
+	template <class H>
+	Node visit_const_bool(H e, int step, Symbol *operands, Symbol &result) {
+		return constant(e, Bool, result);
 	}
-	else {
-		semant_error(this) << "Cannot use unary op ~ upon " << type1 << "." << std::endl;
-		type = Void;
+
+	template <class H>
+	Node visit_object(H e, int step, Symbol *operands, Symbol &result) {
+		Symbol obtype;
+		typename View::Variable decl = view.decl(e);
+		if(!decl) {
+			semant_error(view, e) << "object " << view.name(e) << " has not been defined." << std::endl;
+			obtype = Void;
+		}
+		else {
+			obtype = view.type(decl);
+		}
+		view.set_type(e, obtype);
+		result = obtype;
+		return View::none;
+	}
+
+	template <class H>
+	Node visit_no_expr(H e, int step, Symbol *operands, Symbol &result) {
+		return constant(e, Void, result);
+	}
+};
+
+// checks the statement stmt in a function returning type
+template <class View>
+static void check_stmt(View view, typename View::Node stmt, Symbol type) {
+	StmtChecker<View> checker(view);
+	std::vector<StmtFrame<View> > &work = stmt_work<View>();
+	size_t base = work.size();
+	StmtFrame<View> root = { stmt, 0 };
+	work.push_back(root);
+	while (work.size() > base) {
+		StmtFrame<View> &f = work.back();
+		typename View::Node next = checker.visit(f.stmt, f.step++, type);
+		if (next == View::none) {
+			work.pop_back();
+		}
+		else {
+			StmtFrame<View> child = { next, 0 };
+			work.push_back(child);
+		}
 	}
-	return type;
 }
 
-Symbol Const_int_class::checkType(){
-    type = Int;
-    return type;
+// checks the expression root and returns its type
+template <class View>
+static Symbol check_expr(View view, typename View::Node root) {
+	ExprChecker<View> checker(view);
+	Symbol result = NULL;
+	typename View::Node next = checker.visit(root, 0, (Symbol *) NULL, result);
+	if (next == View::none) {
+		return result;
+	}
+	std::vector<ExprFrame<View> > &work = expr_work<View>();
+	std::vector<Symbol> &types = expr_types;
+	size_t base = work.size();
+	ExprFrame<View> frame = { root, 0, types.size() };
+	work.push_back(frame);
+	for (;;) {
+		// next is the next operand of the expression on top of the stack;
+		// only an operand with operands of its own needs a frame
+		typename View::Node operand = next;
+		next = checker.visit(operand, 0, (Symbol *) NULL, result);
+		if (next != View::none) {
+			ExprFrame<View> frame = { operand, 0, types.size() };
+			work.push_back(frame);
+			continue;
+		}
+		// result is the type of operand; pass it up until some expression
+		// has another operand to check
+		for (;;) {
+			types.push_back(result);
+			ExprFrame<View> &f = work.back();
+			next = checker.visit(f.expr, ++f.step, types.data() + f.operands, result);
+			if (next != View::none) {
+				break;
+			}
+			types.resize(f.operands);
+			work.pop_back();
+			if (work.size() == base) {
+				return result;
+			}
+		}
+	}
 }
 
-Symbol Const_string_class::checkType(){
-    type = String;
-    return type;
-}
+//
+// Returns the number of semantic errors found; the caller decides
+// whether to stop.
+//
+template <class View>
+static int semant(View view, typename View::Program program) {
+    initialize_constants();
+    stats_phase(PHASE_INSTALL_CALLS);
+    install_calls(view, program);
+    stats_phase(PHASE_CHECK_MAIN);
+    check_main<View>();
+    stats_phase(PHASE_INSTALL_GLOBALS);
+    install_globalVars(view, program);
+    stats_phase(PHASE_BIND_CALLS);
+    bind_calls(view, program);
+    stats_phase(PHASE_CHECK_CALLS);
+    check_calls(view, program);
+    stats_phase(PHASE_NONE);
+
+    compile_stats.symtab_lookups = objectEnv<View>().lookup_count();
+    compile_stats.symtab_probes = objectEnv<View>().probe_count();
+    compile_stats.max_scope_depth = objectEnv<View>().max_depth();
 
-Symbol Const_float_class::checkType(){
-    type = Float;
-    return type;
+    if (semant_errors > 0) {
+        *diag_stream << "Compilation halted due to static semantic errors." << endl;
+    }
+    return semant_errors;
 }
 
-Symbol Const_bool_class::checkType(){
-    type = Bool;
-    return type;
+int Program_class::semant() {
+    return ::semant(TreeView(), this);
 }
 
-Symbol Object_class::checkType(){
-
-	Symbol obtype;
-	if(objectEnv.lookup(var) == NULL) {
-		semant_error(this) << "object " << var << " has not been defined." << std::endl;
-		obtype = Void;
-	}
-	else {
-		obtype = *(objectEnv.lookup(var));
-	}
-	this->setType(obtype);
-	return obtype;
+int FlatAst::semant() {
+    FlatView view(this);
+    return ::semant(view, view.program());
 }
 
-Symbol No_expr_class::checkType(){
-    setType(Void);
-    return getType();
+template <class View>
+static void reset_view() {
+    objectEnv<View>() = typename View::Environment();
+    call_table<View>().clear();
+    stmt_work<View>() = std::vector<StmtFrame<View> >();
+    expr_work<View>() = std::vector<ExprFrame<View> >();
 }
 
-void Program_class::semant() {
-    initialize_constants();
-    install_calls(decls);
-    check_main();
-    install_globalVars(decls);
-    check_calls(decls);
-    
-    if (semant_errors > 0) {
-        cerr << "Compilation halted due to static semantic errors." << endl;
-        exit(1);
-    }
+//
+// Forget everything the previous call to semant() learned, so another
+// program can be checked in the same process.  The predefined symbols
+// are re-interned by the next semant().
+//
+void reset_semant() {
+    semant_errors = 0;
+    curr_decl = 0;
+    reset_view<TreeView>();
+    reset_view<FlatView>();
+    inloop = 0;
+    inif = 0;
+    returnflag = false;
+    expr_types = std::vector<Symbol>();
+    slot_marks = std::vector<int>();
+    type_ids = std::vector<unsigned char>();
 }
-
-
-
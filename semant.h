@@ -18,6 +18,9 @@
 #define TRUE 1
 #define FALSE 0
 
+// reset all state kept by the semantic checker between programs
+void reset_semant();
+
 
 // color
 
@@ -0,0 +1,176 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+//
+// Source locations and the line tables behind them; see source.h.
+//
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <algorithm>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#include "source.h"
+#include "seal-io.h"
+
+SourceManager source_manager;
+
+// the file last resolved on this thread
+struct FileCache {
+    SourceLoc start, end;       // end is one past the file's end location
+    void *file;
+};
+
+static thread_local FileCache file_cache;
+thread_local SourceManager::LineCache SourceManager::line_cache;
+
+SourceLoc SourceManager::add_file(const char *name, FILE *&input)
+{
+    File *f = new File;
+    f->name = name;
+    f->fd = -1;
+    f->lines_ready = false;
+
+    struct stat st;
+    if (fstat(fileno(input), &st) == 0 && S_ISREG(st.st_mode)) {
+	f->size = st.st_size;
+	f->fd = dup(fileno(input));
+    } else {
+	char buf[1 << 16];
+	size_t n;
+	while ((n = fread(buf, 1, sizeof buf, input)) > 0)
+	    f->text.append(buf, n);
+	fclose(input);
+	f->size = f->text.size();
+	input = fmemopen(&f->text[0], f->size, "r");
+    }
+
+    std::lock_guard<std::mutex> hold(lock);
+    if (f->size >= (SourceLoc) -1 - next) {
+	cerr << "out of source locations at " << name << endl;
+	exit(1);
+    }
+    f->start = next;
+    next += f->size + 1;
+    files.push_back(f);
+    return f->start;
+}
+
+void SourceManager::remove_file(SourceLoc start)
+{
+    std::lock_guard<std::mutex> hold(lock);
+    for (size_t i = 0; i < files.size(); i++) {
+	File *f = files[i];
+	if (f->start != start)
+	    continue;
+	if (f->fd >= 0)
+	    close(f->fd);
+	delete f;
+	files.erase(files.begin() + i);
+	break;
+    }
+    file_cache.start = file_cache.end = 0;
+    line_cache.start = line_cache.end = 0;
+}
+
+// append to lines the offset after each newline in the n bytes at s
+static void find_newlines(const char *s, size_t n, std::vector<unsigned> &lines)
+{
+    size_t i = 0;
+#ifdef __SSE2__
+    const __m128i nl = _mm_set1_epi8('\n');
+    for (; i + 16 <= n; i += 16) {
+	__m128i v = _mm_loadu_si128((const __m128i *) (s + i));
+	unsigned m = _mm_movemask_epi8(_mm_cmpeq_epi8(v, nl));
+	for (; m; m &= m - 1)
+	    lines.push_back(i + __builtin_ctz(m) + 1);
+    }
+#endif
+    for (; i < n; i++)
+	if (s[i] == '\n')
+	    lines.push_back(i + 1);
+}
+
+// Build the line table of f.  A regular file is read again for it; the
+// bytes are not kept.  Called with lock held.
+void SourceManager::index(File *f)
+{
+    f->lines.push_back(0);
+    if (f->fd < 0) {
+	find_newlines(f->text.data(), f->size, f->lines);
+    } else {
+	char *text = (char *) malloc(f->size + 1);
+	size_t len = 0;
+	ssize_t n;
+	while (len < f->size &&
+	       (n = pread(f->fd, text + len, f->size - len, len)) > 0)
+	    len += n;
+	find_newlines(text, len, f->lines);
+	free(text);
+    }
+    f->lines_ready = true;
+}
+
+// the file loc is in, with its line table, or NULL
+SourceManager::File *SourceManager::find(SourceLoc loc)
+{
+    FileCache &c = file_cache;
+    if (loc - c.start < c.end - c.start)
+	return (File *) c.file;
+
+    std::lock_guard<std::mutex> hold(lock);
+    size_t lo = 0, hi = files.size();
+    while (lo < hi) {
+	size_t mid = (lo + hi) / 2;
+	if (files[mid]->start <= loc)
+	    lo = mid + 1;
+	else
+	    hi = mid;
+    }
+    if (lo == 0)
+	return NULL;
+    File *f = files[lo - 1];
+    if (loc - f->start > f->size)
+	return NULL;
+    if (!f->lines_ready)
+	index(f);
+    c.start = f->start;
+    c.end = f->start + f->size + 1;
+    c.file = f;
+    return f;
+}
+
+// line() when loc is not on the line looked up last
+int SourceManager::find_line(SourceLoc loc)
+{
+    LineCache &c = line_cache;
+    File *f = find(loc);
+    if (f == NULL)
+	return 0;
+    unsigned offset = loc - f->start;
+    size_t i = std::upper_bound(f->lines.begin(), f->lines.end(), offset)
+	       - f->lines.begin();
+    c.start = f->start + f->lines[i - 1];
+    c.end = i < f->lines.size() ? f->start + f->lines[i]
+				: f->start + f->size + 1;
+    c.line = i;
+    return c.line;
+}
+
+int SourceManager::column(SourceLoc loc)
+{
+    if (line(loc) == 0)
+	return 0;
+    return loc - line_cache.start + 1;
+}
+
+const char *SourceManager::file_name(SourceLoc loc)
+{
+    File *f = find(loc);
+    return f ? f->name.c_str() : NULL;
+}
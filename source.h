@@ -0,0 +1,90 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+#ifndef _SOURCE_H_
+#define _SOURCE_H_
+
+///////////////////////////////////////////////////////////////////////////
+//
+// file: source.h
+//
+// Source locations.  A SourceLoc is a 32-bit offset into one location
+// space shared by every file the process compiles: each file is given
+// its own range of it when it is opened, one location per byte and one
+// more for its end.  So a SourceLoc names the file as well as the place
+// in it, and the files of a batch never share a location.  Location 0
+// belongs to no file.
+//
+// The scanners only count bytes.  Line and column numbers are worked
+// out when a diagnostic or the dump asks for them: the first request
+// for a file builds a table of where its lines start, with a vector
+// scan for newlines, and each request is then a binary search of that
+// table.  Requests for nearby locations, as the dump makes them, are
+// answered from the line found last.
+//
+// The source manager is shared by all threads; a file may be resolved
+// on any thread until it is removed.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include <stdio.h>
+#include <mutex>
+#include <string>
+#include <vector>
+
+typedef unsigned SourceLoc;
+
+class SourceManager {
+private:
+    struct File {
+	std::string name;
+	SourceLoc start;            // location of the first byte
+	unsigned size;              // bytes; start + size is the end
+	int fd;                     // to read it again, if regular
+	std::string text;           // the bytes, if it is not regular
+	bool lines_ready;
+	std::vector<unsigned> lines;  // offset of the start of each line
+    };
+    std::mutex lock;            // held to add, remove and index files
+    std::vector<File *> files;  // by start
+    SourceLoc next;             // start of the next file
+
+    // the line last looked up on this thread
+    struct LineCache {
+	SourceLoc start, end;       // the locations of the line
+	int line;
+    };
+    static thread_local LineCache line_cache;
+
+    File *find(SourceLoc loc);
+    void index(File *f);
+    int find_line(SourceLoc loc);
+public:
+    SourceManager() : next(1) { }
+
+    // Give the file input, called name, a range of locations and return
+    // the location of its first byte.  input must be at its beginning.
+    // If it is not a regular file it is read to its end here, and input
+    // is replaced by a stream over what was read.
+    SourceLoc add_file(const char *name, FILE *&input);
+    // forget the file at start; its locations must not be used again
+    void remove_file(SourceLoc start);
+
+    // 1-based line and column of loc, or 0 if it is in no file
+    int line(SourceLoc loc)
+    {
+	LineCache &c = line_cache;
+	if (loc - c.start < c.end - c.start)
+	    return c.line;
+	return find_line(loc);
+    }
+    int column(SourceLoc loc);
+    const char *file_name(SourceLoc loc);
+};
+
+extern SourceManager source_manager;
+
+#endif
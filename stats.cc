@@ -0,0 +1,173 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+//
+// Phase timers and counters reported by -X; see stats.h.
+//
+
+#include <chrono>
+#include "stats.h"
+#include "tree.h"
+#include "stringtab.h"
+
+thread_local CompileStats compile_stats;
+
+static const char *phase_names[PHASE_COUNT] = {
+    "parse", "flatten", "install_calls", "check_main", "install_globals",
+    "bind_calls", "check_calls", "dump"
+};
+
+// the class of the nodes of each NodeKind; every list class is one kind
+static const char *node_class_names[NODE_KIND_COUNT] = {
+    "Program_class", "VariableDecl_class", "Variable_class",
+    "CallDecl_class", "StmtBlock_class", "IfStmt_class", "WhileStmt_class",
+    "ForStmt_class", "ReturnStmt_class", "ContinueStmt_class",
+    "BreakStmt_class", "Call_class", "Actual_class", "Assign_class",
+    "Add_class", "Minus_class", "Multi_class", "Divide_class", "Mod_class",
+    "Neg_class", "Lt_class", "Le_class", "Equ_class", "Neq_class",
+    "Ge_class", "Gt_class", "And_class", "Or_class", "Xor_class",
+    "Not_class", "Bitand_class", "Bitor_class", "Bitnot_class",
+    "Const_int_class", "Const_string_class", "Const_float_class",
+    "Const_bool_class", "Object_class", "No_expr_class", "list_node"
+};
+
+// monotonic clock reading in nanoseconds
+static long now_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void stats_reset()
+{
+    CompileStats &s = compile_stats;
+    for (int i = 0; i < PHASE_COUNT; i++)
+        s.phase_ms[i] = 0;
+    s.current = PHASE_NONE;
+    s.started = 0;
+    s.tokens = 0;
+    s.descent_fallbacks = 0;
+    for (int i = 0; i < NODE_KIND_COUNT; i++)
+        s.nodes[i] = 0;
+    s.symtab_lookups = 0;
+    s.symtab_probes = 0;
+    s.max_scope_depth = 0;
+}
+
+void stats_phase(int p)
+{
+    if (!stats_mode)
+        return;
+    CompileStats &s = compile_stats;
+    long t = now_ns();
+    if (s.current != PHASE_NONE)
+        s.phase_ms[s.current] += (t - s.started) / 1e6;
+    s.current = p;
+    s.started = t;
+}
+
+enum { NAME_WIDTH = 48 };
+
+// one line of the -X table: an indented name and a right aligned value
+template <class T>
+static void table_row(ostream& out, const char *name, T value)
+{
+    out << "  " << std::left << std::setw(NAME_WIDTH - 2) << name
+        << std::right << std::setw(12) << value << "\n";
+}
+
+// print s as a JSON string literal
+static void json_string(ostream& out, const char *s)
+{
+    out << '"';
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\')
+            out << '\\';
+        out << *s;
+    }
+    out << '"';
+}
+
+void stats_print(ostream& out, const char *filename)
+{
+    CompileStats &s = compile_stats;
+    stats_phase(PHASE_NONE);
+    long ast_nodes = 0;
+    for (int i = 0; i < NODE_KIND_COUNT; i++)
+        ast_nodes += s.nodes[i];
+
+    struct { const char *name; int size; } tables[] = {
+        { "idtable", idtable.size() },
+        { "stringtable", stringtable.size() },
+        { "inttable", inttable.size() },
+        { "floattable", floattable.size() },
+        { "floatspellings", floatspellings.size() },
+    };
+    const int ntables = sizeof(tables) / sizeof(tables[0]);
+
+    double total = 0;
+    for (int i = 0; i < PHASE_COUNT; i++)
+        total += s.phase_ms[i];
+
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << std::fixed << std::setprecision(3);
+
+    if (stats_mode == STATS_JSON) {
+        out << "{\"file\": ";
+        json_string(out, filename);
+        out << ", \"phases_ms\": {";
+        for (int i = 0; i < PHASE_COUNT; i++)
+            out << (i ? ", " : "") << "\"" << phase_names[i] << "\": "
+                << s.phase_ms[i];
+        out << "}, \"total_ms\": " << total
+            << ", \"tokens\": " << s.tokens
+            << ", \"descent_fallbacks\": " << s.descent_fallbacks
+            << ", \"ast_nodes\": " << ast_nodes
+            << ", \"ast_nodes_by_class\": {";
+        const char *sep = "";
+        for (int i = 0; i < NODE_KIND_COUNT; i++) {
+            if (s.nodes[i] == 0)
+                continue;
+            out << sep;
+            json_string(out, node_class_names[i]);
+            out << ": " << s.nodes[i];
+            sep = ", ";
+        }
+        out << "}, \"symbols\": {";
+        for (int i = 0; i < ntables; i++)
+            out << (i ? ", " : "") << "\"" << tables[i].name << "\": "
+                << tables[i].size;
+        out << "}, \"symtab_lookups\": " << s.symtab_lookups
+            << ", \"symtab_probes\": " << s.symtab_probes
+            << ", \"max_scope_depth\": " << s.max_scope_depth
+            << "}\n";
+    } else {
+        out << std::left << std::setw(NAME_WIDTH) << "phase"
+            << std::right << std::setw(12) << "time (ms)" << "\n";
+        for (int i = 0; i < PHASE_COUNT; i++)
+            table_row(out, phase_names[i], s.phase_ms[i]);
+        table_row(out, "total", total);
+        out << std::left << std::setw(NAME_WIDTH) << "counter"
+            << std::right << std::setw(12) << "count" << "\n";
+        table_row(out, "tokens", s.tokens);
+        table_row(out, "descent fallbacks", s.descent_fallbacks);
+        table_row(out, "ast nodes", ast_nodes);
+        for (int i = 0; i < NODE_KIND_COUNT; i++) {
+            std::string name = "  " + std::string(node_class_names[i]);
+            if (s.nodes[i] != 0)
+                table_row(out, name.c_str(), s.nodes[i]);
+        }
+        for (int i = 0; i < ntables; i++)
+            table_row(out, tables[i].name, tables[i].size);
+        table_row(out, "symtab lookups", s.symtab_lookups);
+        table_row(out, "symtab probes", s.symtab_probes);
+        table_row(out, "max scope depth", s.max_scope_depth);
+    }
+
+    out.flags(flags);
+    out.precision(precision);
+}
@@ -0,0 +1,79 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+#ifndef _STATS_H_
+#define _STATS_H_
+
+///////////////////////////////////////////////////////////////////////////
+//
+// file: stats.h
+//
+// Instrumentation behind the -X flag: a wall-clock timer for each
+// compiler phase and counters for the work done in it.  "-X table"
+// prints a human readable table after every compilation, "-X json"
+// prints one JSON object per compilation.
+//
+// The statistics of a compilation are kept per thread, so the files of
+// a parallel batch are measured independently.  When -X is not given
+// every hook below returns after a single test of stats_mode.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include "seal-io.h"
+#include "nodekind.h"
+
+enum StatsMode { STATS_OFF, STATS_TABLE, STATS_JSON };
+extern int stats_mode;          // set by -X in handle_flags.cc
+
+enum Phase {
+    PHASE_PARSE,                // seal_yyparse
+    PHASE_FLATTEN,              // FlatAst::build, with -A
+    PHASE_INSTALL_CALLS,        // install_calls
+    PHASE_CHECK_MAIN,           // check_main
+    PHASE_INSTALL_GLOBALS,      // install_globalVars
+    PHASE_BIND_CALLS,           // bind_calls
+    PHASE_CHECK_CALLS,          // check_calls
+    PHASE_DUMP,                 // dump_with_types
+    PHASE_COUNT,
+    PHASE_NONE = PHASE_COUNT
+};
+
+struct CompileStats {
+    double phase_ms[PHASE_COUNT];       // time spent in each phase
+    int current;                        // running phase, or PHASE_NONE
+    long started;                       // clock reading when it began
+    long tokens;                        // tokens handed to the parser
+    long descent_fallbacks;             // -R parses left to bison
+    long nodes[NODE_KIND_COUNT];        // AST nodes made, by NodeKind
+    long symtab_lookups;                // objectEnv lookup() calls
+    long symtab_probes;                 // objectEnv probe() calls
+    int max_scope_depth;                // deepest objectEnv scope
+};
+
+extern thread_local CompileStats compile_stats;
+
+// forget the statistics of the previous compilation
+void stats_reset();
+
+// end the running phase, if any, and start timing phase p; PHASE_NONE
+// just ends the running phase
+void stats_phase(int p);
+
+inline void stats_token()
+{
+    if (stats_mode) compile_stats.tokens++;
+}
+
+inline void stats_node(NodeKind k)
+{
+    if (stats_mode) compile_stats.nodes[k]++;
+}
+
+// print the statistics of this compilation in the format chosen by -X;
+// filename is included in the JSON output
+void stats_print(ostream& s, const char *filename);
+
+#endif
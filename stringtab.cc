@@ -5,6 +5,9 @@
 #include "copyright.h"
 
 #include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+#include <charconv>
 #include "stringtab_functions.h"
 #include "stringtab.h"
 
@@ -19,10 +22,54 @@ template class StringTable<StringEntry>;
 template class StringTable<IntEntry>;
 template class StringTable<FloatEntry>;
 
-Entry::Entry(char *s, int l, int i) : len(l), index(i) {
-  str = new char [len+1];
-  strncpy(str, s, len);
+Entry::Entry(char *s, int l, int i) : str(s), len(l), index(i) { }
+
+#define ARENA_CHUNK_SIZE 65536
+
+//
+// Strings are copied into the current chunk; a string that does not fit
+// starts a new chunk, which is made larger than usual for strings longer
+// than ARENA_CHUNK_SIZE.
+//
+char *StringArena::copy(char *s, int len)
+{
+  memcpy(reserve(len), s, len);
+  return commit(len);
+}
+
+char *StringArena::reserve(int len)
+{
+  if (end - cur < len + 1) {
+    int size = len + 1 > ARENA_CHUNK_SIZE ? len + 1 : ARENA_CHUNK_SIZE;
+    Chunk *c = (Chunk *) ::operator new(sizeof(Chunk) + size);
+    c->next = chunks;
+    c->size = size;
+    chunks = c;
+    cur = (char *) (c + 1);
+    end = cur + size;
+    reserved += size;
+  }
+  return cur;
+}
+
+char *StringArena::commit(int len)
+{
+  char *str = cur;
   str[len] = '\0';
+  cur += len + 1;
+  used += len + 1;
+  return str;
+}
+
+void StringArena::release()
+{
+  while (chunks) {
+    Chunk *c = chunks;
+    chunks = c->next;
+    ::operator delete(c);
+  }
+  cur = end = NULL;
+  used = reserved = 0;
 }
 
 int Entry::equal_string(char *string, int length) const
@@ -73,10 +120,68 @@ void dump_Symbol(ostream& s, int n, Symbol sym)
 
 StringEntry::StringEntry(char *s, int l, int i) : Entry(s,l,i) { }
 IdEntry::IdEntry(char *s, int l, int i) : Entry(s,l,i) { }
-IntEntry::IntEntry(char *s, int l, int i) : Entry(s,l,i) { }
-FloatEntry::FloatEntry(char *s, int l, int i) : Entry(s,l,i) { }
 
-IdTable idtable;
-IntTable inttable;
-StrTable stringtable;
-FloatTable floattable;
\ No newline at end of file
+//
+// s is an optionally signed string of decimal digits.  If its value
+// does not fit, it is taken modulo 2^64.
+//
+IntEntry::IntEntry(char *s, int l, int i) : Entry(s,l,i)
+{
+  std::from_chars_result r = std::from_chars(s, s + l, value);
+  if (r.ec == std::errc::result_out_of_range) {
+    bool negative = *s == '-';
+    uint64_t u = 0;
+    for (char *p = s + negative; p < s + l; p++)
+      u = u * 10 + (*p - '0');
+    value = (int64_t) (negative ? -u : u);
+  } else if (r.ec != std::errc()) {
+    value = 0;
+  }
+}
+
+//
+// from_chars leaves value alone when s overflows or underflows; strtod
+// then gives the infinity or the (possibly zero) subnormal it rounds
+// to.  s must be NUL-terminated.
+//
+double parse_float(char *s, int l)
+{
+  double value;
+  std::from_chars_result r = std::from_chars(s, s + l, value);
+  if (r.ec == std::errc::result_out_of_range)
+    value = strtod(s, NULL);
+  else if (r.ec != std::errc())
+    value = 0;
+  return value;
+}
+
+FloatEntry::FloatEntry(char *s, int l, int i) : Entry(s,l,i)
+{
+  value = parse_float(s, l);
+}
+
+IntEntry *IntTable::add_int(int64_t i)
+{
+  char buf[24];
+  std::to_chars_result r = std::to_chars(buf, buf + sizeof buf, i);
+  return add_chars(buf, r.ptr - buf);
+}
+
+FloatEntry *FloatTable::add_float(double d)
+{
+  // the longest shortest fixed form is that of the least subnormal
+  char buf[400];
+  std::to_chars_result r = std::to_chars(buf, buf + sizeof buf - 2, d,
+                                         std::chars_format::fixed);
+  if (isfinite(d) && memchr(buf, '.', r.ptr - buf) == NULL) {
+    *r.ptr++ = '.';
+    *r.ptr++ = '0';
+  }
+  return add_chars(buf, r.ptr - buf);
+}
+
+thread_local IdTable idtable;
+thread_local IntTable inttable;
+thread_local StrTable stringtable;
+thread_local FloatTable floattable;
+thread_local IdTable floatspellings;
\ No newline at end of file
@@ -11,6 +11,10 @@
 
 #include <assert.h>
 #include <string.h>
+#include <stdint.h>
+#include <new>
+#include <utility>
+#include <mutex>
 #include "list.h"    // list template
 #include "seal-io.h"
 
@@ -32,6 +36,8 @@ protected:
   int  len;      // the length of the string (without trailing \0)
   int index;     // a unique index for each string
 public:
+  // s must be a NUL-terminated copy owned by the table's StringArena;
+  // the Entry does not copy it.
   Entry(char *s, int l, int i);
 
   // is string argument equal to the str of this Entry?
@@ -39,6 +45,7 @@ public:
                          
   // is the integer argument equal to the index of this Entry?
   bool equal_index(int ind) const           { return ind == index; }
+  int get_index() const                      { return index; }
 
   ostream& print(ostream& s) const;
 
@@ -72,38 +79,200 @@ public:
   IdEntry(char *s, int l, int i);
 };
 
+//
+// Numeric entries also hold the value of their string, which is parsed
+// once, when the string is first added to its table.
+//
 class IntEntry: public Entry {
+protected:
+  int64_t value;
 public:
   void code_def(ostream& str, int intclasstag);
   void code_ref(ostream& str);
   IntEntry(char *s, int l, int i);
+  int64_t get_value() const { return value; }
 };
 
+// the value of the decimal fraction s of length l
+double parse_float(char *s, int l);
+
 class FloatEntry: public Entry {
+protected:
+  double value;
 public:
   void code_def(ostream& str, int floatclasstag);
   void code_ref(ostream& str);
   FloatEntry(char *s, int l, int i);
+  double get_value() const { return value; }
 };
 
 typedef StringEntry *StringEntryP;
 typedef IdEntry *IdEntryP;
 typedef IntEntry *IntEntryP;
 typedef FloatEntry *FloatEntryP;
+//////////////////////////////////////////////////////////////////////////
+//
+//  Table storage
+//
+//  StringArena is a bump-pointer allocator for the characters of
+//  interned strings.  Slab<T> hands out fixed-size objects from large
+//  chunks.  Neither frees individual allocations; release() returns all
+//  memory in one shot.
+//
+//////////////////////////////////////////////////////////////////////////
+
+class StringArena {
+private:
+   struct Chunk {
+      Chunk *next;
+      int size;          // usable bytes following the header
+   };
+   Chunk *chunks;        // most recently allocated chunk first
+   char *cur;            // next free byte in the current chunk
+   char *end;            // end of the current chunk
+   long used;            // bytes handed out
+   long reserved;        // bytes obtained from the heap
+public:
+   StringArena() : chunks(NULL), cur(NULL), end(NULL), used(0), reserved(0) { }
+   ~StringArena() { release(); }
+
+   // copy the first len characters of s, plus a trailing \0
+   char *copy(char *s, int len);
+
+   // room for a string of up to len characters at the end of the arena;
+   // it stays free until commit() keeps the first len characters of it
+   char *reserve(int len);
+   char *commit(int len);
+
+   void release();
+
+   // exchange contents with other; no strings move
+   void swap(StringArena &other)
+   {
+      std::swap(chunks, other.chunks);
+      std::swap(cur, other.cur);
+      std::swap(end, other.end);
+      std::swap(used, other.used);
+      std::swap(reserved, other.reserved);
+   }
+
+   long bytes_used() const     { return used; }
+   long bytes_reserved() const { return reserved; }
+};
+
+template <class T>
+class Slab {
+private:
+   enum { CHUNK_OBJECTS = 1024 };
+   struct Chunk {
+      Chunk *next;
+      T *objects;
+   };
+   Chunk *chunks;
+   int left;             // unused objects in the head chunk
+   long count;           // objects handed out
+public:
+   Slab() : chunks(NULL), left(0), count(0) { }
+   ~Slab() { release(); }
+
+   // raw storage for one T; construct it with placement new
+   void *alloc()
+   {
+      if (left == 0) {
+         Chunk *c = new Chunk;
+         c->objects = (T *) ::operator new(CHUNK_OBJECTS * sizeof(T));
+         c->next = chunks;
+         chunks = c;
+         left = CHUNK_OBJECTS;
+      }
+      count++;
+      return &chunks->objects[CHUNK_OBJECTS - left--];
+   }
+
+   // The objects are not destroyed; T must not need a destructor.
+   void release()
+   {
+      while (chunks) {
+         Chunk *c = chunks;
+         chunks = c->next;
+         ::operator delete(c->objects);
+         delete c;
+      }
+      left = 0;
+      count = 0;
+   }
+
+   void swap(Slab &other)
+   {
+      std::swap(chunks, other.chunks);
+      std::swap(left, other.left);
+      std::swap(count, other.count);
+   }
+
+   long bytes_used() const { return count * (long) sizeof(T); }
+};
+
 //////////////////////////////////////////////////////////////////////////
 //
 //  String Tables
 //
 //////////////////////////////////////////////////////////////////////////
 
+//
+// A string table interns each distinct string exactly once.  Strings are
+// found through an open-addressed hash table (linear probing) whose slots
+// cache the full hash of the entry, so a probe only touches the entry's
+// characters when the hashes already agree.  Entries are also kept in a
+// dense vector in index order, which makes lookup(index) a plain array
+// access.
+//
 template <class Elem> 
 class StringTable
 {
 protected:
-   List<Elem> *tbl;   // a string table is a list
-   int index;         // the current index
+   struct HashSlot {
+      unsigned hash;   // cached hash of elem's string
+      Elem *elem;      // NULL marks an empty slot
+   };
+
+   StringArena strings;  // characters of every entry
+   Slab<Elem> elems;     // the entries themselves
+   HashSlot *slots;   // open-addressed hash table
+   int capacity;      // number of slots; always a power of two
+   Elem **entries;    // dense vector of entries, indexed by Entry index
+   int entries_cap;   // allocated size of entries
+   int index;         // the current index (= number of entries)
+   StringTable *shared;  // the table this one caches, if any
+   std::mutex lock;      // taken by caches when adding to this table
+
+   static unsigned hash_string(char *s, int len);
+   int find_slot(char *s, int len, unsigned h);
+   Elem *insert(char *str, int len, unsigned h, int slot);
+   Elem *add_shared(char *s, int len, unsigned h, int slot);
+   void grow();
 public:
-   StringTable(): tbl((List<Elem> *) NULL), index(0) { }   // an empty table
+   StringTable();                       // an empty table
+   ~StringTable();
+
+   // Free every entry and all table storage at once, leaving an empty
+   // table.  Symbols obtained from the table become dangling.
+   void release();
+
+   // Exchange contents with other, which may belong to another thread.
+   // Entries stay where they are, so Symbols remain valid.
+   void swap(StringTable &other);
+
+   // Make this (empty) table a cache in front of shared, which may
+   // belong to another thread: strings it has not seen are added to
+   // shared under shared's lock, and it remembers the Symbols it got.
+   // Several threads can share one table this way, as long as its own
+   // thread does not use it meanwhile.  share(NULL) empties the cache
+   // and makes the table independent again.  A cache has no index
+   // space of its own: the index of a Symbol it returns is the one in
+   // shared, and lookup(index), the iterator and print may only be
+   // used on shared.
+   void share(StringTable *shared);
+
    // The following methods each add a string to the string table.  
    // Only one copy of each string is maintained.  
    // Returns a pointer to the string table entry with the string.
@@ -114,9 +283,15 @@ public:
    // add the (null terminated) string s
    Elem *add_string(char *s);
 
-   // add the string representation of an integer
-   Elem *add_int(long i);
+   // add the len characters at s, which need not be null terminated
+   Elem *add_chars(char *s, int len);
 
+   // Build a string in place: write up to len characters into
+   // reserve_string(len), then add the first n of them with
+   // add_reserved(n).  If the string is new, the characters are kept
+   // where they were written rather than copied.
+   char *reserve_string(int len) { return strings.reserve(len); }
+   Elem *add_reserved(int len);
 
    // An iterator.
    int first();       // first index
@@ -127,6 +302,11 @@ public:
    Elem *lookup_string(char *s); // lookup an element using its string
 
    void print();  // print the entire table; for debugging
+   int size() { return index; }  // number of entries; for a cache, of
+                                 // the strings it remembers
+
+   // print entry count and the bytes held by each kind of storage
+   void print_stats(ostream& s, const char *name);
 
 };
 
@@ -138,20 +318,38 @@ public:
    void code_string_table(ostream&, int classtag);
 };
 
+//
+// The string of an integer entry is the decimal form of its value, so
+// each value has one entry.  (A decimal constant too large for 64 bits
+// keeps its spelling; its value wraps.)  Floats are keyed by value
+// too: every entry comes from add_float, so "1.5" and "1.50" share one.
+// The spelling a float constant was written with, which the dump
+// prints, is interned in floatspellings by the scanners and kept on its
+// Const_float_class.
+//
 class IntTable : public StringTable<IntEntry>
 {
 public:
    void code_string_table(ostream&, int classtag);
+
+   // the entry for the value i
+   IntEntry *add_int(int64_t i);
 };
 
 class FloatTable : public StringTable<FloatEntry>
 {
 public:
    void code_string_table(ostream&, int classtag);
+
+   // the entry for the value d, spelled as the shortest decimal that
+   // reads back as d, with at least one digit after the point
+   FloatEntry *add_float(double d);
 };
 
-extern IdTable idtable;
-extern IntTable inttable;
-extern StrTable stringtable;
-extern FloatTable floattable;
+// Each thread interns into its own tables.
+extern thread_local IdTable idtable;
+extern thread_local IntTable inttable;
+extern thread_local StrTable stringtable;
+extern thread_local FloatTable floattable;
+extern thread_local IdTable floatspellings;
 #endif
@@ -5,17 +5,129 @@
 #include "copyright.h"
 
 #include "seal-io.h"
+#include "stringtab.h"
 #define MAXSIZE 1000000
 #define min(a,b) (a > b ? b : a)
 
-#include "stringtab.h"
 #include <stdio.h>
 
+#define INITIAL_CAPACITY 64
+
 //
-// A string table is implemented a linked list of Entrys.  Each Entry
-// in the list has a unique string.
+// A string table is implemented as an open-addressed hash table of
+// Entrys plus a dense vector of the same Entrys in index order.  Each
+// Entry in the table has a unique string.
 //
 
+template <class Elem>
+StringTable<Elem>::StringTable() : capacity(INITIAL_CAPACITY),
+                                   entries_cap(INITIAL_CAPACITY), index(0),
+                                   shared(NULL)
+{
+  slots = new HashSlot[capacity];
+  memset(slots, 0, capacity * sizeof(HashSlot));
+  entries = new Elem *[entries_cap];
+}
+
+template <class Elem>
+StringTable<Elem>::~StringTable()
+{
+  delete [] slots;
+  delete [] entries;
+}
+
+template <class Elem>
+void StringTable<Elem>::release()
+{
+  strings.release();
+  elems.release();
+
+  delete [] slots;
+  delete [] entries;
+  capacity = INITIAL_CAPACITY;
+  entries_cap = INITIAL_CAPACITY;
+  index = 0;
+  slots = new HashSlot[capacity];
+  memset(slots, 0, capacity * sizeof(HashSlot));
+  entries = new Elem *[entries_cap];
+}
+
+template <class Elem>
+void StringTable<Elem>::swap(StringTable &other)
+{
+  strings.swap(other.strings);
+  elems.swap(other.elems);
+  std::swap(slots, other.slots);
+  std::swap(capacity, other.capacity);
+  std::swap(entries, other.entries);
+  std::swap(entries_cap, other.entries_cap);
+  std::swap(index, other.index);
+}
+
+template <class Elem>
+void StringTable<Elem>::share(StringTable *s)
+{
+  release();
+  shared = s;
+}
+
+//
+// FNV-1a over the first len characters of s.
+//
+template <class Elem>
+unsigned StringTable<Elem>::hash_string(char *s, int len)
+{
+  unsigned h = 2166136261u;
+  for (int i = 0; i < len; i++) {
+    h ^= (unsigned char) s[i];
+    h *= 16777619u;
+  }
+  return h;
+}
+
+//
+// Return the slot holding the string s of length len, or the empty slot
+// where it would be inserted.  The table is never full, so the probe
+// sequence always terminates.
+//
+template <class Elem>
+int StringTable<Elem>::find_slot(char *s, int len, unsigned h)
+{
+  int mask = capacity - 1;
+  for (int i = h & mask; ; i = (i + 1) & mask) {
+    if (slots[i].elem == NULL)
+      return i;
+    if (slots[i].hash == h && slots[i].elem->equal_string(s, len))
+      return i;
+  }
+}
+
+//
+// Double the slot array and reinsert every entry.  The cached hashes
+// mean no string is rehashed.
+//
+template <class Elem>
+void StringTable<Elem>::grow()
+{
+  HashSlot *old = slots;
+  int old_capacity = capacity;
+
+  capacity *= 2;
+  slots = new HashSlot[capacity];
+  memset(slots, 0, capacity * sizeof(HashSlot));
+
+  int mask = capacity - 1;
+  for (int j = 0; j < old_capacity; j++) {
+    if (old[j].elem == NULL)
+      continue;
+    int i = old[j].hash & mask;
+    while (slots[i].elem != NULL)
+      i = (i + 1) & mask;
+    slots[i] = old[j];
+  }
+  delete [] old;
+}
+
 template <class Elem>
 Elem *StringTable<Elem>::add_string(char *s)
 {
@@ -23,79 +135,141 @@ Elem *StringTable<Elem>::add_string(char *s)
 }
 
 //
-// Add a string requires two steps.  First, the list is searched; if the
-// string is found, a pointer to the existing Entry for that string is 
+// Add a string requires two steps.  First, the hash table is probed; if
+// the string is found, a pointer to the existing Entry for that string is 
 // returned.  If the string is not found, a new Entry is created and added
-// to the list.
+// to both the hash table and the index vector.  The Entry and its
+// characters are carved out of the table's slab and string arena.
 //
 template <class Elem>
 Elem *StringTable<Elem>::add_string(char *s, int maxchars)
 {
-  int len = min((int) strlen(s),maxchars);
-  for(List<Elem> *l = tbl; l; l = l->tl())
-    if (l->hd()->equal_string(s,len))
-      return l->hd();
+  return add_chars(s, strnlen(s, maxchars));
+}
+
+template <class Elem>
+Elem *StringTable<Elem>::add_chars(char *s, int len)
+{
+  unsigned h = hash_string(s, len);
+  int i = find_slot(s, len, h);
+  if (slots[i].elem)
+    return slots[i].elem;
+  if (shared)
+    return add_shared(s, len, h, i);
+  return insert(strings.copy(s, len), len, h, i);
+}
+
+//
+// The characters were written straight into the arena by the caller,
+// so a new entry takes them over without a copy.
+//
+template <class Elem>
+Elem *StringTable<Elem>::add_reserved(int len)
+{
+  char *s = strings.reserve(len);
+  unsigned h = hash_string(s, len);
+  int i = find_slot(s, len, h);
+  if (slots[i].elem)
+    return slots[i].elem;
+  if (shared)
+    return add_shared(s, len, h, i);
+  return insert(strings.commit(len), len, h, i);
+}
+
+//
+// Make a new entry for the len characters at str, which the entry now
+// owns, and store it in slot i.
+//
+template <class Elem>
+Elem *StringTable<Elem>::insert(char *str, int len, unsigned h, int i)
+{
+  Elem *e = new (elems.alloc()) Elem(str,len,index);
+  if (index == entries_cap) {
+    Elem **old = entries;
+    entries_cap *= 2;
+    entries = new Elem *[entries_cap];
+    memcpy(entries, old, index * sizeof(Elem *));
+    delete [] old;
+  }
+  entries[index++] = e;
 
-  Elem *e = new Elem(s,len,index++);
-  tbl = new List<Elem>(e, tbl);
+  slots[i].hash = h;
+  slots[i].elem = e;
+  // keep the load factor at or below 1/2
+  if (2 * index > capacity)
+    grow();
   return e;
 }
 
 //
-// To look up a string, the list is scanned until a matching Entry is located.
-// If no such entry is found, an assertion failure occurs.  Thus, this function
-// is used only for strings that one expects to find in the table.
+// A cache miss: find or add the string in the shared table, then
+// remember the shared entry in slot i.  The cache's index counts the
+// entries it remembers; it has no entries of its own, so entries is
+// left unfilled.
 //
 template <class Elem>
-Elem *StringTable<Elem>::lookup_string(char *s)
+Elem *StringTable<Elem>::add_shared(char *s, int len, unsigned h, int i)
 {
-  int len = strlen(s);
-  for(List<Elem> *l = tbl; l; l = l->tl())
-    if (l->hd()->equal_string(s,len))
-      return l->hd();
-  assert(0);   // fail if string is not found
-  return NULL; // to avoid compiler warning
+  Elem *e;
+  {
+    std::lock_guard<std::mutex> hold(shared->lock);
+    int j = shared->find_slot(s, len, h);
+    e = shared->slots[j].elem;
+    if (e == NULL)
+      e = shared->insert(shared->strings.copy(s, len), len, h, j);
+  }
+  slots[i].hash = h;
+  slots[i].elem = e;
+  if (2 * ++index > capacity)
+    grow();
+  return e;
 }
 
 //
-// lookup is similar to lookup_string, but uses the index of the string
-// as the key.
+// To look up a string, the hash table is probed until a matching Entry is
+// located.  If no such entry is found, an assertion failure occurs.  Thus,
+// this function is used only for strings that one expects to find in the
+// table.
 //
 template <class Elem>
-Elem *StringTable<Elem>::lookup(int ind)
+Elem *StringTable<Elem>::lookup_string(char *s)
 {
-  for(List<Elem> *l = tbl; l; l = l->tl())
-    if (l->hd()->equal_index(ind))
-      return l->hd();
-  assert(0);   // fail if string is not found
-  return NULL; // to avoid compiler warning
+  int len = strlen(s);
+  Elem *e = slots[find_slot(s, len, hash_string(s, len))].elem;
+  assert(e);   // fail if string is not found
+  return e;
 }
 
 //
-// add_int adds the string representation of an integer to the list.
+// lookup is similar to lookup_string, but uses the index of the string
+// as the key.
 //
 template <class Elem>
-Elem *StringTable<Elem>::add_int(long i)
+Elem *StringTable<Elem>::lookup(int ind)
 {
-  static char *buf = new char[20];
-  snprintf(buf, 20, "%ld", i);
-  return add_string(buf);
+  assert(shared == NULL);            // a cache has no index space
+  assert(ind >= 0 && ind < index);   // fail if string is not found
+  return entries[ind];
 }
+
 template <class Elem>
 int StringTable<Elem>::first()
 {
+  assert(shared == NULL);
   return 0;
 }
 
 template <class Elem>
 int StringTable<Elem>::more(int i)
 {
+  assert(shared == NULL);
   return i < index;
 }
 
 template <class Elem>
 int StringTable<Elem>::next(int i)
 {
+  assert(shared == NULL);
   assert(i < index);
   return i+1;
 }
@@ -103,5 +277,21 @@ int StringTable<Elem>::next(int i)
 template <class Elem>
 void StringTable<Elem>::print()
 {
-  list_print(cerr,tbl);
+  assert(shared == NULL);
+  cerr << "[\n";
+  for (int i = 0; i < index; i++)
+    cerr << *entries[i] << " ";
+  cerr << "]\n";
+}
+
+template <class Elem>
+void StringTable<Elem>::print_stats(ostream& s, const char *name)
+{
+  long index_bytes = capacity * (long) sizeof(HashSlot) +
+                     entries_cap * (long) sizeof(Elem *);
+  s << name << ": " << index << " entries, "
+    << strings.bytes_used() << " string bytes ("
+    << strings.bytes_reserved() << " reserved), "
+    << elems.bytes_used() << " entry bytes, "
+    << index_bytes << " index bytes\n";
 }
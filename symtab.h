@@ -14,6 +14,8 @@
 #ifndef _SYMTAB_H_
 #define _SYMTAB_H_
 
+#include <vector>
+#include <unordered_map>
 #include "list.h"
 
 //
@@ -33,8 +35,12 @@ public:
 };
 
 //
-// SymbolTable<SYM,DAT> describes a symbol table mapping symbols of
-//    type `SYM' to data of type `DAT *'.  It is implemented as a
+// SymbolTable<SYM,DAT,Engine> describes a symbol table mapping symbols of
+//    type `SYM' to data of type `DAT *'.  The representation is chosen at
+//    compile time by the `Engine' policy; both engines below provide the
+//    same enterscope/exitscope/addid/lookup/probe/dump interface.
+//
+// ListScopes<SYM,DAT> is the default engine.  It is implemented as a
 //    list of lists of `SymtabEntry<SYM,DAT> *'.  The inner list is
 //    a scope, a mapping from symbols to data, and the outer list is
 //    a list of scopes. 
@@ -69,20 +75,39 @@ public:
 //
 //    `dump()' prints the symbols in the symbol table.
 //
+//    `lookup_count()', `probe_count()' and `max_depth()' report how
+//        often the table was searched and how deeply scopes nested;
+//        they feed the -X statistics.
+//
 
 template <class SYM, class DAT>
-class SymbolTable
+class ListScopes
 {
    typedef SymtabEntry<SYM,DAT> ScopeEntry;
    typedef List<ScopeEntry> Scope;
    typedef List<Scope> ScopeList;
 private:
    ScopeList  *tbl;
+   int depth;                      // number of scopes entered
+   int deepest;                    // greatest depth so far
+   long lookups, probes;           // calls to lookup and probe
 public:
-   SymbolTable(): tbl(NULL) { }     // create a new symbol table
+   ListScopes(): tbl(NULL), depth(0), deepest(0), lookups(0), probes(0) { }
 
    // Create pointer to current symbol table.
-   SymbolTable &operator =(const SymbolTable &s) { tbl = s.tbl; return *this; }
+   ListScopes &operator =(const ListScopes &s)
+   {
+       tbl = s.tbl;
+       depth = s.depth;
+       deepest = s.deepest;
+       lookups = s.lookups;
+       probes = s.probes;
+       return *this;
+   }
+
+   long lookup_count() const { return lookups; }
+   long probe_count() const  { return probes; }
+   int max_depth() const     { return deepest; }
 
    void fatal_error(char * msg)
    {
@@ -100,6 +125,7 @@ public:
        // The cast of NULL is required for template instantiation to work
        // correctly.
        tbl = new ScopeList((Scope *) NULL, tbl);
+       if (++depth > deepest) deepest = depth;
    }
 
    // Pop the first scope off of the symbol table.
@@ -110,6 +136,7 @@ public:
 	   fatal_error("exitscope: Can't remove scope from an empty symbol table.");
        }
        tbl = tbl->tl();
+       depth--;
    }
 
    // Add an item to the symbol table.
@@ -128,6 +155,7 @@ public:
 
    DAT * lookup(SYM s)
    {
+       lookups++;
        for(ScopeList *i = tbl; i != NULL; i=i->tl()) {
 	   for( Scope *j = i->hd(); j != NULL; j = j->tl()) {
 	       if (s == j->hd()->get_id()) {
@@ -142,6 +170,7 @@ public:
    // 's'.  If found, return the information field.  If not return NULL.
    DAT *probe(SYM s)
    {
+       probes++;
        if (tbl == NULL) {
 	   fatal_error("probe: No scope in symbol table.");
        }
@@ -166,5 +195,156 @@ public:
  
 };
 
+//
+// ScopeInfo<DAT> is what HashedScopes stores for data of type `DAT':
+//    a `DAT *', with NULL for none.  A specialization lets a table hold
+//    something else by value, such as the node numbers of a FlatAst
+//    (see astview.h).
+//
+
+template <class DAT>
+struct ScopeInfo {
+   typedef DAT *type;
+   static type none() { return NULL; }
+};
+
+//
+// HashedScopes<SYM,DAT> keeps a single hash map from each symbol to the
+//    stack of its live bindings, innermost last, where each binding
+//    records the scope depth it was added at.  Every addid is also
+//    appended to an undo log, and each scope remembers where its part of
+//    the log begins.
+//
+//    `enterscope' pushes a new log mark.
+//
+//    `exitscope' pops the binding of every symbol logged since the mark.
+//
+//    `addid(s,i)' pushes a binding for `s' at the current depth.
+//
+//    `lookup(s)' returns the innermost binding of `s'.
+//
+//    `probe(s)' returns the innermost binding of `s' only if it was
+//        added in the current scope.
+//
+//    All five are O(1) amortized.  Unlike ListScopes, a copy made with
+//    `operator =' is a full copy rather than a shared pointer.  What
+//    they store and return is a `ScopeInfo<DAT>::type', by default a
+//    `DAT *'.
+//
+
+template <class SYM, class DAT>
+class HashedScopes
+{
+   typedef typename ScopeInfo<DAT>::type Info;
+   struct Binding {
+      int depth;     // scope depth the binding was added at
+      Info info;
+   };
+   typedef std::vector<Binding> BindingStack;
+private:
+   std::unordered_map<SYM, BindingStack> bindings;
+   std::vector<SYM> log;            // symbols in order of addid
+   std::vector<size_t> marks;       // log size at each enterscope
+   int deepest;                     // greatest depth so far
+   long lookups, probes;            // calls to lookup and probe
+public:
+   HashedScopes() : deepest(0), lookups(0), probes(0) { }
+
+   long lookup_count() const { return lookups; }
+   long probe_count() const  { return probes; }
+   int max_depth() const     { return deepest; }
+
+   void fatal_error(char * msg)
+   {
+     cerr << msg << "\n";
+     exit(1);
+   } 
+
+   void enterscope()
+   {
+       marks.push_back(log.size());
+       if ((int) marks.size() > deepest) deepest = marks.size();
+   }
+
+   void exitscope()
+   {
+       // It is an error to exit a scope that doesn't exist.
+       if (marks.empty()) {
+	   fatal_error("exitscope: Can't remove scope from an empty symbol table.");
+       }
+       size_t mark = marks.back();
+       marks.pop_back();
+       while (log.size() > mark) {
+	   bindings[log.back()].pop_back();
+	   log.pop_back();
+       }
+   }
+
+   void addid(SYM s, Info i)
+   {
+       // There must be at least one scope to add a symbol.
+       if (marks.empty()) fatal_error("addid: Can't add a symbol without a scope.");
+       Binding b = { (int) marks.size(), i };
+       bindings[s].push_back(b);
+       log.push_back(s);
+   }
+
+   Info lookup(SYM s)
+   {
+       lookups++;
+       typename std::unordered_map<SYM, BindingStack>::iterator it = bindings.find(s);
+       if (it == bindings.end() || it->second.empty()) {
+	   return ScopeInfo<DAT>::none();
+       }
+       return it->second.back().info;
+   }
+
+   Info probe(SYM s)
+   {
+       probes++;
+       if (marks.empty()) {
+	   fatal_error("probe: No scope in symbol table.");
+       }
+       typename std::unordered_map<SYM, BindingStack>::iterator it = bindings.find(s);
+       if (it == bindings.end() || it->second.empty() ||
+	   it->second.back().depth != (int) marks.size()) {
+	   return ScopeInfo<DAT>::none();
+       }
+       return it->second.back().info;
+   }
+
+   // Prints out the contents of the symbol table, innermost scope first
+   void dump()
+   {
+      size_t end = log.size();
+      for (int m = (int) marks.size() - 1; m >= 0; m--) {
+         cerr << "\nScope: \n";
+         for (size_t j = end; j > marks[m]; j--) {
+            SYM id = log[j-1];
+            cerr << "  " << id << *lookup_at(id, m + 1) << endl;
+         }
+         end = marks[m];
+      }
+   }
+
+private:
+   // the binding of `s' made at scope depth `depth'; used by dump
+   Info lookup_at(SYM s, int depth)
+   {
+       BindingStack &stack = bindings[s];
+       for (int i = (int) stack.size() - 1; i >= 0; i--) {
+	   if (stack[i].depth == depth) {
+	       return stack[i].info;
+	   }
+       }
+       return ScopeInfo<DAT>::none();
+   }
+};
+
+template <class SYM, class DAT, template <class, class> class Engine = ListScopes>
+class SymbolTable : public Engine<SYM, DAT>
+{
+};
+
 #endif
 
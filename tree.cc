@@ -15,35 +15,125 @@
 
 #include "tree.h"
 
-/* line number to assign to the current node being constructed */
-int node_lineno = 1;
+/* location to assign to the current node being constructed */
+thread_local SourceLoc node_loc = 0;
+
+/* every tree node of the current compilation is allocated here */
+thread_local AstArena ast_arena;
+
+#define AST_CHUNK_SIZE (1 << 20)
+#define AST_ALIGN 16
 
 ///////////////////////////////////////////////////////////////////////////
 //
-// tree_node::tree_node
+// AstArena::alloc
 //
-// constructor of tree node
+// return size bytes aligned for any node type.  A request that does not
+// fit in the current chunk starts a new one; requests larger than a
+// chunk get a chunk of their own.
 //
 ///////////////////////////////////////////////////////////////////////////
-tree_node::tree_node()
+void *AstArena::alloc(size_t size)
+{
+    size = (size + AST_ALIGN - 1) & ~(size_t) (AST_ALIGN - 1);
+    if ((size_t) (end - cur) < size) {
+	size_t chunk_size = size > AST_CHUNK_SIZE ? size : AST_CHUNK_SIZE;
+	// the header is padded so the first node is aligned
+	size_t header = (sizeof(Chunk) + AST_ALIGN - 1) & ~(size_t) (AST_ALIGN - 1);
+	Chunk *c = (Chunk *) ::operator new(header + chunk_size);
+	c->next = chunks;
+	c->size = chunk_size;
+	chunks = c;
+	cur = (char *) c + header;
+	end = cur + chunk_size;
+	reserved += chunk_size;
+    }
+    void *p = cur;
+    cur += size;
+    used += size;
+    return p;
+}
+
+///////////////////////////////////////////////////////////////////////////
+//
+// AstArena::release
+//
+// free every node at once.  Pointers into the old tree become dangling.
+//
+///////////////////////////////////////////////////////////////////////////
+void AstArena::release()
+{
+    while (chunks) {
+	Chunk *c = chunks;
+	chunks = c->next;
+	::operator delete(c);
+    }
+    cur = end = NULL;
+    used = reserved = nodes = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////
+//
+// AstArena::adopt
+//
+// take over the chunks of other, which may belong to another thread,
+// and leave other empty.  The nodes stay where they are.  New nodes
+// still go into this arena's current chunk.
+//
+///////////////////////////////////////////////////////////////////////////
+void AstArena::adopt(AstArena &other)
 {
-    line_number = node_lineno;
+    if (other.chunks == NULL)
+	return;
+    if (chunks == NULL) {
+	chunks = other.chunks;
+	cur = other.cur;
+	end = other.end;
+    } else {
+	Chunk *last = other.chunks;
+	while (last->next)
+	    last = last->next;
+	last->next = chunks->next;
+	chunks->next = other.chunks;
+    }
+    used += other.used;
+    reserved += other.reserved;
+    nodes += other.nodes;
+    other.chunks = NULL;
+    other.cur = other.end = NULL;
+    other.used = other.reserved = other.nodes = 0;
 }
 
 ///////////////////////////////////////////////////////////////////////////
 //
-// tree_node::get_line_number
+// tree_node::tree_node
+//
+// constructor of tree node
 //
 ///////////////////////////////////////////////////////////////////////////
-int tree_node::get_line_number()
-{	
-	return line_number;
+tree_node::tree_node()
+{
+    loc = node_loc;
+    kind = NODE_LIST;
 }
 
 //
 // Set up common area from existing node
 //
 tree_node *tree_node::set(tree_node *t) {
-   line_number = t->line_number;
+   loc = t->loc;
    return this;
 }
+
+///////////////////////////////////////////////////////////////////////////
+//
+// list_range_error
+//
+// what list_node::nth does for an element that is not in the list
+//
+///////////////////////////////////////////////////////////////////////////
+void list_range_error()
+{
+    cerr << "error: outside the range of the list\n";
+    exit(1);
+}
@@ -15,8 +15,12 @@
 ///////////////////////////////////////////////////////////////////////////
  
 
+#include <vector>
 #include "stringtab.h"
 #include "seal-io.h"
+#include "nodekind.h"
+#include "stats.h"
+#include "source.h"
 
 /////////////////////////////////////////////////////////////////////
 //
@@ -24,40 +28,112 @@
 //
 //   All APS nodes are derived from tree_node.  There is a
 //   protected field:
-//       int line_number     line in the source file from which this node came;
-//                           this is read from a global variable when the
-//                           node is created.
+//       SourceLoc loc       where in the source the node came from (see
+//                           source.h); this is read from a global
+//                           variable when the node is created.
 //      
 //
 //
 //   The public methods are:
 //       tree_node()
 //         builds a new tree_node.  The type field is NULL, the
-//         line_number is set to the value of the global yylineno.
+//         loc is set to the value of the global node_loc.  The kind is
+//         NODE_LIST; the constructor of each AST class sets its own
+//         with set_kind.
 //
 //       void dump(ostream& s,int n); 
 //         dump is a pretty printer for tree nodes.  The ostream argument
 //         is the output stream on which the node is to be printed; n is
 //         the number of spaces to indent the output.
 //
-//       int get_line_number();  return the line number
-//       Symbol get_type();      return the type 
+//       void dump_with_types(AstDumpWriter& s,int n);
+//         like dump, but also prints the types the checker assigned.
+//         It walks the tree with a work stack of its own rather than by
+//         recursion, visiting each node once per child and once more at
+//         the end.
+//
+//       NodeKind get_kind();       return which class the node is
+//       SourceLoc get_location();  return the location
+//       int get_line_number();     return the line number, looked up
+//                                  from the location
+//       Symbol get_type();         return the type 
 //
 //       tree_node *set(tree_node *t)
-//           sets the line number and type of "this" to the values in
+//           sets the location and type of "this" to the values in
 //           the argument tree_node.  Returns "this".
 //
 //
 ////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////////
+//
+//  AstArena
+//
+//   A bump-pointer allocator that every tree_node is carved out of
+//   (see tree_node::operator new).  Nodes are never freed one by one;
+//   release() returns the memory of every node allocated so far in one
+//   shot, without running destructors.  The driver releases the arena
+//   once a compilation is finished.  node_count() is the number of
+//   nodes other than lists allocated so far, which is at least the
+//   number of nodes in the AST.
+//
+/////////////////////////////////////////////////////////////////////
+class AstArena {
+private:
+    struct Chunk {
+	Chunk *next;
+	size_t size;            // usable bytes following the header
+    };
+    Chunk *chunks;              // most recently allocated chunk first
+    char *cur;                  // next free byte in the current chunk
+    char *end;                  // end of the current chunk
+    size_t used;                // bytes handed out
+    size_t reserved;            // bytes obtained from the heap
+    size_t nodes;               // nodes other than lists handed out
+public:
+    AstArena() : chunks(NULL), cur(NULL), end(NULL), used(0), reserved(0),
+		 nodes(0) { }
+    ~AstArena() { release(); }
+
+    void *alloc(size_t size);
+    // alloc, for a node that is not a list
+    void *alloc_node(size_t size) { nodes++; return alloc(size); }
+    void release();
+    // take over every node of other, which is left empty
+    void adopt(AstArena &other);
+
+    size_t bytes_used() const     { return used; }
+    size_t bytes_reserved() const { return reserved; }
+    size_t node_count() const     { return nodes; }
+};
+
+extern thread_local AstArena ast_arena;
+
+class AstDumpWriter;
+
 class tree_node {
 protected:
-    int line_number;            // stash the line number when node is made
+    SourceLoc loc;              // stash the location when node is made
+    unsigned char kind;         // a NodeKind, set by the constructor
 public:
+    // nodes live in ast_arena; delete is a no-op
+    static void *operator new(size_t size)
+    {
+	return ast_arena.alloc_node(size);
+    }
+    static void operator delete(void *) { }
+
     tree_node();
+    // the constructor of each AST class names its kind here, where -X
+    // counts it; operator new does not know the kind yet
+    void set_kind(NodeKind k) { kind = k; stats_node(k); }
     virtual tree_node *copy() = 0;
     virtual ~tree_node() { }
     virtual void dump(ostream& stream, int n) = 0;
-    int get_line_number();
+    // pretty printer with type information, in dumptype.cc
+    void dump_with_types(AstDumpWriter& stream, int n);
+    NodeKind get_kind()      { return (NodeKind) kind; }
+    SourceLoc get_location() { return loc; }
+    int get_line_number()    { return source_manager.line(loc); }
     tree_node *set(tree_node *);
 };
 
@@ -91,13 +167,26 @@ public:
 //
 //      
 //     int len()
-//     returns the length of the list
+//     returns the length of the list.  The length is computed when the
+//     node is built, so this is constant time.
 //
 //     nth_length(int n, int &len);
 //     Returns the nth element of the list or NULL if there are not n elements.
 //     "len" is set to the length of the list.  This method is used internally
 //     by the APS package to efficiently traverse the list representation.  
 //
+//     iterator begin();
+//     iterator end();
+//     STL-style iterators over the elements, so a list can be walked with
+//
+//     for (Elem e : *l)
+//         ... operate on e ...
+//
+//     An append_node keeps its two sublists, but the first call to nth(),
+//     begin() or nth_length() on it copies its elements, in order, into a
+//     flat array that later calls index directly.  nth() is therefore
+//     constant time after the first access.
+//
 //     static list_node<Elem> *nil();
 //     static list_node<Elem> *single(Elem);
 //     static list_node<Elem> *append(list_node<Elem> *, list_node<Elem> *);
@@ -113,7 +202,19 @@ public:
 //////////////////////////////////////////////////////////////////////////////
 
 template <class Elem> class list_node : public tree_node {
+protected:
+    int length;                  // number of elements, fixed at construction
 public:
+    typedef Elem *iterator;
+
+    list_node(int l) : length(l) { }
+    // not counted by ast_arena.node_count()
+    static void *operator new(size_t size)
+    {
+	stats_node(NODE_LIST);
+	return ast_arena.alloc(size);
+    }
+    static void operator delete(void *) { }
     tree_node *copy()            { return copy_list(); }
     Elem nth(int n);
     //
@@ -121,13 +222,23 @@ public:
     //
     int first()      { return 0; }
     int next(int n)  { return n + 1; }
-    int more(int n)  { return (n < len()); }
+    int more(int n)  { return (n < length); }
+    int len()        { return length; }
+
+    iterator begin() { return elems(); }
+    iterator end()   { return elems() + length; }
 
     virtual list_node<Elem> *copy_list() = 0;
     virtual ~list_node() { }
-    virtual int len() = 0;
     virtual Elem nth_length(int n, int &len) = 0;
 
+    // the elements of the list in a contiguous array of len() entries
+    virtual Elem *elems() = 0;
+
+    // If this node is an append_node whose elements have not been
+    // flattened yet, set l1 and l2 to its sublists and return 1.
+    virtual int split(list_node<Elem> *&l1, list_node<Elem> *&l2) { return 0; }
+
     static list_node<Elem> *nil();
     static list_node<Elem> *single(Elem);
     static list_node<Elem> *append(list_node<Elem> *l1,list_node<Elem> *l2);
@@ -139,21 +250,22 @@ extern int info_size;
 
 template <class Elem> class nil_node : public list_node<Elem> {
 public:
+    nil_node() : list_node<Elem>(0) { }
     list_node<Elem> *copy_list();
-    int len();
     Elem nth_length(int n, int &len);
+    Elem *elems() { return NULL; }
     void dump(ostream& stream, int n);
 };
 
 template <class Elem> class single_list_node : public list_node<Elem> {
     Elem elem;
 public:
-    single_list_node(Elem t) {
+    single_list_node(Elem t) : list_node<Elem>(1) {
 	elem = t;
     }
     list_node<Elem> *copy_list();
-    int len();
     Elem nth_length(int n, int &len);
+    Elem *elems() { return &elem; }
     void dump(ostream& stream, int n);
 };
 
@@ -161,15 +273,20 @@ public:
 template <class Elem> class append_node : public list_node<Elem> {
 private:
     list_node<Elem> *some, *rest;
+    Elem *flat;                  // flattened elements in ast_arena; NULL until needed
+    void flatten();
 public:
-    append_node(list_node<Elem> *l1, list_node<Elem> *l2) {
+    append_node(list_node<Elem> *l1, list_node<Elem> *l2)
+	: list_node<Elem>(l1->len() + l2->len()) {
 	some = l1;
 	rest = l2;
+	flat = NULL;
     }
     list_node<Elem> *copy_list();
-    int len();
     Elem nth(int n);
     Elem nth_length(int n, int &len);
+    Elem *elems() { if (!flat) flatten(); return flat; }
+    int split(list_node<Elem> *&l1, list_node<Elem> *&l2);
     void dump(ostream& stream, int n);
 };
 
@@ -194,31 +311,25 @@ template <class Elem> list_node<Elem> *list_node<Elem>::append(list_node<Elem> *
 //
 ///////////////////////////////////////////////////////////////////////////
 
+// report an element that is not in its list, and exit; the FlatView of
+// astview.h reports its lists' the same way
+void list_range_error() __attribute__((noreturn));
+
 template <class Elem> Elem list_node<Elem>::nth(int n)
 {
-    int len;
-    Elem tmp = nth_length(n ,len);
-
-    if (tmp)
-	return tmp;
-    else {
-	cerr << "error: outside the range of the list\n";
-	exit(1);
-    }
+    if (n >= 0 && n < length)
+	return elems()[n];
+    else
+	list_range_error();
 }
 
 // added 10/30/06 cgs
 template <class Elem> Elem append_node<Elem>::nth(int n)
 {
-    int len;
-    Elem tmp = nth_length(n ,len);
-
-    if (tmp)
-	return tmp;
-    else {
-	cerr << "error: outside the range of the list\n";
-	exit(1);
-    }
+    if (n >= 0 && n < this->length)
+	return elems()[n];
+    else
+	list_range_error();
 }
 
 ///////////////////////////////////////////////////////////////////////////
@@ -234,20 +345,6 @@ template <class Elem> list_node<Elem> *nil_node<Elem>::copy_list()
 }
 
 
-///////////////////////////////////////////////////////////////////////////
-//
-// nil_node::len
-//
-// return the length of the nil_node
-//
-///////////////////////////////////////////////////////////////////////////
-template <class Elem> int nil_node<Elem>::len()
-{
-    return 0;
-}
-
-
-
 ///////////////////////////////////////////////////////////////////////////
 //
 // nil_node::nth_length
@@ -288,19 +385,6 @@ template <class Elem> list_node<Elem> *single_list_node<Elem>::copy_list()
 }
 
 
-///////////////////////////////////////////////////////////////////////////
-//
-// single_list_node::len
-//
-// return the length of the single_list_node
-//
-///////////////////////////////////////////////////////////////////////////
-template <class Elem> int single_list_node<Elem>::len()
-{
-    return 1;
-}
-
-
 ///////////////////////////////////////////////////////////////////////////
 //
 // single_list_node::nth_length
@@ -346,14 +430,51 @@ template <class Elem> list_node<Elem> *append_node<Elem>::copy_list()
 
 ///////////////////////////////////////////////////////////////////////////
 //
-// append_node::len
+// append_node::flatten
 //
-// return the length of the append_node
+// copy the elements of both sublists, in order, into the flat array.
+// Parsers build long lists as deeply left-nested appends, so the tree
+// is walked with an explicit stack rather than by recursion.  Sublists
+// that are already flat are copied directly.
 //
 ///////////////////////////////////////////////////////////////////////////
-template <class Elem> int append_node<Elem>::len()
+template <class Elem> void append_node<Elem>::flatten()
 {
-    return some->len() + rest->len();
+    Elem *out = (Elem *) ast_arena.alloc(this->length * sizeof(Elem));
+    int pos = 0;
+    std::vector<list_node<Elem> *> stack;
+
+    stack.push_back(rest);
+    stack.push_back(some);
+    while (!stack.empty()) {
+	list_node<Elem> *l = stack.back();
+	list_node<Elem> *l1, *l2;
+	stack.pop_back();
+	if (l->split(l1, l2)) {
+	    stack.push_back(l2);
+	    stack.push_back(l1);
+	} else {
+	    Elem *e = l->elems();
+	    for (int i = 0; i < l->len(); i++)
+		out[pos++] = e[i];
+	}
+    }
+    flat = out;
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+//
+// append_node::split
+//
+///////////////////////////////////////////////////////////////////////////
+template <class Elem> int append_node<Elem>::split(list_node<Elem> *&l1, list_node<Elem> *&l2)
+{
+    if (flat)
+	return 0;
+    l1 = some;
+    l2 = rest;
+    return 1;
 }
 
 
@@ -366,14 +487,10 @@ template <class Elem> int append_node<Elem>::len()
 ///////////////////////////////////////////////////////////////////////////
 template <class Elem> Elem append_node<Elem>::nth_length(int n, int &len)
 {
-    int rlen;
-    Elem tmp = some->nth_length(n, len);
-
-    if (!tmp) {
-	tmp = rest->nth_length(n-len, rlen);
-	len += rlen;
-    }
-    return tmp;
+    len = this->length;
+    if (n >= 0 && n < this->length)
+	return elems()[n];
+    return NULL;
 }
 
 
@@ -388,7 +505,7 @@ template <class Elem> void append_node<Elem>::dump(ostream& stream, int n)
 {
     int i, size;
 
-    size = len();
+    size = this->len();
     stream << pad(n) << "list\n";
     for (i = 0; i < size; i++)
       nth(i)->dump(stream, n+2);
@@ -31,6 +31,8 @@
 // in fact only 79 spaces were there; I've made it 80 now
 //                                1         2         3         4         5         6         7
 //                      01234567890123456789012345678901234567890123456789012345678901234567890123456789
+thread_local ostream *diag_stream = &cerr;
+
 static char *padding = "                                                                                ";      // 80 spaces for padding
 
 void fatal_error(char *msg)
@@ -127,55 +129,61 @@ char *seal_token_to_string(int tok)
   }
 }
 
-void print_seal_token(int tok)
+// print a token with value, the one that came with it
+void print_seal_token(int tok, const YYSTYPE *value)
 {
 
-  cerr << seal_token_to_string(tok);
+  *diag_stream << seal_token_to_string(tok);
 
   switch (tok) {
   case (CONST_STRING):
-    cerr << " = ";
-    cerr << " \"";
-    print_escaped_string(cerr, seal_yylval.symbol->get_string());
-    cerr << "\"";
+    *diag_stream << " = ";
+    *diag_stream << " \"";
+    print_escaped_string(*diag_stream, value->symbol->get_string());
+    *diag_stream << "\"";
 #ifdef CHECK_TABLES
-    stringtable.lookup_string(seal_yylval.symbol->get_string());
+    stringtable.lookup_string(value->symbol->get_string());
 #endif
     break;
   case (CONST_INT):
-    cerr << " = " << seal_yylval.symbol;
+    *diag_stream << " = " << value->symbol;
 #ifdef CHECK_TABLES
-    inttable.lookup_string(seal_yylval.symbol->get_string());
+    inttable.lookup_string(value->symbol->get_string());
 #endif
     break;
   case (CONST_FLOAT):
-    cerr << " = " << seal_yylval.symbol;
+    *diag_stream << " = " << value->symbol;
 #ifdef CHECK_TABLES
-    floattable.lookup_string(seal_yylval.symbol->get_string());
+    floatspellings.lookup_string(value->symbol->get_string());
 #endif
     break;
   case (CONST_BOOL):
-    cerr << (seal_yylval.boolean ? " = true" : " = false");
+    *diag_stream << (value->boolean ? " = true" : " = false");
     break;
   case (OBJECTID):
-    cerr << " = " << seal_yylval.symbol;
+    *diag_stream << " = " << value->symbol;
 #ifdef CHECK_TABLES
-    idtable.lookup_string(seal_yylval.symbol->get_string());
+    idtable.lookup_string(value->symbol->get_string());
 #endif
     break;
   case (TYPEID):
-    cerr << " = " << seal_yylval.symbol;
+    *diag_stream << " = " << value->symbol;
 #ifdef CHECK_TABLES
-    idtable.lookup_string(seal_yylval.symbol->get_string());
+    idtable.lookup_string(value->symbol->get_string());
 #endif
     break;
   case (ERROR): 
-    cerr << " = ";
-    print_escaped_string(cerr, seal_yylval.error_msg);
+    *diag_stream << " = ";
+    print_escaped_string(*diag_stream, value->error_msg);
     break;
   }
 }
 
+void print_seal_token(int tok)
+{
+  print_seal_token(tok, &seal_yylval);
+}
+
 // dump the token in format readable by the sceond phase token lexer
 void dump_seal_token(ostream& out, int lineno, int token, YYSTYPE yylval)
 {
@@ -199,7 +207,7 @@ void dump_seal_token(ostream& out, int lineno, int token, YYSTYPE yylval)
     case (CONST_FLOAT):
 	out << " " << seal_yylval.symbol;
 #ifdef CHECK_TABLES
-	floattable.lookup_string(seal_yylval.symbol->get_string());
+	floatspellings.lookup_string(seal_yylval.symbol->get_string());
 #endif
 	break;
     case (CONST_BOOL):
@@ -12,9 +12,13 @@
 
 extern char *seal_token_to_string(int tok);
 extern void print_seal_token(int tok);
+extern void print_seal_token(int tok, const union YYSTYPE *value);
 extern void fatal_error(char *);
 extern void print_escaped_string(ostream& str, const char *s);
 extern char *pad(int);
+
+// where the current thread's compiler diagnostics go; cerr by default
+extern thread_local ostream *diag_stream;
 /*  On some machines strdup is not in the standard library. */
 //char *strdup(const char *s);
 
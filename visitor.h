@@ -0,0 +1,206 @@
+//
+// See copyright.h for copyright notice and limitation of liability
+// and disclaimer of warranty provisions.
+//
+#include "copyright.h"
+
+#ifndef _VISITOR_H_
+#define _VISITOR_H_
+
+///////////////////////////////////////////////////////////////////////////
+//
+// file: visitor.h
+//
+// AstVisitor is the base of a pass over the AST, seen through a View
+// of astview.h: TreeView for the pointer AST, FlatView for its flat
+// copy.  A pass is a class Pass derived from AstVisitor<Pass, View>,
+// with a handler for each kind of node it has something to do for:
+// visit_add(e, ...) for an Add, visit_if(s, ...) for an If, and so on,
+// each given the view's handle of the node (an Add_class * or a
+// FlatRef<NODE_ADD>).  A pass written as a template over View, with
+// handlers that reach the parts of a node through view, runs over
+// either form.  visit(t, ...) switches on the kind of node t and calls
+// the handler of the pass for it, passing on the rest of its
+// arguments.  The handler is found at compile time, through the Pass
+// template argument rather than a vtable, so it can be inlined into
+// visit.  A new pass is a new class; the node classes do not change.
+//
+// A pass with no handler of its own for a kind gets the one of the
+// group the kind is in, and so on outwards:
+//
+//   visit_add ... visit_bitor             visit_binary  visit_expr
+//   visit_neg, visit_not, visit_bitnot    visit_unary   visit_expr
+//   visit_call, visit_actual,             visit_expr    visit_node
+//   visit_assign, visit_const_int ...
+//   visit_object, visit_no_expr
+//   visit_stmt_block ... visit_break      visit_stmt    visit_node
+//   visit_program, visit_variable_decl,   visit_node
+//   visit_variable, visit_call_decl
+//
+// The handlers of a group are templates over the handle, so a pass
+// can write its own that way; HandleClass (astview.h) gives the class
+// of the node a handle stands for.  Handlers return a Node of the
+// view, the next one to visit for the passes of this compiler;
+// visit_node does nothing and returns View::none.
+//
+///////////////////////////////////////////////////////////////////////////
+
+#include "astview.h"
+
+template <class Pass, class View>
+class AstVisitor {
+public:
+    typedef typename View::Node Node;
+protected:
+    View view;
+    Pass& pass() { return *static_cast<Pass *>(this); }
+public:
+    AstVisitor(View v) : view(v) { }
+
+    // Inlined where it is called, so that each call site has a jump
+    // table, and a branch history, of its own, as each call site of a
+    // virtual function has.
+    template <class... Args>
+    __attribute__((always_inline)) Node visit(Node t, Args&&... args)
+    {
+	Pass& p = pass();
+	switch (view.kind(t)) {
+	case NODE_PROGRAM:       return p.visit_program(view.template as<NODE_PROGRAM>(t), args...);
+	case NODE_VARIABLE_DECL: return p.visit_variable_decl(view.template as<NODE_VARIABLE_DECL>(t), args...);
+	case NODE_VARIABLE:      return p.visit_variable(view.template as<NODE_VARIABLE>(t), args...);
+	case NODE_CALL_DECL:     return p.visit_call_decl(view.template as<NODE_CALL_DECL>(t), args...);
+	case NODE_STMT_BLOCK:    return p.visit_stmt_block(view.template as<NODE_STMT_BLOCK>(t), args...);
+	case NODE_IF:            return p.visit_if(view.template as<NODE_IF>(t), args...);
+	case NODE_WHILE:         return p.visit_while(view.template as<NODE_WHILE>(t), args...);
+	case NODE_FOR:           return p.visit_for(view.template as<NODE_FOR>(t), args...);
+	case NODE_RETURN:        return p.visit_return(view.template as<NODE_RETURN>(t), args...);
+	case NODE_CONTINUE:      return p.visit_continue(view.template as<NODE_CONTINUE>(t), args...);
+	case NODE_BREAK:         return p.visit_break(view.template as<NODE_BREAK>(t), args...);
+	case NODE_CALL:          return p.visit_call(view.template as<NODE_CALL>(t), args...);
+	case NODE_ACTUAL:        return p.visit_actual(view.template as<NODE_ACTUAL>(t), args...);
+	case NODE_ASSIGN:        return p.visit_assign(view.template as<NODE_ASSIGN>(t), args...);
+	case NODE_ADD:           return p.visit_add(view.template as<NODE_ADD>(t), args...);
+	case NODE_MINUS:         return p.visit_minus(view.template as<NODE_MINUS>(t), args...);
+	case NODE_MULTI:         return p.visit_multi(view.template as<NODE_MULTI>(t), args...);
+	case NODE_DIVIDE:        return p.visit_divide(view.template as<NODE_DIVIDE>(t), args...);
+	case NODE_MOD:           return p.visit_mod(view.template as<NODE_MOD>(t), args...);
+	case NODE_NEG:           return p.visit_neg(view.template as<NODE_NEG>(t), args...);
+	case NODE_LT:            return p.visit_lt(view.template as<NODE_LT>(t), args...);
+	case NODE_LE:            return p.visit_le(view.template as<NODE_LE>(t), args...);
+	case NODE_EQU:           return p.visit_equ(view.template as<NODE_EQU>(t), args...);
+	case NODE_NEQ:           return p.visit_neq(view.template as<NODE_NEQ>(t), args...);
+	case NODE_GE:            return p.visit_ge(view.template as<NODE_GE>(t), args...);
+	case NODE_GT:            return p.visit_gt(view.template as<NODE_GT>(t), args...);
+	case NODE_AND:           return p.visit_and(view.template as<NODE_AND>(t), args...);
+	case NODE_OR:            return p.visit_or(view.template as<NODE_OR>(t), args...);
+	case NODE_XOR:           return p.visit_xor(view.template as<NODE_XOR>(t), args...);
+	case NODE_NOT:           return p.visit_not(view.template as<NODE_NOT>(t), args...);
+	case NODE_BITAND:        return p.visit_bitand(view.template as<NODE_BITAND>(t), args...);
+	case NODE_BITOR:         return p.visit_bitor(view.template as<NODE_BITOR>(t), args...);
+	case NODE_BITNOT:        return p.visit_bitnot(view.template as<NODE_BITNOT>(t), args...);
+	case NODE_CONST_INT:     return p.visit_const_int(view.template as<NODE_CONST_INT>(t), args...);
+	case NODE_CONST_STRING:  return p.visit_const_string(view.template as<NODE_CONST_STRING>(t), args...);
+	case NODE_CONST_FLOAT:   return p.visit_const_float(view.template as<NODE_CONST_FLOAT>(t), args...);
+	case NODE_CONST_BOOL:    return p.visit_const_bool(view.template as<NODE_CONST_BOOL>(t), args...);
+	case NODE_OBJECT:        return p.visit_object(view.template as<NODE_OBJECT>(t), args...);
+	case NODE_NO_EXPR:       return p.visit_no_expr(view.template as<NODE_NO_EXPR>(t), args...);
+	default:                 return p.visit_node(t, args...);
+	}
+    }
+
+    //
+    // The handlers a pass gets when it has none of its own.
+    //
+    template <class H, class... Args> Node visit_node(H t, Args&&... args)
+	{ return View::none; }
+
+    template <class H, class... Args> Node visit_stmt(H s, Args&&... args)
+	{ return pass().visit_node(s, args...); }
+    template <class H, class... Args> Node visit_expr(H e, Args&&... args)
+	{ return pass().visit_node(e, args...); }
+    template <class H, class... Args> Node visit_binary(H e, Args&&... args)
+	{ return pass().visit_expr(e, args...); }
+    template <class H, class... Args> Node visit_unary(H e, Args&&... args)
+	{ return pass().visit_expr(e, args...); }
+
+    template <class H, class... Args> Node visit_program(H t, Args&&... args)
+	{ return pass().visit_node(t, args...); }
+    template <class H, class... Args> Node visit_variable_decl(H t, Args&&... args)
+	{ return pass().visit_node(t, args...); }
+    template <class H, class... Args> Node visit_variable(H t, Args&&... args)
+	{ return pass().visit_node(t, args...); }
+    template <class H, class... Args> Node visit_call_decl(H t, Args&&... args)
+	{ return pass().visit_node(t, args...); }
+    template <class H, class... Args> Node visit_stmt_block(H t, Args&&... args)
+	{ return pass().visit_stmt(t, args...); }
+    template <class H, class... Args> Node visit_if(H t, Args&&... args)
+	{ return pass().visit_stmt(t, args...); }
+    template <class H, class... Args> Node visit_while(H t, Args&&... args)
+	{ return pass().visit_stmt(t, args...); }
+    template <class H, class... Args> Node visit_for(H t, Args&&... args)
+	{ return pass().visit_stmt(t, args...); }
+    template <class H, class... Args> Node visit_return(H t, Args&&... args)
+	{ return pass().visit_stmt(t, args...); }
+    template <class H, class... Args> Node visit_continue(H t, Args&&... args)
+	{ return pass().visit_stmt(t, args...); }
+    template <class H, class... Args> Node visit_break(H t, Args&&... args)
+	{ return pass().visit_stmt(t, args...); }
+    template <class H, class... Args> Node visit_call(H t, Args&&... args)
+	{ return pass().visit_expr(t, args...); }
+    template <class H, class... Args> Node visit_actual(H t, Args&&... args)
+	{ return pass().visit_expr(t, args...); }
+    template <class H, class... Args> Node visit_assign(H t, Args&&... args)
+	{ return pass().visit_expr(t, args...); }
+    template <class H, class... Args> Node visit_add(H t, Args&&... args)
+	{ return pass().visit_binary(t, args...); }
+    template <class H, class... Args> Node visit_minus(H t, Args&&... args)
+	{ return pass().visit_binary(t, args...); }
+    template <class H, class... Args> Node visit_multi(H t, Args&&... args)
+	{ return pass().visit_binary(t, args...); }
+    template <class H, class... Args> Node visit_divide(H t, Args&&... args)
+	{ return pass().visit_binary(t, args...); }
+    template <class H, class... Args> Node visit_mod(H t, Args&&... args)
+	{ return pass().visit_binary(t, args...); }
+    template <class H, class... Args> Node visit_neg(H t, Args&&... args)
+	{ return pass().visit_unary(t, args...); }
+    template <class H, class... Args> Node visit_lt(H t, Args&&... args)
+	{ return pass().visit_binary(t, args...); }
+    template <class H, class... Args> Node visit_le(H t, Args&&... args)
+	{ return pass().visit_binary(t, args...); }
+    template <class H, class... Args> Node visit_equ(H t, Args&&... args)
+	{ return pass().visit_binary(t, args...); }
+    template <class H, class... Args> Node visit_neq(H t, Args&&... args)
+	{ return pass().visit_binary(t, args...); }
+    template <class H, class... Args> Node visit_ge(H t, Args&&... args)
+	{ return pass().visit_binary(t, args...); }
+    template <class H, class... Args> Node visit_gt(H t, Args&&... args)
+	{ return pass().visit_binary(t, args...); }
+    template <class H, class... Args> Node visit_and(H t, Args&&... args)
+	{ return pass().visit_binary(t, args...); }
+    template <class H, class... Args> Node visit_or(H t, Args&&... args)
+	{ return pass().visit_binary(t, args...); }
+    template <class H, class... Args> Node visit_xor(H t, Args&&... args)
+	{ return pass().visit_binary(t, args...); }
+    template <class H, class... Args> Node visit_not(H t, Args&&... args)
+	{ return pass().visit_unary(t, args...); }
+    template <class H, class... Args> Node visit_bitand(H t, Args&&... args)
+	{ return pass().visit_binary(t, args...); }
+    template <class H, class... Args> Node visit_bitor(H t, Args&&... args)
+	{ return pass().visit_binary(t, args...); }
+    template <class H, class... Args> Node visit_bitnot(H t, Args&&... args)
+	{ return pass().visit_unary(t, args...); }
+    template <class H, class... Args> Node visit_const_int(H t, Args&&... args)
+	{ return pass().visit_expr(t, args...); }
+    template <class H, class... Args> Node visit_const_string(H t, Args&&... args)
+	{ return pass().visit_expr(t, args...); }
+    template <class H, class... Args> Node visit_const_float(H t, Args&&... args)
+	{ return pass().visit_expr(t, args...); }
+    template <class H, class... Args> Node visit_const_bool(H t, Args&&... args)
+	{ return pass().visit_expr(t, args...); }
+    template <class H, class... Args> Node visit_object(H t, Args&&... args)
+	{ return pass().visit_expr(t, args...); }
+    template <class H, class... Args> Node visit_no_expr(H t, Args&&... args)
+	{ return pass().visit_expr(t, args...); }
+};
+
+#endif